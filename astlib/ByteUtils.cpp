@@ -10,10 +10,25 @@
 ///
 
 #include "ByteUtils.h"
+#include "Exception.h"
+#include <Poco/ByteOrder.h>
 #include <Poco/NumberFormatter.h>
 #include <Poco/String.h>
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
+// SSE2 is x86-64 baseline, 32 bit x86 uses vector scan only when built with -msse2
+#if defined(__GNUC__) && (defined(__x86_64__) || (defined(__i386__) && defined(__SSE2__)))
+#define ASTLIB_FX_SSE2
+#define ASTLIB_FX_AVX2
+#include <immintrin.h>
+#elif defined(_M_X64)
+#define ASTLIB_FX_SSE2
+#include <emmintrin.h>
+#include <intrin.h>
+#endif
+
 namespace astlib
 {
 
@@ -34,6 +49,85 @@ void ByteUtils::pokeBigEndian(Byte buffer[], Poco::UInt64 value, size_t len)
     }
 }
 
+Poco::UInt64 ByteUtils::loadBigEndian(const Byte buffer[], size_t len)
+{
+    Poco::UInt64 value = 0;
+
+    for(size_t i = 0; i < len; i++)
+    {
+        value = (value << 8) | buffer[i];
+    }
+
+    return value;
+}
+
+// Mask with lowest width bits set, width 1..64
+static inline Poco::UInt64 lowMask(int width)
+{
+    return ~Poco::UInt64(0) >> (64 - width);
+}
+
+Poco::UInt64 ByteUtils::peekBits(const Byte buffer[], size_t length, int shift, int width)
+{
+    // Byte with the lowest field bit and bit offset inside of it
+    size_t last = length - 1 - (shift >> 3);
+    int offset = shift & 7;
+    Poco::UInt64 word;
+
+    width = std::min(width, 64);
+
+    if (last >= 7)
+    {
+        memcpy(&word, buffer + last - 7, sizeof(word));
+        word = Poco::ByteOrder::fromBigEndian(word);
+    }
+    else
+    {
+        word = loadBigEndian(buffer, last + 1);
+    }
+
+    Poco::UInt64 value = word >> offset;
+
+    // Unaligned field wider than 56 bits spans 9 bytes
+    if (offset + width > 64)
+        value |= Poco::UInt64(buffer[last - 8]) << (64 - offset);
+
+    return value & lowMask(width);
+}
+
+void ByteUtils::pokeBits(Byte buffer[], size_t length, int shift, int width, Poco::UInt64 value)
+{
+    size_t last = length - 1 - (shift >> 3);
+    int offset = shift & 7;
+
+    width = std::min(width, 64);
+
+    Poco::UInt64 mask = lowMask(width);
+    value &= mask;
+
+    if (last >= 7)
+    {
+        Poco::UInt64 word;
+        memcpy(&word, buffer + last - 7, sizeof(word));
+        word = Poco::ByteOrder::fromBigEndian(word);
+        word = (word & ~(mask << offset)) | (value << offset);
+        word = Poco::ByteOrder::toBigEndian(word);
+        memcpy(buffer + last - 7, &word, sizeof(word));
+    }
+    else
+    {
+        Poco::UInt64 word = loadBigEndian(buffer, last + 1);
+        word = (word & ~(mask << offset)) | (value << offset);
+        pokeBigEndian(buffer, word, last + 1);
+    }
+
+    if (offset + width > 64)
+    {
+        Byte high = Byte(mask >> (64 - offset));
+        buffer[last - 8] = Byte((buffer[last - 8] & ~high) | (value >> (64 - offset)));
+    }
+}
+
 size_t ByteUtils::calculateFspec(const Byte fspecPtr[])
 {
     size_t fspecLen = 1;
@@ -46,15 +140,150 @@ size_t ByteUtils::calculateFspec(const Byte fspecPtr[])
     return fspecLen;
 }
 
-Poco::Int64 ByteUtils::toSigned(Poco::UInt64 value, int effectiveBits)
+static size_t scanFxChainScalar(const Byte buffer[], size_t bytes)
+{
+    for (size_t k = 0; k < bytes; k++)
+    {
+        if ((buffer[k] & FX_BIT) == 0)
+            return k + 1;
+    }
+    return 0;
+}
+
+#ifdef ASTLIB_FX_SSE2
+static inline int trailingZeros(unsigned value)
+{
+#ifdef __GNUC__
+    return __builtin_ctz(value);
+#else
+    unsigned long index;
+    _BitScanForward(&index, value);
+    return int(index);
+#endif
+}
+
+static size_t scanFxChainSse2(const Byte buffer[], size_t bytes)
 {
-    Poco::UInt64 mask1 = (1ULL << (effectiveBits-1));
-    if (mask1 & value)
+    size_t k = 0;
+
+    for (; k + 16 <= bytes; k += 16)
     {
-        Poco::UInt64 mask2 = ~(mask1-1);
-        return static_cast<Poco::Int64>(value|mask2);
+        __m128i data = _mm_loadu_si128(reinterpret_cast<const __m128i*>(buffer + k));
+        // Move FX bit (bit 0) of every byte to its sign bit
+        unsigned stop = ~unsigned(_mm_movemask_epi8(_mm_slli_epi16(data, 7))) & 0xFFFF;
+        if (stop)
+            return k + trailingZeros(stop) + 1;
     }
-    return static_cast<Poco::Int64>(value);
+
+    size_t tail = scanFxChainScalar(buffer + k, bytes - k);
+    return tail ? k + tail : 0;
+}
+#endif
+
+#ifdef ASTLIB_FX_AVX2
+__attribute__((target("avx2")))
+static size_t scanFxChainAvx2(const Byte buffer[], size_t bytes)
+{
+    size_t k = 0;
+
+    for (; k + 32 <= bytes; k += 32)
+    {
+        __m256i data = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(buffer + k));
+        unsigned stop = ~unsigned(_mm256_movemask_epi8(_mm256_slli_epi16(data, 7)));
+        if (stop)
+            return k + trailingZeros(stop) + 1;
+    }
+
+    size_t tail = scanFxChainSse2(buffer + k, bytes - k);
+    return tail ? k + tail : 0;
+}
+#endif
+
+using FxScanner = size_t (*)(const Byte buffer[], size_t bytes);
+
+static FxScanner selectFxScanner(const char*& name)
+{
+#ifdef ASTLIB_FX_AVX2
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2"))
+    {
+        name = "avx2";
+        return scanFxChainAvx2;
+    }
+#endif
+#ifdef ASTLIB_FX_SSE2
+    name = "sse2";
+    return scanFxChainSse2;
+#else
+    name = "scalar";
+    return scanFxChainScalar;
+#endif
+}
+
+static const char* fxScannerName = "scalar";
+
+static FxScanner fxScanner()
+{
+    // Selected once, safe also for calls during static initialization
+    static const FxScanner scanner = selectFxScanner(fxScannerName);
+    return scanner;
+}
+
+size_t ByteUtils::scanFxChain(const Byte buffer[], size_t bytes)
+{
+    // Most chains end in the first byte or two, vector load doesn't pay off there
+    if (bytes && (buffer[0] & FX_BIT) == 0)
+        return 1;
+    if (bytes > 1 && (buffer[1] & FX_BIT) == 0)
+        return 2;
+
+    return fxScanner()(buffer, bytes);
+}
+
+const char* ByteUtils::getFxScannerName()
+{
+    fxScanner();
+    return fxScannerName;
+}
+
+// Index of the highest set bit counted from MSB of byte
+static inline int leadingZeros8(unsigned bits)
+{
+#ifdef __GNUC__
+    return __builtin_clz(bits) - 24;
+#else
+    int count = 0;
+    for (unsigned mask = 0x80; (bits & mask) == 0; mask >>= 1)
+        count++;
+    return count;
+#endif
+}
+
+size_t ByteUtils::expandFspec(const Byte fspec[], size_t fspecLen, int frns[])
+{
+    size_t count = 0;
+
+    for (size_t i = 0; i < fspecLen; i++)
+    {
+        unsigned bits = fspec[i] & ~unsigned(FX_BIT);
+        int base = int(i * 8);
+
+        while (bits)
+        {
+            int bit = leadingZeros8(bits);
+            frns[count++] = base + bit;
+            bits &= ~(0x80u >> bit);
+        }
+    }
+
+    return count;
+}
+
+Poco::Int64 ByteUtils::toSigned(Poco::UInt64 value, int effectiveBits)
+{
+    // Branchless: move sign bit to bit 63 and let arithmetic shift replicate it
+    int unused = 64 - effectiveBits;
+    return static_cast<Poco::Int64>(value << unused) >> unused;
 }
 
 Poco::UInt64 ByteUtils::oct2dec(Poco::UInt32 modeValue)
@@ -165,6 +394,52 @@ std::string ByteUtils::toSixBitString(const std::string sixbit)
     return std::string(aux, 6);
 }
 
+Poco::UInt64 ByteUtils::packSixBitString(const std::string& sixbit)
+{
+    Poco::UInt64 value = 0;
+    size_t size = sixbit.size();
+
+    for (size_t i = 0; i < 8; i++)
+    {
+        value <<= 6;
+        value |= (i < size) ? charToIa5(sixbit[i]) : 32;
+    }
+
+    return value;
+}
+
+Poco::UInt64 ByteUtils::parseHex(const std::string& hex)
+{
+    const char* ptr = hex.data();
+    const char* end = ptr + hex.size();
+    Poco::UInt64 value = 0;
+
+    if (hex.size() > 2 && ptr[0] == '0' && (ptr[1] == 'x' || ptr[1] == 'X'))
+        ptr += 2;
+
+    if (ptr == end || (end - ptr) > 16)
+        throw Exception("ByteUtils::parseHex(): bad hex string '" + hex + "'");
+
+    for (; ptr < end; ptr++)
+    {
+        char c = *ptr;
+        int digit;
+
+        if (c >= '0' && c <= '9')
+            digit = c - '0';
+        else if (c >= 'A' && c <= 'F')
+            digit = c - 'A' + 10;
+        else if (c >= 'a' && c <= 'f')
+            digit = c - 'a' + 10;
+        else
+            throw Exception("ByteUtils::parseHex(): bad hex string '" + hex + "'");
+
+        value = (value << 4) | Poco::UInt64(digit);
+    }
+
+    return value;
+}
+
 void ByteUtils::printHex(const std::vector<Byte>& buffer)
 {
     for(Byte byte: buffer)
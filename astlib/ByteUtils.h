@@ -31,6 +31,27 @@ public:
 
     static size_t calculateFspec(const Byte fspecPtr[]);
 
+    /**
+     * Finds end of FX extended chain (FSPEC, compound FSPEC, Variable item with one byte extents).
+     * Uses SSE2/AVX2 scanner selected at runtime when available.
+     * @param bytes number of readable bytes
+     * @return chain length including the last byte without FX bit, 0 when chain isn't terminated within bytes
+     */
+    static size_t scanFxChain(const Byte buffer[], size_t bytes);
+
+    /**
+     * Expands FSPEC bits to ascending list of present FRNs (FSPEC bit indexes, byte*8 + bit from MSB).
+     * FX bits are not listed.
+     * @param frns output array, at least 7*fspecLen entries
+     * @return number of present FRNs
+     */
+    static size_t expandFspec(const Byte fspec[], size_t fspecLen, int frns[]);
+
+    /**
+     * @return name of FX chain scanner used on this CPU ("avx2", "sse2" or "scalar")
+     */
+    static const char* getFxScannerName();
+
     static Poco::Int64 toSigned(Poco::UInt64, int effectiveBits);
 
     static Poco::UInt64 oct2dec(Poco::UInt32 modeValue);
@@ -41,8 +62,37 @@ public:
 
     static std::string toSixBitString(const std::string sixbit);
 
+    /**
+     * Packs up to 8 characters to 48 bit IA-5 representation without temporary strings.
+     * @return packed characters, first character in the highest bits
+     */
+    static Poco::UInt64 packSixBitString(const std::string& sixbit);
+
+    /**
+     * Parses hexadecimal string (optionally prefixed with 0x), throws Exception on bad input.
+     */
+    static Poco::UInt64 parseHex(const std::string& hex);
+
     static void pokeBigEndian(Byte buffer[], Poco::UInt64 value, size_t len);
 
+    /**
+     * Loads up to 8 bytes as big endian number.
+     */
+    static Poco::UInt64 loadBigEndian(const Byte buffer[], size_t len);
+
+    /**
+     * Reads bit field from big endian buffer with length bytes (any length).
+     * Field is fetched with one unaligned 64 bit load whenever at least 8 bytes precede its end.
+     * @param shift position of the lowest field bit counted from LSB of the last byte
+     * @param width field width in bits, wider fields are truncated to the lowest 64 bits
+     */
+    static Poco::UInt64 peekBits(const Byte buffer[], size_t length, int shift, int width);
+
+    /**
+     * Overwrites bit field in big endian buffer with length bytes, other bits are preserved.
+     */
+    static void pokeBits(Byte buffer[], size_t length, int shift, int width, Poco::UInt64 value);
+
     static void printHex(const std::vector<Byte>& buffer);
 };
 
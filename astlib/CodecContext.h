@@ -26,14 +26,16 @@ public:
         uapItem(uapItem),
         policy(policy),
         bits(bits),
+        plan(bits.plan.compiled ? bits.plan : BitsPlan(bits)),
         depth(depth),
-        width(bits.effectiveBitsWidth())
+        width(plan.width)
     {
     }
 
     const ItemDescription& uapItem;
     const CodecPolicy& policy;
     const BitsDescription& bits;
+    const BitsPlan plan;
     int depth = 0;
     int width = 1;
 };
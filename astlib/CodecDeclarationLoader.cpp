@@ -379,6 +379,7 @@ BitsDescriptionArray CodecDeclarationLoader::loadBitsDeclaration(CodecDescriptio
             }
 
             bits.repeat = repetitive;
+            bits.compile();
 
             //std::cout << "      " << bits.toString() << " enc " << bits.encoding.toString() << std::endl;
             addPrimitiveItem(codecDescription, bits);
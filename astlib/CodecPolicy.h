@@ -27,10 +27,19 @@ struct ASTLIB_API CodecPolicy
         Error     ///< throw exception
     };
 
+    /// What decoder delivers from corrupted data block
+    enum Recovery {
+        SkipRecord,   ///< records before the bad one are delivered, the bad one and the rest of block are dropped
+        SkipBlock     ///< block is validated first and dropped completely when it is corrupted,
+                      ///< the structure only pass walks whole block once more, so healthy traffic
+                      ///< costs up to 2x of SkipRecord (see cpuBoundDecodeCat48SkipBlock test)
+    };
+
     CodecPolicy() {}
     CodecPolicy(Code mandatoryItems, bool verbose);
 
     Code mandatoryItems = Error; ///< what to do when mandatory item is not present
+    Recovery recovery = SkipRecord;
     bool normalizeValues = true;
     bool verbose = false;
 };
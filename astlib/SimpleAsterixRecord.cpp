@@ -11,11 +11,15 @@
 
 #include "SimpleAsterixRecord.h"
 
-#include <Poco/Dynamic/Struct.h>
-
 #include "AsterixItemDictionary.h"
 #include "Exception.h"
+#include "io/CborReader.h"
+#include "io/CborWriter.h"
+#include "io/JsonWriter.h"
 
+#include <cstdlib>
+#include <cstring>
+#include <typeinfo>
 #include <sstream>
 #include <iostream>
 
@@ -186,44 +190,608 @@ std::string SimpleAsterixRecord::toString() const
     return stream.str();
 }
 
+namespace
+{
+
+/// Item names with quotes and colon, indexed by item code
+const std::vector<std::string>& quotedSymbols()
+{
+    static const std::vector<std::string> table = []()
+    {
+        std::vector<std::string> result(ASTERIX_ITEM_COUNT + 1);
+        for(const auto& entry: asterixSymbols())
+        {
+            size_t index = entry.second.code();
+            if (index >= result.size())
+                result.resize(index + 1);
+            std::string& quoted = result[index];
+            quoted = '"';
+            JsonWriter::appendEscaped(quoted, entry.first.data(), entry.first.size());
+            quoted += "\":";
+        }
+        return result;
+    }();
+    return table;
+}
+
+/// Formats by held type, so the text matches Poco::Dynamic::Var::toString()
+void appendValue(std::string& output, const Poco::Dynamic::Var& value)
+{
+    if (value.isEmpty())
+    {
+        output += "null";
+        return;
+    }
+
+    const std::type_info& type = value.type();
+    if (type == typeid(std::string))
+    {
+        const std::string& text = value.extract<std::string>();
+        output += '"';
+        JsonWriter::appendEscaped(output, text.data(), text.size());
+        output += '"';
+    }
+    else if (type == typeid(bool))
+    {
+        output += value.extract<bool>() ? "true" : "false";
+    }
+    else if (type == typeid(double))
+    {
+        JsonWriter::appendNumber(output, value.extract<double>());
+    }
+    else if (type == typeid(Poco::UInt64) || type == typeid(Poco::UInt32) || type == typeid(Poco::UInt16) || type == typeid(Poco::UInt8))
+    {
+        JsonWriter::appendNumber(output, value.convert<Poco::UInt64>());
+    }
+    else if (value.isInteger())
+    {
+        JsonWriter::appendNumber(output, value.convert<Poco::Int64>());
+    }
+    else
+    {
+        output += Poco::Dynamic::Var::toString(value);
+    }
+}
+
+/**
+ * Single pass parser of flat record object, numbers are parsed in place.
+ */
+class RecordParser
+{
+public:
+    RecordParser(const char* json, size_t size) :
+        _begin(json),
+        _ptr(json),
+        _end(json + size)
+    {
+    }
+
+    void parse(std::map<AsterixItemCode, Poco::Dynamic::Var>& items)
+    {
+        const auto& symbols = asterixSymbols();
+
+        expect('{');
+        if (peek() == '}')
+        {
+            _ptr++;
+            finish();
+            return;
+        }
+
+        for(;;)
+        {
+            parseString(_key);
+            expect(':');
+
+            auto iterator = symbols.find(_key);
+            if (iterator == symbols.end())
+            {
+                skipValue();
+            }
+            else
+            {
+                AsterixItemCode code = iterator->second;
+                if (peek() == '[')
+                    items[code] = parseArray(code.type());
+                else
+                    items[code] = parseScalar(code.type());
+            }
+
+            char c = next();
+            if (c == '}')
+                break;
+            if (c != ',')
+                fail("expected ',' or '}'");
+        }
+        finish();
+    }
+
+private:
+    Poco::Dynamic::Var parseArray(int type)
+    {
+        std::vector<Poco::Dynamic::Var> array;
+        expect('[');
+        if (peek() == ']')
+        {
+            _ptr++;
+            return Poco::Dynamic::Var(array);
+        }
+        for(;;)
+        {
+            array.push_back(parseScalar(type));
+            char c = next();
+            if (c == ']')
+                break;
+            if (c != ',')
+                fail("expected ',' or ']'");
+        }
+        return Poco::Dynamic::Var(array);
+    }
+
+    Poco::Dynamic::Var parseScalar(int type)
+    {
+        char c = peek();
+        switch(c)
+        {
+        case '"':
+        {
+            std::string text;
+            parseString(text);
+            return Poco::Dynamic::Var(text);
+        }
+        case 't':
+            literal("true");
+            return Poco::Dynamic::Var(true);
+        case 'f':
+            literal("false");
+            return Poco::Dynamic::Var(false);
+        case 'n':
+            literal("null");
+            return Poco::Dynamic::Var();
+        default:
+            return parseNumber(type);
+        }
+    }
+
+    Poco::Dynamic::Var parseNumber(int type)
+    {
+        const char* start = _ptr;
+        bool negative = false;
+        bool integral = true;
+
+        if (_ptr < _end && *_ptr == '-')
+        {
+            negative = true;
+            _ptr++;
+        }
+
+        // Integers are accumulated directly, overflow falls back to double
+        Poco::UInt64 magnitude = 0;
+        const char* digits = _ptr;
+        while (_ptr < _end && *_ptr >= '0' && *_ptr <= '9')
+        {
+            unsigned digit = unsigned(*_ptr - '0');
+            if (magnitude > (~Poco::UInt64(0) - digit) / 10)
+                integral = false;
+            magnitude = magnitude * 10 + digit;
+            _ptr++;
+        }
+        if (_ptr == digits)
+            fail("expected value");
+
+        while (_ptr < _end && (*_ptr == '.' || *_ptr == 'e' || *_ptr == 'E' || *_ptr == '+' || *_ptr == '-' || (*_ptr >= '0' && *_ptr <= '9')))
+        {
+            integral = false;
+            _ptr++;
+        }
+
+        if (integral && type != PrimitiveType::Real)
+        {
+            if (!negative && type != PrimitiveType::Integer)
+                return Poco::Dynamic::Var(magnitude);
+            // Magnitude of INT64_MIN is one more than INT64_MAX
+            if (magnitude <= (Poco::UInt64(1) << 63) - (negative ? 0 : 1))
+                return Poco::Dynamic::Var(Poco::Int64(negative ? 0 - magnitude : magnitude));
+        }
+
+        // Token is copied, input needs no terminating zero
+        char token[64];
+        size_t length = size_t(_ptr - start);
+        if (length >= sizeof(token))
+            fail("number too long");
+        std::memcpy(token, start, length);
+        token[length] = 0;
+
+        char* end = nullptr;
+        double value = std::strtod(token, &end);
+        if (end != token + length)
+            fail("malformed number");
+        return Poco::Dynamic::Var(value);
+    }
+
+    void parseString(std::string& text)
+    {
+        expect('"');
+        text.clear();
+        const char* run = _ptr;
+
+        while (_ptr < _end && *_ptr != '"')
+        {
+            if (*_ptr != '\\')
+            {
+                _ptr++;
+                continue;
+            }
+
+            text.append(run, _ptr - run);
+            if (++_ptr == _end)
+                break;
+            char c = *_ptr++;
+            switch(c)
+            {
+            case 'n': text += '\n'; break;
+            case 'r': text += '\r'; break;
+            case 't': text += '\t'; break;
+            case 'b': text += '\b'; break;
+            case 'f': text += '\f'; break;
+            case 'u': appendCodePoint(text, parseHex()); break;
+            default: text += c;
+            }
+            run = _ptr;
+        }
+        if (_ptr == _end)
+            fail("unterminated string");
+
+        text.append(run, _ptr - run);
+        _ptr++;
+    }
+
+    unsigned parseHex()
+    {
+        if (_end - _ptr < 4)
+            fail("truncated escape");
+
+        unsigned value = 0;
+        for(int i = 0; i < 4; i++, _ptr++)
+        {
+            char c = *_ptr;
+            value <<= 4;
+            if (c >= '0' && c <= '9')
+                value |= unsigned(c - '0');
+            else if (c >= 'a' && c <= 'f')
+                value |= unsigned(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F')
+                value |= unsigned(c - 'A' + 10);
+            else
+                fail("bad escape");
+        }
+        return value;
+    }
+
+    static void appendCodePoint(std::string& text, unsigned code)
+    {
+        // UTF-8, surrogate pairs are not combined
+        if (code < 0x80)
+        {
+            text += char(code);
+        }
+        else if (code < 0x800)
+        {
+            text += char(0xC0 | (code >> 6));
+            text += char(0x80 | (code & 0x3F));
+        }
+        else
+        {
+            text += char(0xE0 | (code >> 12));
+            text += char(0x80 | ((code >> 6) & 0x3F));
+            text += char(0x80 | (code & 0x3F));
+        }
+    }
+
+    void skipValue()
+    {
+        char c = peek();
+        if (c == '[' || c == '{')
+        {
+            // Nested containers of unknown items, strings may contain brackets
+            int depth = 0;
+            do
+            {
+                c = peek();
+                if (c == '"')
+                {
+                    std::string ignored;
+                    parseString(ignored);
+                    continue;
+                }
+                if (c == '[' || c == '{')
+                    depth++;
+                else if (c == ']' || c == '}')
+                    depth--;
+                _ptr++;
+            }
+            while (depth > 0);
+        }
+        else
+        {
+            parseScalar(PrimitiveType::Unknown);
+        }
+    }
+
+    void literal(const char* word)
+    {
+        size_t length = std::strlen(word);
+        if (size_t(_end - _ptr) < length || std::memcmp(_ptr, word, length) != 0)
+            fail("expected value");
+        _ptr += length;
+    }
+
+    void skipSpace()
+    {
+        while (_ptr < _end && (*_ptr == ' ' || *_ptr == '\t' || *_ptr == '\n' || *_ptr == '\r'))
+            _ptr++;
+    }
+
+    char peek()
+    {
+        skipSpace();
+        if (_ptr == _end)
+            fail("unexpected end");
+        return *_ptr;
+    }
+
+    char next()
+    {
+        char c = peek();
+        _ptr++;
+        return c;
+    }
+
+    void expect(char c)
+    {
+        if (next() != c)
+            fail(std::string("expected '") + c + "'");
+    }
+
+    void finish()
+    {
+        skipSpace();
+        if (_ptr != _end && *_ptr != 0)
+            fail("trailing characters");
+    }
+
+    [[noreturn]] void fail(const std::string& message)
+    {
+        throw Exception("SimpleAsterixRecord::fromJson(): " + message + " at offset " + std::to_string(_ptr - _begin));
+    }
+
+    const char* _begin;
+    const char* _ptr;
+    const char* _end;
+    std::string _key;
+};
+
+/// Binary counterpart of appendValue(), also formatted by held type
+void appendCbor(std::string& output, const Poco::Dynamic::Var& value)
+{
+    if (value.isEmpty())
+    {
+        CborWriter::appendNull(output);
+        return;
+    }
+
+    const std::type_info& type = value.type();
+    if (type == typeid(std::string))
+    {
+        const std::string& text = value.extract<std::string>();
+        CborWriter::appendText(output, text.data(), text.size());
+    }
+    else if (type == typeid(bool))
+    {
+        CborWriter::appendBoolean(output, value.extract<bool>());
+    }
+    else if (type == typeid(double) || type == typeid(float))
+    {
+        CborWriter::appendNumber(output, value.convert<double>());
+    }
+    else if (type == typeid(Poco::UInt64) || type == typeid(Poco::UInt32) || type == typeid(Poco::UInt16) || type == typeid(Poco::UInt8))
+    {
+        CborWriter::appendNumber(output, value.convert<Poco::UInt64>());
+    }
+    else if (value.isInteger())
+    {
+        CborWriter::appendNumber(output, value.convert<Poco::Int64>());
+    }
+    else
+    {
+        std::string text = value.convert<std::string>();
+        CborWriter::appendText(output, text.data(), text.size());
+    }
+}
+
+Poco::Dynamic::Var readCbor(CborReader& reader, int type)
+{
+    size_t size = 0;
+    switch(reader.peek())
+    {
+    case CborReader::Unsigned:
+        if (type == PrimitiveType::Real)
+            return Poco::Dynamic::Var(reader.readReal());
+        if (type == PrimitiveType::Integer)
+            return Poco::Dynamic::Var(reader.readSigned());
+        return Poco::Dynamic::Var(reader.readUnsigned());
+
+    case CborReader::Negative:
+        if (type == PrimitiveType::Real)
+            return Poco::Dynamic::Var(reader.readReal());
+        return Poco::Dynamic::Var(reader.readSigned());
+
+    case CborReader::Real:
+        return Poco::Dynamic::Var(reader.readReal());
+
+    case CborReader::Boolean:
+        return Poco::Dynamic::Var(reader.readBoolean());
+
+    case CborReader::Null:
+        reader.readNull();
+        return Poco::Dynamic::Var();
+
+    case CborReader::Text:
+    {
+        const char* text = reader.readText(size);
+        return Poco::Dynamic::Var(std::string(text, size));
+    }
+    case CborReader::Bytes:
+    {
+        const Byte* bytes = reader.readBytes(size);
+        return Poco::Dynamic::Var(std::string(reinterpret_cast<const char*>(bytes), size));
+    }
+    default:
+        throw Exception("SimpleAsterixRecord::fromCbor(): nested container at offset " + std::to_string(reader.getOffset()));
+    }
+}
+
+}
+
 std::string SimpleAsterixRecord::toJson() const
 {
-    std::stringstream stream;
+    std::string output;
+    output.reserve(_items.size() * 32);
+    toJson(output);
+    return output;
+}
+
+void SimpleAsterixRecord::toJson(std::string& output) const
+{
+    const std::vector<std::string>& symbols = quotedSymbols();
     bool first = true;
 
-    stream << '{';
+    output += '{';
     for (auto& item: _items)
     {
         AsterixItemCode code = item.first;
 
-        if (!code.isValid())
+        if (!code.isValid() || size_t(code.code()) >= symbols.size())
             continue;
 
         if (!first)
-            stream << ',';
-
-        stream << '\"' << asterixCodeToSymbol(code) << "\":" << Poco::Dynamic::Var::toString(item.second);
+            output += ',';
+        output += symbols[code.code()];
+
+        const Poco::Dynamic::Var& value = item.second;
+        if (value.isArray())
+        {
+            // Same spacing as Poco::Dynamic::Var::toString() of arrays
+            output += "[ ";
+            for(size_t i = 0; i < value.size(); i++)
+            {
+                if (i)
+                    output += ", ";
+                appendValue(output, value[i]);
+            }
+            output += " ]";
+        }
+        else
+        {
+            appendValue(output, value);
+        }
         first = false;
     }
-    stream << '}';
-    return stream.str();
+    output += '}';
 }
 
 SimpleAsterixRecordPtr SimpleAsterixRecord::fromJson(const std::string& json)
 {
-    Poco::Dynamic::Var object(Poco::Dynamic::Var::parse(json));
-    poco_assert(object.isStruct());
-    //std::cout << Poco::Dynamic::Var::toString(object) << std::endl;
+    return fromJson(json.data(), json.size());
+}
+
+SimpleAsterixRecordPtr SimpleAsterixRecord::fromJson(const char* json, size_t size)
+{
+    SimpleAsterixRecordPtr instance = std::make_shared<SimpleAsterixRecord>();
+    RecordParser parser(json, size);
+    parser.parse(instance->_items);
+    return instance;
+}
+
+void SimpleAsterixRecord::toCbor(std::string& output) const
+{
+    size_t count = 0;
+    for (auto& item: _items)
+        count += item.first.isValid();
+
+    CborWriter::appendHead(output, CborWriter::Map, count + 2);
+    CborWriter::appendNumber(output, Poco::Int64(-1));
+    CborWriter::appendNumber(output, Poco::UInt64(getCategory()));
+    CborWriter::appendNumber(output, Poco::Int64(-2));
+    CborWriter::appendNumber(output, Poco::Int64(getTimestamp().epochMicroseconds()));
+
+    for (auto& item: _items)
+    {
+        if (!item.first.isValid())
+            continue;
 
-    const Poco::DynamicStruct structObject = object.extract<Poco::DynamicStruct>();
+        CborWriter::appendNumber(output, Poco::UInt64(item.first.value));
+        const Poco::Dynamic::Var& value = item.second;
+        if (value.isArray())
+        {
+            CborWriter::appendHead(output, CborWriter::Array, value.size());
+            for(size_t i = 0; i < value.size(); i++)
+                appendCbor(output, value[i]);
+        }
+        else
+        {
+            appendCbor(output, value);
+        }
+    }
+}
+
+SimpleAsterixRecordPtr SimpleAsterixRecord::fromCbor(CborReader& reader)
+{
     SimpleAsterixRecordPtr instance = std::make_shared<SimpleAsterixRecord>();
+    size_t count = reader.readMap();
 
-    for(auto& record: structObject)
+    for(size_t i = 0; i < count; i++)
     {
-        // TODO: kontrolovat ci je symbol znamy!!!
-        instance->_items[asterixSymbolToCode(record.first)] = record.second;
+        if (reader.peek() == CborReader::Negative)
+        {
+            Poco::Int64 key = reader.readSigned();
+            if (key == -1)
+                instance->setCategory(Poco::UInt8(reader.readUnsigned()));
+            else if (key == -2)
+                instance->setTimestamp(Poco::Timestamp(reader.readSigned()));
+            else
+                reader.skip();
+            continue;
+        }
+
+        Poco::UInt64 key = reader.readUnsigned();
+        if (key == 0 || key > 0xFFFFFFFF)
+            throw Exception("SimpleAsterixRecord::fromCbor(): invalid item code " + std::to_string(key));
+
+        AsterixItemCode code = Poco::UInt32(key);
+        if (reader.peek() == CborReader::Array)
+        {
+            size_t size = reader.readArray();
+            std::vector<Poco::Dynamic::Var> array;
+            array.reserve(size);
+            for(size_t j = 0; j < size; j++)
+                array.push_back(readCbor(reader, code.type()));
+            instance->_items[code] = Poco::Dynamic::Var(array);
+        }
+        else
+        {
+            instance->_items[code] = readCbor(reader, code.type());
+        }
     }
+    return instance;
+}
 
+SimpleAsterixRecordPtr SimpleAsterixRecord::fromCbor(const void* data, size_t size)
+{
+    CborReader reader(data, size);
+    SimpleAsterixRecordPtr instance = fromCbor(reader);
+    if (!reader.atEnd())
+        throw Exception("SimpleAsterixRecord::fromCbor(): trailing data at offset " + std::to_string(reader.getOffset()));
     return instance;
 }
 
@@ -19,6 +19,7 @@ namespace astlib
 {
 
 class ASTLIB_API SimpleAsterixRecord;
+class ASTLIB_API CborReader;
 using SimpleAsterixRecordPtr = std::shared_ptr<SimpleAsterixRecord>;
 
 /**
@@ -108,8 +109,16 @@ public:
      */
     std::string toString() const override;
 
+    /**
+     * @return items as flat Json object keyed by symbol names, arrays as Json arrays
+     */
     std::string toJson() const;
 
+    /**
+     * Appends Json form of items to output, without temporary strings.
+     */
+    void toJson(std::string& output) const;
+
     /**
      * @return initialized items count
      */
@@ -120,7 +129,29 @@ public:
      */
     void clear();
 
+    /**
+     * Parses object produced by toJson(), values are stored in types of their item codes.
+     * Unknown symbols are skipped, malformed text throws Exception.
+     */
     static SimpleAsterixRecordPtr fromJson(const std::string& json);
+    static SimpleAsterixRecordPtr fromJson(const char* json, size_t size);
+
+    /**
+     * Appends CBOR map keyed by AsterixItemCode values, arrays as CBOR arrays.
+     * Negative keys hold record header, -1 category and -2 timestamp in microseconds.
+     */
+    void toCbor(std::string& output) const;
+
+    /**
+     * Reads one record written by toCbor(), e.g. from CBOR sequence of records.
+     * Values are stored in types of their item codes, unknown negative keys are skipped.
+     */
+    static SimpleAsterixRecordPtr fromCbor(CborReader& reader);
+
+    /**
+     * Parses single record, trailing data throws Exception.
+     */
+    static SimpleAsterixRecordPtr fromCbor(const void* data, size_t size);
 
 private:
     std::map<AsterixItemCode, Poco::Dynamic::Var> _items;
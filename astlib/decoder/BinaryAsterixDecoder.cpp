@@ -16,9 +16,12 @@
 #include "model/RepetitiveItemDescription.h"
 #include "model/ExplicitItemDescription.h"
 #include "model/CompoundItemDescription.h"
+#include "EmptyValueDecoder.h"
 #include "Exception.h"
 
 #include <Poco/ByteOrder.h>
+#include <algorithm>
+#include <utility>
 #include <iostream>
 
 namespace astlib
@@ -35,153 +38,197 @@ BinaryAsterixDecoder::~BinaryAsterixDecoder()
 
 void BinaryAsterixDecoder::decode(const CodecDescription& codec, ValueDecoder& valueDecoder, const Byte buf[], size_t bytes)
 {
-    if (bytes < 6)
+    DecodeResult result = tryDecode(codec, valueDecoder, buf, bytes);
+
+    // Error from user callback is propagated unchanged
+    if (_callbackError)
+        std::rethrow_exception(std::exchange(_callbackError, nullptr));
+
+    if (!result.ok())
+        throw Exception("BinaryDataDekoder::decode(): " + result.toString());
+}
+
+DecodeResult BinaryAsterixDecoder::tryDecode(const CodecDescription& codec, ValueDecoder& valueDecoder, const Byte buf[], size_t bytes) noexcept
+{
+    _result = DecodeResult();
+    _callbackError = nullptr;
+    _depth = 0;
+    _begin = buf;
+
+    // CAT + LEN + at least one byte of FSPEC and item
+    if (bytes < 5)
     {
-        throw Exception("Too short message in BinaryDataDekoder::decode()");
+        fail(DecodeResult::TooShort, buf, -1);
+        return _result;
     }
 
-    const unsigned short *sizePtr;
-    const Byte *fspecPtr;
-    unsigned index = 1;
-
-    sizePtr = (unsigned short *)(buf+index);
     // TODO: brat endian z codec
-    int size = Poco::ByteOrder::fromNetwork(*sizePtr);
-    index += 2;
-
-    size -= index;
+    size_t size = (size_t(buf[1]) << 8) | buf[2];
+    _result.length = size;
 
-    if (size < 2 || size > MAX_PACKET_SIZE)
+    if (size < 5 || size > MAX_PACKET_SIZE)
     {
-        throw Exception("Bad size of subpacket in BinaryDataDekoder::decode()");
+        fail(DecodeResult::BadLength, buf + 1, -1);
+        return _result;
     }
 
-    while(1)
+    _end = buf + std::min(size, bytes);
+
+    if (_policy.recovery == CodecPolicy::SkipBlock)
     {
-        fspecPtr = (Byte *)buf+index;
+        // Structure only pass, nothing is delivered from corrupted block
+        EmptyValueDecoder emptyDecoder;
+        _validate = true;
+        decodeBlock(codec, emptyDecoder);
+        _validate = false;
+
+        _result.records = 0;
+        if (!_result.ok())
+            return _result;
+    }
 
-        if (size == 0)
-            break;
+    decodeBlock(codec, valueDecoder);
 
-        int len = decodeRecord(codec, valueDecoder, fspecPtr);
+    if (_result.ok() && size > bytes)
+        fail(DecodeResult::Truncated, _end, -1);
 
-        // Chyba, treba vyskocit inak bude nekonecna slucka
-        if (len <= 0)
-            throw Exception("BinaryDataDekoder::decode(): buffer underflow");
+    return _result;
+}
 
-        index += len;
-        size -= len;
+void BinaryAsterixDecoder::decodeBlock(const CodecDescription& codec, ValueDecoder& valueDecoder) noexcept
+{
+    const Byte* ptr = _begin + 3;
 
-        if (index > bytes)
-            throw Exception("BinaryDataDekoder::decode(): buffer overflow - codec eats " + std::to_string(index-bytes) + " more bytes");
+    while(ptr < _end)
+    {
+        int len;
 
-        //if (index < bytes) throw Exception("BinaryDataDekoder::decode(): buffer underflow - codec eats " + std::to_string(bytes-index) + " less bytes");
+        try
+        {
+            len = decodeRecord(codec, valueDecoder, ptr);
+        }
+        catch(...)
+        {
+            // Exception from user callback, decoder itself doesn't throw
+            if (_result.ok())
+                _callbackError = std::current_exception();
+            fail(DecodeResult::ValueError, ptr, -1);
+
+            // Unfinished record must not stay in callback's output
+            _depth = 0;
+            try
+            {
+                valueDecoder.abort();
+            }
+            catch(...)
+            {
+            }
+            len = -1;
+        }
 
-        if (index == bytes)
+        if (len <= 0)
             break;
+
+        ptr += len;
+        _result.records++;
+    }
+}
+
+int BinaryAsterixDecoder::fail(DecodeResult::Error error, const Byte* ptr, int frn)
+{
+    if (_result.ok())
+    {
+        _result.error = error;
+        _result.offset = size_t(ptr - _begin);
+        _result.frn = frn;
     }
+    return -1;
 }
 
 int BinaryAsterixDecoder::decodeRecord(const CodecDescription& codec, ValueDecoder& valueDecoder, const Byte fspecPtr[])
 {
     const Byte* startPtr = fspecPtr;
-    size_t fspecLen = ByteUtils::calculateFspec(fspecPtr);
+    size_t fspecLen = ByteUtils::scanFxChain(fspecPtr, _end - fspecPtr);
 
-    if (fspecPtr[0] == 0)
-        throw Exception("Bad FSPEC[0] value for decoded message in AsterixCategory::decodeMessageERA()");
+    if (fspecLen == 0)
+        return fail(DecodeResult::Truncated, fspecPtr, -1);
 
-    const Byte *localPtr = fspecPtr + fspecLen;
-    int fspecMask = 0x80;
-    int currentFspecBit = 0;
+    if (fspecLen > MAX_FSPEC_SIZE || fspecPtr[0] == 0)
+        return fail(DecodeResult::BadFspec, fspecPtr, -1);
 
-    // Loop for all fspec bits
-    const CodecDescription::UapItems& uapItems = codec.enumerateUapItems();
+    const Byte *localPtr = fspecPtr + fspecLen;
+    int frns[MAX_FSPEC_SIZE*7];
+    size_t frnCount = ByteUtils::expandFspec(fspecPtr, fspecLen, frns);
 
     valueDecoder.begin(codec.getCategoryDescription().getCategory());
 
-    for (size_t i = 0; i < fspecLen; i++)
+    // Loop for present items only
+    for (size_t i = 0; i < frnCount; i++)
     {
-        for(int j = 0; j < 8; j++)
-        {
-            bool bitPresent = (fspecMask & *fspecPtr);  // priznak pritomnosti aktualne testovaneho FSPEC bitu
-            int decodedByteCount = 0;
+        _frn = frns[i];
+        const CodecDescription::UapItem* entry = codec.getUapItem(_frn);
 
-            if (fspecMask & FX_BIT)
-            {
-                fspecMask = 0x80;
-                // Sme v prechode na dalsi FSPEC bajt
-                if (bitPresent == false)
-                {
-                    // Definitivne koncime
-                    break;
-                }
-
-                fspecPtr++;
-                currentFspecBit++;
-                continue;
-            }
+        if (!entry)
+        {
+            valueDecoder.abort();
+            return fail(DecodeResult::UndefinedItem, localPtr, _frn);
+        }
 
-            auto iterator = uapItems.find(currentFspecBit);
-            if (iterator == uapItems.end() || (!iterator->second.item && bitPresent))
-                throw Exception("Undefined Data Item for bit " + std::to_string(currentFspecBit));
+        const ItemDescription& uapItem = *entry->item;
+        bool mandatory = entry->mandatory;
+        int decodedByteCount = 0;
 
-            const ItemDescription& uapItem = *iterator->second.item;
-            bool mandatory = iterator->second.mandatory;
+        valueDecoder.beginItem(uapItem);
 
-            if (bitPresent)
-            {
-                valueDecoder.beginItem(uapItem);
+        if (_policy.verbose)
+            std::cout << "Decode " << (mandatory?"mandatory ":"optional ") << uapItem.getType().toString() << " " << codec.getCategoryDescription().getCategory() << "/" << uapItem.getId() << ": " << uapItem.getDescription() << std::endl;
 
-                if (_policy.verbose)
-                    std::cout << "Decode " << (mandatory?"mandatory ":"optional ") << uapItem.getType().toString() << " " << codec.getCategoryDescription().getCategory() << "/" << uapItem.getId() << ": " << uapItem.getDescription() << std::endl;
+        _depth++;
 
-                _depth++;
+        switch(uapItem.getType().toValue())
+        {
+            case ItemFormat::Fixed:
+                decodedByteCount = decodeFixed(uapItem, valueDecoder, localPtr);
+                break;
 
-                switch(uapItem.getType().toValue())
-                {
-                    case ItemFormat::Fixed:
-                        decodedByteCount += decodeFixed(uapItem, valueDecoder, localPtr);
-                        break;
+            case ItemFormat::Variable:
+                decodedByteCount = decodeVariable(uapItem, valueDecoder, localPtr);
+                break;
 
-                    case ItemFormat::Variable:
-                        decodedByteCount += decodeVariable(uapItem, valueDecoder, localPtr);
-                        break;
+            case ItemFormat::Repetitive:
+                decodedByteCount = decodeRepetitive(uapItem, valueDecoder, localPtr);
+                break;
 
-                    case ItemFormat::Repetitive:
-                        decodedByteCount += decodeRepetitive(uapItem, valueDecoder, localPtr);
-                        break;
+            case ItemFormat::Compound:
+                decodedByteCount = decodeCompound(uapItem, valueDecoder, localPtr);
+                break;
 
-                    case ItemFormat::Compound:
-                        decodedByteCount += decodeCompound(uapItem, valueDecoder, localPtr);
-                        break;
+            case ItemFormat::Explicit:
+                decodedByteCount = decodeExplicit(uapItem, valueDecoder, localPtr);
+                break;
 
-                    case ItemFormat::Explicit:
-                        decodedByteCount += decodeExplicit(uapItem, valueDecoder, localPtr);
-                        break;
+        }
 
-                }
+        --_depth;
 
-                --_depth;
-            }
-            else if (mandatory)
-            {
-                // TODO: nepritomna ale povinna polozka ...
-            }
+        if (decodedByteCount < 0)
+        {
+            _depth = 0;
+            valueDecoder.abort();
+            return -1;
+        }
 
-            if (_policy.verbose && decodedByteCount>0)
+        if (_policy.verbose && decodedByteCount>0)
+        {
+            for(int i = 0; i < decodedByteCount; i++)
             {
-                for(int i = 0; i < decodedByteCount; i++)
-                {
-                    std::cout << " " << Poco::NumberFormatter::formatHex(localPtr[i], 2, false);
-                }
-                std::cout << std::endl;
-                std::cout << "  " << " Stream advance " << decodedByteCount << " bytes" << std::endl;
+                std::cout << " " << Poco::NumberFormatter::formatHex(localPtr[i], 2, false);
             }
-
-            localPtr += decodedByteCount;
-            currentFspecBit++;
-            fspecMask >>= 1;
+            std::cout << std::endl;
+            std::cout << "  " << " Stream advance " << decodedByteCount << " bytes" << std::endl;
         }
+
+        localPtr += decodedByteCount;
     }
 
     valueDecoder.end();
@@ -193,6 +240,10 @@ int BinaryAsterixDecoder::decodeFixed(const ItemDescription& uapItem, ValueDecod
 {
     const FixedItemDescription& fixedItem = static_cast<const FixedItemDescription&>(uapItem);
     const Fixed& fixed = fixedItem.getFixed();
+
+    if (_end - data < fixed.length)
+        return fail(DecodeResult::Truncated, data, _frn);
+
     decodeBitset(uapItem, fixed, data, valueDecoder, -1, 0);
     return fixed.length;
 }
@@ -204,12 +255,18 @@ int BinaryAsterixDecoder::decodeVariable(const ItemDescription& uapItem, ValueDe
     auto ptr = data;
     int decodedByteCount = 0;
 
+    if (fixedVector.empty())
+        return fail(DecodeResult::BadItem, data, _frn);
+
     for(;;)
     {
         Byte fspecBit;
         for(const Fixed& fixed: fixedVector)
         {
             auto len = fixed.length;
+            if (_end - ptr < len)
+                return fail(DecodeResult::Truncated, ptr, _frn);
+
             fspecBit = (ptr[len-1] & FX_BIT);
 
             decodeBitset(uapItem, fixed, ptr, valueDecoder, -1, 0);
@@ -229,38 +286,37 @@ int BinaryAsterixDecoder::decodeRepetitive(const ItemDescription& uapItem, Value
 {
     const RepetitiveItemDescription& varItem = static_cast<const RepetitiveItemDescription&>(uapItem);
     const FixedVector& fixedVector = varItem.getFixedVector();
-    int decodedByteCount = 1;
-    int counter = *data;
-    auto ptr = data+1;
-
-    // TODO: zrusit?
-    valueDecoder.beginRepetitive(counter);
-
-    for(int j = 0; j < counter; j++)
-    {
-        // TODO: zrusit?
-        valueDecoder.repetitiveItem(j);
-        for(const Fixed& fixed: fixedVector)
-        {
-            decodeBitset(uapItem, fixed, ptr, valueDecoder, j, counter);
-            decodedByteCount += fixed.length;
-            ptr += fixed.length;
-        }
-    }
 
-    // TODO: zrusit?
-    valueDecoder.endRepetitive();
+    if (_end - data < 1)
+        return fail(DecodeResult::Truncated, data, _frn);
 
-    return decodedByteCount;
+    return decodeRepetitions(uapItem, fixedVector, valueDecoder, data + 1, *data) + 1;
 }
 
 int BinaryAsterixDecoder::decodeExplicit(const ItemDescription& uapItem, ValueDecoder& valueDecoder, const Byte data[])
 {
     const ExplicitItemDescription& varItem = static_cast<const ExplicitItemDescription&>(uapItem);
     const FixedVector& fixedVector = varItem.getFixedVector();
-    int decodedByteCount = 1;
-    int counter = *data -1;
-    auto ptr = data+1;
+
+    if (_end - data < 1)
+        return fail(DecodeResult::Truncated, data, _frn);
+    if (*data == 0)
+        return fail(DecodeResult::BadItem, data, _frn);
+
+    return decodeRepetitions(uapItem, fixedVector, valueDecoder, data + 1, *data - 1) + 1;
+}
+
+int BinaryAsterixDecoder::decodeRepetitions(const ItemDescription& uapItem, const FixedVector& fixedVector, ValueDecoder& valueDecoder, const Byte data[], int counter)
+{
+    int repetitionSize = 0;
+    for(const Fixed& fixed: fixedVector)
+        repetitionSize += fixed.length;
+
+    if (_end - data < repetitionSize * counter)
+        return fail(DecodeResult::Truncated, data, _frn);
+
+    int decodedByteCount = 0;
+    auto ptr = data;
 
     // TODO: zrusit?
     valueDecoder.beginRepetitive(counter);
@@ -288,37 +344,32 @@ int BinaryAsterixDecoder::decodeCompound(const ItemDescription& uapItem, ValueDe
     const CompoundItemDescription& compoundItem = static_cast<const CompoundItemDescription&>(uapItem);
     const ItemDescriptionVector& items = compoundItem.getItemsVector();
     int allByteCount = 0;
-    auto itemCount = items.size();
-    ItemDescriptionVector usedItems;
-    size_t itemIndex = 1; // zero index is for Variable item itself
+    const ItemDescription* usedItems[MAX_FSPEC_SIZE*7]; // zero index of items is for Variable item itself
 
-    poco_assert(itemCount);
-    poco_assert(items[0]->getType() == ItemFormat::Variable);
+    if (items.empty() || items[0]->getType() != ItemFormat::Variable)
+        return fail(DecodeResult::BadItem, data, _frn);
 
-    for(;;)
-    {
-        Byte fspec = data[0];
-        int mask = 0x80;
-        for(int j = 0; j < 7; j++)
-        {
-            if (fspec & mask)
-            {
-                poco_assert(itemIndex < items.size());
-                poco_assert(items[itemIndex]);
-                usedItems.push_back(items[itemIndex]);
-            }
-            mask >>= 1;
-            itemIndex++;
-        }
+    size_t fspecLen = ByteUtils::scanFxChain(data, _end - data);
+    if (fspecLen == 0)
+        return fail(DecodeResult::Truncated, data, _frn);
+    if (fspecLen > MAX_FSPEC_SIZE)
+        return fail(DecodeResult::BadItem, data, _frn);
 
-        data++;
-        allByteCount++;
+    int indexes[MAX_FSPEC_SIZE*7];
+    size_t usedItemsCount = ByteUtils::expandFspec(data, fspecLen, indexes);
 
-        if ((fspec & FX_BIT) == 0)
-            break;
+    for(size_t i = 0; i < usedItemsCount; i++)
+    {
+        // 7 subitem bits per FSPEC byte
+        size_t itemIndex = indexes[i] - indexes[i]/8 + 1;
+        if (itemIndex >= items.size() || !items[itemIndex])
+            return fail(DecodeResult::BadItem, data, _frn);
+        usedItems[i] = items[itemIndex].get();
     }
 
-    auto usedItemsCount = usedItems.size();
+    data += fspecLen;
+    allByteCount += fspecLen;
+
     for(size_t i = 0; i < usedItemsCount; i++)
     {
         const ItemDescription& uapItem = *usedItems[i];
@@ -340,8 +391,13 @@ int BinaryAsterixDecoder::decodeCompound(const ItemDescription& uapItem, ValueDe
                 break;
 
             default:
-                throw Exception("Unhandled SubItem type: " + uapItem.getType().toString());
+                // Unhandled SubItem type
+                return fail(DecodeResult::BadItem, data, _frn);
         }
+
+        if (decodedByteCount < 0)
+            return -1;
+
         data += decodedByteCount;
         allByteCount += decodedByteCount;
     }
@@ -351,103 +407,33 @@ int BinaryAsterixDecoder::decodeCompound(const ItemDescription& uapItem, ValueDe
 
 void BinaryAsterixDecoder::decodeBitset(const ItemDescription& uapItem, const Fixed& fixed, const Byte* localPtr, ValueDecoder& valueDecoder, int index, int arraySize)
 {
+    if (_validate)
+        return;
+
     const BitsDescriptionArray& bitsDescriptions = fixed.bitsDescriptions;
-    Poco::UInt64 data = 0;
-    Poco::UInt64 data2 = 0;
-    Poco::UInt64 data3 = 0;
     int length = fixed.length;
-    Poco::UInt64 value;
-
-    for (int i = 0; i < length; i++)
-    {
-        data3 <<= 8;
-        data3 |= ((data2 >> 56) & 0xFF);
-    	data2 <<= 8;
-    	data2 |= ((data >> 56) & 0xFF);
-        data <<= 8;
-        data |= localPtr[i];
-    }
 
     for (const BitsDescription& bits : bitsDescriptions)
     {
         CodecContext context(uapItem, _policy, bits, _depth);
-        bool over64bits = (bits.to + context.width) > 64;
-        bool over128bits = (bits.to + context.width) > 128;
 
         if (_policy.verbose)
         {
             std::cout << "  decode " << bits.toString() << std::endl;
         }
 
-        if (context.width == 1)
-        {
-            int lowBit = bits.bit - 1;
-            // Send non FX bits only
-            if (!bits.fx)
-            {
-                if (!over64bits && !over128bits)
-                	value = ((data >> lowBit) & 1);
-                else if (over64bits && !over128bits)
-                	value = ((data2 >> (lowBit-64)) & 1);
-                else
-                    value = ((data3 >> (lowBit - 128)) & 1);
-
-                if (index == 0)
-                {
-                    // Preinitialize array
-                    valueDecoder.beginArray(bits.code, arraySize);
-                }
-                valueDecoder.decode(context, value, index);
-            }
-        }
-        else
-        {
-            Poco::UInt64 mask = bits.bitMask();
-            int lowBit = bits.to - 1;
+        // Send non FX bits only
+        if (bits.fx)
+            continue;
 
-            if (!over64bits && !over128bits)
-            {
-            	value = ((data >> lowBit) & mask);
-            }
-            else if (over64bits && !over128bits)
-            {
-            	if (lowBit >= 64)
-            	{
-            		value = ((data2 >> (lowBit-64)) & mask);
-            	}
-            	else
-            	{
-            		// partially data and data2
-            		int shift1 = lowBit;
-            		int shift2 = 64-lowBit;
-            		Poco::UInt64 aux1 = ((data & (mask<<lowBit)) >> shift1);
-            		Poco::UInt64 aux2 = (data2 << shift2) & mask;
-            		value = (aux1 | aux2) & mask;
-            	}
-            }
-            else {
-                if (lowBit >= 128)
-                {
-                    value = ((data3 >> (lowBit - 128)) & mask);
-                }
-                else
-                {
-                    // partially data2 and data3
-                    int shift1 = lowBit;
-                    int shift2 = 128 - lowBit;
-                    Poco::UInt64 aux1 = ((data2 & (mask << lowBit)) >> shift1);
-                    Poco::UInt64 aux2 = (data3 << shift2) & mask;
-                    value = (aux1 | aux2) & mask;
-                }
-            }
+        Poco::UInt64 value = ByteUtils::peekBits(localPtr, length, context.plan.shift, context.width);
 
-            if (index == 0)
-            {
-                // Preinitialize array
-                valueDecoder.beginArray(bits.code, arraySize);
-            }
-            valueDecoder.decode(context, value, index);
+        if (index == 0)
+        {
+            // Preinitialize array
+            valueDecoder.beginArray(bits.code, arraySize);
         }
+        valueDecoder.decode(context, value, index);
     }
 }
 
@@ -13,10 +13,13 @@
 
 #include "astlib/CodecPolicy.h"
 #include "ValueDecoder.h"
+#include "DecodeResult.h"
 #include "astlib/model/CodecDescription.h"
 #include "astlib/model/Fixed.h"
 #include "astlib/ByteUtils.h"
 
+#include <exception>
+
 namespace astlib
 {
 
@@ -26,13 +29,15 @@ namespace astlib
 class ASTLIB_API BinaryAsterixDecoder
 {
 public:
-    static constexpr int MAX_PACKET_SIZE = 8192;
+    static constexpr int MAX_PACKET_SIZE = 65535;   ///< full range of 16-bit LEN
+    static constexpr int MAX_FSPEC_SIZE = 32;
 
     BinaryAsterixDecoder(CodecPolicy policy = CodecPolicy());
     ~BinaryAsterixDecoder();
 
     /**
      * Decodes binary asterix data from buffer with size.
+     * Throws Exception when data block is malformed, exception thrown by valueDecoder is rethrown unchanged.
      * @param codec formal description of concrete asterix category
      * @param valueDecoder callback object for pushing decoded items to user code
      * @param buf asterix data buffer, first byte is byte containing category number
@@ -40,19 +45,37 @@ public:
      */
     void decode(const CodecDescription& codec, ValueDecoder& valueDecoder, const Byte buf[], size_t bytes);
 
+    /**
+     * Exception-free variant of decode(), suitable for untrusted traffic.
+     * Exception thrown by valueDecoder is reported as DecodeResult::ValueError.
+     * Delivery of records from corrupted block is driven by CodecPolicy::recovery.
+     * @return error code with offset and FRN of failing item, number of delivered records
+     */
+    DecodeResult tryDecode(const CodecDescription& codec, ValueDecoder& valueDecoder, const Byte buf[], size_t bytes) noexcept;
+
 private:
-    // Integer sizes are used instead of unsigned types for underflow/overflow detection
+    // Integer sizes are used instead of unsigned types for underflow/overflow detection, negative size is error
+    void decodeBlock(const CodecDescription& codec, ValueDecoder& valueDecoder) noexcept;
     int decodeRecord(const CodecDescription& codec, ValueDecoder& valueDecoder, const Byte buf[]);
     int decodeFixed(const ItemDescription& uapItem, ValueDecoder& valueDecoder, const Byte ptr[]);
     int decodeVariable(const ItemDescription& uapItem, ValueDecoder& valueDecoder, const Byte ptr[]);
     int decodeRepetitive(const ItemDescription& uapItem, ValueDecoder& valueDecoder, const Byte ptr[]);
     int decodeExplicit(const ItemDescription& uapItem, ValueDecoder& valueDecoder, const Byte ptr[]);
+    int decodeRepetitions(const ItemDescription& uapItem, const FixedVector& fixedVector, ValueDecoder& valueDecoder, const Byte ptr[], int counter);
     int decodeCompound(const ItemDescription& uapItem, ValueDecoder& valueDecoder, const Byte ptr[]);
 
     void decodeBitset(const ItemDescription& uapItem, const Fixed& fixed, const Byte localPtr[], ValueDecoder& valueDecoder, int index, int arraySize);
 
+    int fail(DecodeResult::Error error, const Byte* ptr, int frn);
+
     CodecPolicy _policy;
     int _depth = 0;
+    int _frn = -1;                  ///< FRN of currently decoded item
+    bool _validate = false;         ///< structure only pass, values are not decoded
+    const Byte* _begin = nullptr;
+    const Byte* _end = nullptr;     ///< end of decoded data block, bound for all reads
+    DecodeResult _result;
+    std::exception_ptr _callbackError; ///< first exception thrown by valueDecoder in last decode
 };
 
 } /* namespace astlib */
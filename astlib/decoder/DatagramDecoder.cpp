@@ -0,0 +1,167 @@
+///
+/// \package astlib
+/// \file DatagramDecoder.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "DatagramDecoder.h"
+
+namespace astlib
+{
+
+// CAT + LEN
+static constexpr size_t HEADER_SIZE = 3;
+
+static size_t blockLength(const Byte buf[])
+{
+    return (size_t(buf[1]) << 8) | buf[2];
+}
+
+DatagramDecoder::Result& DatagramDecoder::Result::operator+=(const Result& other)
+{
+    blocks += other.blocks;
+    records += other.records;
+    unknownBlocks += other.unknownBlocks;
+    badBlocks += other.badBlocks;
+    skippedBytes += other.skippedBytes;
+    if (!other.lastError.ok())
+        lastError = other.lastError;
+    return *this;
+}
+
+DatagramDecoder::DatagramDecoder(CodecPolicy policy) :
+    _decoder(policy),
+    _codecs(256)
+{
+}
+
+DatagramDecoder::~DatagramDecoder()
+{
+}
+
+void DatagramDecoder::setCodec(CodecDescriptionPtr codec)
+{
+    _codecs[codec->getCategoryDescription().getCategory() & 0xFF] = codec;
+}
+
+void DatagramDecoder::setCodecs(const CodecRegister& codecRegister)
+{
+    for(auto codec: codecRegister.enumerateAllCodecsByCategory())
+        setCodec(codec);
+}
+
+const CodecDescription* DatagramDecoder::getCodec(int category) const
+{
+    if (category < 0 || category > 255)
+        return nullptr;
+    return _codecs[category].get();
+}
+
+DatagramDecoder::Result DatagramDecoder::decode(ValueDecoder& valueDecoder, const Byte buf[], size_t bytes) noexcept
+{
+    Result result;
+    size_t offset = 0;
+
+    while(offset < bytes)
+    {
+        const Byte* block = buf + offset;
+        size_t remaining = bytes - offset;
+        size_t length = remaining >= HEADER_SIZE ? blockLength(block) : 0;
+
+        if (length < HEADER_SIZE || length > remaining || length > size_t(BinaryAsterixDecoder::MAX_PACKET_SIZE))
+        {
+            // Garbage or truncated header
+            result.badBlocks++;
+            result.lastError = DecodeResult();
+            result.lastError.error = remaining < HEADER_SIZE ? DecodeResult::TooShort : (length > remaining ? DecodeResult::Truncated : DecodeResult::BadLength);
+            result.lastError.offset = offset;
+            result.lastError.length = length;
+
+            size_t skip = resynchronise(block, remaining);
+            result.skippedBytes += skip;
+            offset += skip;
+            continue;
+        }
+
+        const CodecDescription* codec = _codecs[block[0]].get();
+
+        if (length == HEADER_SIZE)
+        {
+            // Empty data block
+            result.blocks++;
+        }
+        else if (!codec)
+        {
+            result.unknownBlocks++;
+        }
+        else
+        {
+            DecodeResult blockResult = _decoder.tryDecode(*codec, valueDecoder, block, length);
+            result.records += blockResult.records;
+
+            if (blockResult.ok())
+            {
+                result.blocks++;
+            }
+            else
+            {
+                result.badBlocks++;
+                result.lastError = blockResult;
+                result.lastError.offset += offset;
+
+                // LEN of corrupted block is trusted only when another block follows it
+                if (!isChained(block, remaining))
+                {
+                    size_t skip = resynchronise(block, remaining);
+                    result.skippedBytes += skip;
+                    offset += skip;
+                    continue;
+                }
+            }
+        }
+
+        offset += length;
+    }
+
+    return result;
+}
+
+bool DatagramDecoder::isPlausible(const Byte buf[], size_t bytes) const
+{
+    if (bytes < HEADER_SIZE || !_codecs[buf[0]])
+        return false;
+
+    size_t length = blockLength(buf);
+
+    if (length < HEADER_SIZE || length > bytes || length > size_t(BinaryAsterixDecoder::MAX_PACKET_SIZE))
+        return false;
+
+    // First record starts with non empty FSPEC
+    return length == HEADER_SIZE || (length > HEADER_SIZE + 1 && buf[HEADER_SIZE] != 0);
+}
+
+bool DatagramDecoder::isChained(const Byte buf[], size_t bytes) const
+{
+    if (!isPlausible(buf, bytes))
+        return false;
+
+    size_t length = blockLength(buf);
+    return length == bytes || isPlausible(buf + length, bytes - length);
+}
+
+size_t DatagramDecoder::resynchronise(const Byte buf[], size_t bytes) const
+{
+    for(size_t offset = 1; offset < bytes; offset++)
+    {
+        if (isChained(buf + offset, bytes - offset))
+            return offset;
+    }
+    return bytes;
+}
+
+} /* namespace astlib */
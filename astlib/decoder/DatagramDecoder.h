@@ -0,0 +1,81 @@
+///
+/// \package astlib
+/// \file DatagramDecoder.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "BinaryAsterixDecoder.h"
+#include "astlib/CodecRegister.h"
+
+#include <vector>
+
+namespace astlib
+{
+
+/**
+ * Decodes datagrams with several concatenated data blocks, possibly of different categories.
+ * Each block is dispatched to codec registered for its category. After corrupted block
+ * decoder resynchronises on the next plausible CAT/LEN header.
+ */
+class ASTLIB_API DatagramDecoder
+{
+public:
+    struct Result
+    {
+        size_t blocks = 0;          ///< successfully decoded data blocks
+        size_t records = 0;         ///< records delivered to value decoder
+        size_t unknownBlocks = 0;   ///< well formed blocks of category without codec
+        size_t badBlocks = 0;       ///< corrupted data blocks
+        size_t skippedBytes = 0;    ///< bytes dropped while resynchronising
+        DecodeResult lastError;     ///< last block error, offset is relative to datagram start
+
+        bool ok() const { return badBlocks == 0 && skippedBytes == 0; }
+
+        Result& operator+=(const Result& other);
+    };
+
+    DatagramDecoder(CodecPolicy policy = CodecPolicy());
+    ~DatagramDecoder();
+
+    /**
+     * Register codec for its category, replaces previous one.
+     */
+    void setCodec(CodecDescriptionPtr codec);
+
+    /**
+     * Register latest editions of all codecs from register.
+     */
+    void setCodecs(const CodecRegister& codecRegister);
+
+    /**
+     * @return codec for category or nullptr
+     */
+    const CodecDescription* getCodec(int category) const;
+
+    /**
+     * Decodes all data blocks from datagram.
+     * @param valueDecoder callback object for pushing decoded items to user code
+     * @param buf datagram payload
+     * @param bytes size of payload
+     */
+    Result decode(ValueDecoder& valueDecoder, const Byte buf[], size_t bytes) noexcept;
+
+private:
+    /// Data block header is valid and block fits into datagram
+    bool isPlausible(const Byte buf[], size_t bytes) const;
+    /// Like isPlausible() and also block is followed by end of datagram or another plausible header
+    bool isChained(const Byte buf[], size_t bytes) const;
+    size_t resynchronise(const Byte buf[], size_t bytes) const;
+
+    BinaryAsterixDecoder _decoder;
+    std::vector<CodecDescriptionPtr> _codecs;
+};
+
+} /* namespace astlib */
@@ -0,0 +1,55 @@
+///
+/// \package astlib
+/// \file DecodeResult.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "DecodeResult.h"
+
+namespace astlib
+{
+
+const char* DecodeResult::errorName(Error error)
+{
+    switch(error)
+    {
+        case None:
+            return "no error";
+        case TooShort:
+            return "too short message";
+        case BadLength:
+            return "bad size of data block";
+        case Truncated:
+            return "buffer overflow";
+        case BadFspec:
+            return "bad FSPEC";
+        case UndefinedItem:
+            return "undefined data item";
+        case BadItem:
+            return "malformed data item";
+        case ValueError:
+            return "value decoder failure";
+    }
+    return "unknown error";
+}
+
+std::string DecodeResult::toString() const
+{
+    std::string text(errorName(error));
+
+    if (error != None)
+    {
+        text += " at offset " + std::to_string(offset);
+        if (frn >= 0)
+            text += " (FRN bit " + std::to_string(frn) + ")";
+    }
+
+    return text;
+}
+
+} /* namespace astlib */
@@ -0,0 +1,55 @@
+///
+/// \package astlib
+/// \file DecodeResult.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "astlib/Astlib.h"
+
+#include <cstddef>
+#include <string>
+
+namespace astlib
+{
+
+/**
+ * Outcome of exception-free decoding of one data block.
+ */
+struct ASTLIB_API DecodeResult
+{
+    enum Error
+    {
+        None,
+        TooShort,           ///< buffer can't hold data block header and one record
+        BadLength,          ///< LEN field out of range
+        Truncated,          ///< record or item exceeds data block
+        BadFspec,           ///< empty or too long FSPEC
+        UndefinedItem,      ///< FSPEC bit without UAP item
+        BadItem,            ///< malformed item or unsupported item structure
+        ValueError          ///< value decoder callback failed
+    };
+
+    Error error = None;
+    size_t offset = 0;      ///< offset of the failing FSPEC/item from buffer start
+    int frn = -1;           ///< FRN of the failing item, -1 for header/FSPEC errors
+    size_t length = 0;      ///< size of the data block (LEN)
+    size_t records = 0;     ///< number of records delivered to value decoder
+
+    bool ok() const { return error == None; }
+
+    /**
+     * @return human readable description, builds message only on demand
+     */
+    std::string toString() const;
+
+    static const char* errorName(Error error);
+};
+
+} /* namespace astlib */
@@ -0,0 +1,213 @@
+///
+/// \package astlib
+/// \file ItemOffsetTable.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "ItemOffsetTable.h"
+
+#include "model/FixedItemDescription.h"
+#include "model/VariableItemDescription.h"
+#include "model/RepetitiveItemDescription.h"
+#include "model/ExplicitItemDescription.h"
+#include "model/CompoundItemDescription.h"
+#include "Exception.h"
+
+namespace astlib
+{
+
+ItemOffsetTable::ItemOffsetTable()
+{
+}
+
+ItemOffsetTable::~ItemOffsetTable()
+{
+}
+
+size_t ItemOffsetTable::scan(const CodecDescription& codec, const Byte record[], size_t bytes)
+{
+    _record = record;
+    _bytes = bytes;
+    _items.clear();
+    _parts.clear();
+
+    size_t fspecLen = ByteUtils::scanFxChain(record, bytes);
+    if (fspecLen == 0 || record[0] == 0)
+        throw Exception("ItemOffsetTable::scan(): bad FSPEC");
+    _fspecLength = fspecLen;
+
+    _frns.resize(fspecLen * 7);
+    size_t frnCount = ByteUtils::expandFspec(record, fspecLen, _frns.data());
+    size_t offset = fspecLen;
+
+    for(size_t i = 0; i < frnCount; i++)
+    {
+        int frn = _frns[i];
+        const CodecDescription::UapItem* uapItem = codec.getUapItem(frn);
+        if (!uapItem)
+            throw Exception("ItemOffsetTable::scan(): undefined Data Item for bit " + std::to_string(frn));
+
+        const ItemDescription& item = *uapItem->item;
+        size_t length = scanItem(item, offset, false);
+
+        _items.push_back(Item{frn, &item, offset, length});
+        offset += length;
+    }
+
+    _length = offset;
+    return offset;
+}
+
+const ItemOffsetTable::Item* ItemOffsetTable::findItem(int id) const
+{
+    for(const Item& item: _items)
+    {
+        if (item.item->getId() == id)
+            return &item;
+    }
+    return nullptr;
+}
+
+size_t ItemOffsetTable::findFields(AsterixItemCode code, std::vector<Field>& fields) const
+{
+    size_t count = 0;
+
+    for(const Part& part: _parts)
+    {
+        for(const BitsDescription& bits: part.fixed->bitsDescriptions)
+        {
+            if (bits.code.value == code.value && !bits.fx)
+            {
+                fields.push_back(Field{&part, &bits});
+                count++;
+            }
+        }
+    }
+
+    return count;
+}
+
+size_t ItemOffsetTable::scanItem(const ItemDescription& item, size_t offset, bool subitem)
+{
+    switch(item.getType().toValue())
+    {
+        case ItemFormat::Fixed:
+        {
+            const Fixed& fixed = static_cast<const FixedItemDescription&>(item).getFixed();
+            checkBounds(offset + fixed.length);
+            _parts.push_back(Part{&item, &fixed, offset, -1});
+            return fixed.length;
+        }
+
+        case ItemFormat::Variable:
+        {
+            const FixedVector& fixedVector = static_cast<const VariableItemDescription&>(item).getFixedVector();
+            size_t length = 0;
+
+            for(;;)
+            {
+                bool extent = false;
+                for(const Fixed& fixed: fixedVector)
+                {
+                    checkBounds(offset + length + fixed.length);
+                    _parts.push_back(Part{&item, &fixed, offset + length, -1});
+                    length += fixed.length;
+                    extent = (_record[offset + length - 1] & FX_BIT);
+                    if (!extent)
+                        break;
+                }
+                if (!extent)
+                    break;
+            }
+            return length;
+        }
+
+        case ItemFormat::Repetitive:
+        {
+            checkBounds(offset + 1);
+            const FixedVector& fixedVector = static_cast<const RepetitiveItemDescription&>(item).getFixedVector();
+            int counter = _record[offset];
+            size_t length = 1;
+
+            for(int j = 0; j < counter; j++)
+                length += addParts(item, fixedVector, offset + length, j);
+            return length;
+        }
+
+        case ItemFormat::Explicit:
+        {
+            if (subitem)
+                break;
+
+            checkBounds(offset + 1);
+            const FixedVector& fixedVector = static_cast<const ExplicitItemDescription&>(item).getFixedVector();
+            int counter = _record[offset] - 1;
+            size_t length = 1;
+
+            for(int j = 0; j < counter; j++)
+                length += addParts(item, fixedVector, offset + length, j);
+            return length;
+        }
+
+        case ItemFormat::Compound:
+        {
+            if (subitem)
+                break;
+
+            const ItemDescriptionVector& items = static_cast<const CompoundItemDescription&>(item).getItemsVector();
+            std::vector<const ItemDescription*> usedItems;
+            size_t itemIndex = 1; // zero index is for Variable item itself
+            size_t length = 0;
+
+            for(;;)
+            {
+                checkBounds(offset + length + 1);
+                Byte fspec = _record[offset + length++];
+                for(int j = 0; j < 7; j++, itemIndex++)
+                {
+                    if (fspec & (0x80 >> j))
+                    {
+                        if (itemIndex >= items.size() || !items[itemIndex])
+                            throw Exception("ItemOffsetTable::scan(): undefined compound subitem " + std::to_string(itemIndex));
+                        usedItems.push_back(items[itemIndex].get());
+                    }
+                }
+                if ((fspec & FX_BIT) == 0)
+                    break;
+            }
+
+            for(const ItemDescription* used: usedItems)
+                length += scanItem(*used, offset + length, true);
+            return length;
+        }
+    }
+
+    throw Exception("ItemOffsetTable::scan(): unhandled SubItem type: " + item.getType().toString());
+}
+
+size_t ItemOffsetTable::addParts(const ItemDescription& item, const FixedVector& fixedVector, size_t offset, int index)
+{
+    size_t length = 0;
+
+    for(const Fixed& fixed: fixedVector)
+    {
+        checkBounds(offset + length + fixed.length);
+        _parts.push_back(Part{&item, &fixed, offset + length, index});
+        length += fixed.length;
+    }
+
+    return length;
+}
+
+void ItemOffsetTable::checkBounds(size_t offset) const
+{
+    if (offset > _bytes)
+        throw Exception("ItemOffsetTable::scan(): record exceeds buffer by " + std::to_string(offset - _bytes) + " bytes");
+}
+
+} /* namespace astlib */
@@ -0,0 +1,102 @@
+///
+/// \package astlib
+/// \file ItemOffsetTable.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "astlib/model/CodecDescription.h"
+#include "astlib/model/Fixed.h"
+#include "astlib/ByteUtils.h"
+
+#include <vector>
+
+namespace astlib
+{
+
+/**
+ * Structural index of one encoded asterix record.
+ * Walks FSPEC and item lengths only (no values are decoded) and remembers where
+ * every present data item and every fixed-width part of it starts in the record.
+ */
+class ASTLIB_API ItemOffsetTable
+{
+public:
+    /**
+     * Present UAP data item.
+     */
+    struct Item
+    {
+        int frn;                        ///< FSPEC bit index of the item
+        const ItemDescription* item;
+        size_t offset;                  ///< offset from the first FSPEC byte
+        size_t length;
+    };
+
+    /**
+     * Fixed-width part (Fixed item, Variable extent, one repetition ...) of present data item.
+     */
+    struct Part
+    {
+        const ItemDescription* item;
+        const Fixed* fixed;
+        size_t offset;                  ///< offset from the first FSPEC byte
+        int index;                      ///< repetition index, -1 for non repetitive parts
+    };
+
+    /**
+     * Location of one bit field found by its code.
+     */
+    struct Field
+    {
+        const Part* part;
+        const BitsDescription* bits;
+    };
+
+    ItemOffsetTable();
+    ~ItemOffsetTable();
+
+    /**
+     * Scans record starting with FSPEC, throws Exception if record is malformed
+     * or exceeds bytes.
+     * @return record length in bytes
+     */
+    size_t scan(const CodecDescription& codec, const Byte record[], size_t bytes);
+
+    size_t getRecordLength() const { return _length; }
+    size_t getFspecLength() const { return _fspecLength; }
+    const std::vector<Item>& getItems() const { return _items; }
+    const std::vector<Part>& getParts() const { return _parts; }
+
+    /**
+     * @return present item with UAP id or nullptr
+     */
+    const Item* findItem(int id) const;
+
+    /**
+     * Collects all occurrences of field with code (repetitive items give more occurrences).
+     * @return number of found fields
+     */
+    size_t findFields(AsterixItemCode code, std::vector<Field>& fields) const;
+
+private:
+    size_t scanItem(const ItemDescription& item, size_t offset, bool subitem);
+    size_t addParts(const ItemDescription& item, const FixedVector& fixedVector, size_t offset, int index);
+    void checkBounds(size_t offset) const;
+
+    const Byte* _record = nullptr;
+    size_t _bytes = 0;
+    size_t _length = 0;
+    size_t _fspecLength = 0;
+    std::vector<Item> _items;
+    std::vector<Part> _parts;
+    std::vector<int> _frns;
+};
+
+} /* namespace astlib */
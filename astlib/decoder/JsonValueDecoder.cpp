@@ -14,96 +14,176 @@
 namespace astlib
 {
 
+JsonValueDecoder::JsonValueDecoder(std::ostream& output, bool pretty) :
+    _output(&output),
+    _writer(pretty)
+{
+}
+
+JsonValueDecoder::JsonValueDecoder(bool pretty) :
+    _output(nullptr),
+    _writer(pretty)
+{
+}
+
+JsonValueDecoder::~JsonValueDecoder()
+{
+    try
+    {
+        flush();
+    }
+    catch(...)
+    {
+    }
+}
+
 void JsonValueDecoder::begin(int cat)
 {
-    json = new Poco::JSON::Object();
-    json->set("category", cat);
+    _recordStart = _writer.size();
+    _inItem = false;
+    _inRepetition = false;
+
+    _writer.beginObject();
+    _writer.key("category");
+    _writer.value(cat);
+    if (_hasTimestamp)
+    {
+        _writer.key("timestamp");
+        _writer.value(_timestamp.epochMicroseconds());
+    }
+    if (!_feed.empty())
+    {
+        _writer.key("feed");
+        _writer.value(_feed);
+    }
+    if (!_source.empty())
+    {
+        _writer.key("source");
+        _writer.value(_source);
+    }
 }
 
 void JsonValueDecoder::beginItem(const astlib::ItemDescription& uapItem)
 {
-    Poco::JSON::Object::Ptr item = new Poco::JSON::Object();
-    json->set(uapItem.getDescription(), item);
-    setScope(item);
+    closeItem();
+    _writer.key(uapItem.getDescription());
+    _writer.beginObject();
+    _inItem = true;
 }
 
 void JsonValueDecoder::beginRepetitive(size_t count)
 {
-    Poco::JSON::Array::Ptr array = localArray = new Poco::JSON::Array();
-    scope()->set("array", array);
-
-    Poco::JSON::Object::Ptr item = new Poco::JSON::Object();
-    addScope(item);
+    _writer.key("array");
+    _writer.beginArray();
+    _inRepetition = false;
 }
 
 void JsonValueDecoder::repetitiveItem(int index)
 {
-    Poco::JSON::Object::Ptr item = new Poco::JSON::Object();
-    setScope(item);
-    localArray->add(item);
+    if (_inRepetition)
+        _writer.endObject();
+    _writer.beginObject();
+    _inRepetition = true;
 }
 
 void JsonValueDecoder::endRepetitive()
 {
-    removeScope();
+    if (_inRepetition)
+        _writer.endObject();
+    _writer.endArray();
+    _inRepetition = false;
 }
 
 void JsonValueDecoder::decodeBoolean(const CodecContext& context, bool value, int index)
 {
-    scope()->set(context.bits.name, Poco::Dynamic::Var(value));
+    _writer.key(context.bits.name);
+    _writer.value(value);
 }
 
 void JsonValueDecoder::decodeSigned(const CodecContext& context, Poco::Int64 value, int index)
 {
-    scope()->set(context.bits.name, Poco::Dynamic::Var(value));
+    _writer.key(context.bits.name);
+    _writer.value(value);
 }
 
 void JsonValueDecoder::decodeUnsigned(const CodecContext& context, Poco::UInt64 value, int index)
 {
-    JsonValueDecoder::scope()->set(context.bits.name, Poco::Dynamic::Var(value));
+    _writer.key(context.bits.name);
+    _writer.value(value);
 }
 
 void JsonValueDecoder::decodeReal(const CodecContext& context, double value, int index)
 {
-    JsonValueDecoder::scope()->set(context.bits.name, Poco::Dynamic::Var(value));
+    _writer.key(context.bits.name);
+    _writer.value(value);
 }
 
 void JsonValueDecoder::decodeString(const CodecContext& context, const std::string& value, int index)
 {
-    JsonValueDecoder::scope()->set(context.bits.name, Poco::Dynamic::Var(value));
+    _writer.key(context.bits.name);
+    _writer.value(value);
 }
 
 void JsonValueDecoder::end()
 {
-    json->stringify(std::cout, 2);
-    std::cout << std::endl;
-    json = nullptr;
-    removeScope();
+    closeItem();
+    _writer.endObject();
+    _writer.newline();
+
+    if (_output && _writer.size() >= _flushSize)
+        flush();
 }
 
-void JsonValueDecoder::setScope(Poco::JSON::Object::Ptr obj)
+void JsonValueDecoder::abort()
 {
-    if (scopes.empty())
-        scopes.push_back(obj);
-    else
-        scopes.back() = obj;
+    // Drop text of unfinished record only
+    _writer.truncate(_recordStart);
+    _inItem = false;
+    _inRepetition = false;
 }
 
-void JsonValueDecoder::addScope(Poco::JSON::Object::Ptr obj)
+void JsonValueDecoder::setTimestamp(const Poco::Timestamp& timestamp)
 {
-    scopes.push_back(obj);
+    _timestamp = timestamp;
+    _hasTimestamp = true;
+}
+
+void JsonValueDecoder::setSource(const std::string& feed, const std::string& source)
+{
+    _feed = feed;
+    _source = source;
+}
+
+void JsonValueDecoder::setFlushSize(size_t size)
+{
+    _flushSize = size;
+}
+
+void JsonValueDecoder::flush()
+{
+    if (_output == nullptr)
+        return;
+
+    const std::string& text = _writer.getBuffer();
+    if (!text.empty())
+        _output->write(text.data(), text.size());
+    _output->flush();
+    _writer.clear();
 }
 
-void JsonValueDecoder::removeScope()
+void JsonValueDecoder::takeOutput(std::string& output)
 {
-    auto array = *scopes.back();
-    scopes.pop_back();
+    output.assign(_writer.getBuffer());
+    _writer.clear();
 }
 
-Poco::JSON::Object::Ptr JsonValueDecoder::scope()
+void JsonValueDecoder::closeItem()
 {
-    poco_assert(!scopes.empty());
-    return scopes.back();
+    if (_inItem)
+    {
+        _writer.endObject();
+        _inItem = false;
+    }
 }
 
 } /* namespace astlib */
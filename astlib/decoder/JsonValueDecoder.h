@@ -12,19 +12,18 @@
 #pragma once
 
 #include "TypedValueDecoder.h"
+#include "astlib/io/JsonWriter.h"
 
-#include "Poco/JSON/JSON.h"
-#include "Poco/JSON/Object.h"
-#include "Poco/JSON/Query.h"
-#include "Poco/JSON/JSONException.h"
-
-#include <deque>
+#include <iostream>
 
 namespace astlib
 {
 
 /**
- * Decoder that prints decoded values in Json form to console.
+ * Decoder that prints decoded values in Json form to console or given stream.
+ * Records are emitted by streaming JsonWriter as callbacks arrive and written
+ * to the stream in batches, when buffered text exceeds flush size.
+ * Without stream the text stays buffered until takeOutput().
  */
 class ASTLIB_API JsonValueDecoder :
     public TypedValueDecoder
@@ -42,17 +41,63 @@ class ASTLIB_API JsonValueDecoder :
     virtual void decodeReal(const CodecContext& context, double value, int index);
     virtual void decodeString(const CodecContext& context, const std::string& value, int index);
     virtual void end();
+    virtual void abort();
+
+public:
+    enum { DEFAULT_FLUSH_SIZE = 64 * 1024 };
+
+    /**
+     * @param pretty indented records, otherwise one record per line
+     */
+    explicit JsonValueDecoder(std::ostream& output = std::cout, bool pretty = true);
+
+    /**
+     * Buffer only decoder, see takeOutput().
+     */
+    explicit JsonValueDecoder(bool pretty);
+
+    /// Writes buffered records
+    ~JsonValueDecoder();
+
+    /**
+     * Receive time written as "timestamp" in microseconds since epoch to following records.
+     */
+    virtual void setTimestamp(const Poco::Timestamp& timestamp);
+
+    /**
+     * Receiving feed and sender written as "feed" and "source" to following records,
+     * empty strings are not written.
+     */
+    void setSource(const std::string& feed, const std::string& source);
+
+    /**
+     * Buffered text of complete records is written to stream when it exceeds size.
+     */
+    void setFlushSize(size_t size);
+
+    /**
+     * Writes buffered records to stream and flushes it.
+     */
+    void flush();
+
+    /**
+     * Moves text of complete records to output, buffer capacity is kept for next records.
+     */
+    void takeOutput(std::string& output);
 
 private:
-    void setScope(Poco::JSON::Object::Ptr obj);
-    void addScope(Poco::JSON::Object::Ptr obj);
-    void removeScope();
-    Poco::JSON::Object::Ptr scope();
-
-    Poco::JSON::Object::Ptr json;
-    std::deque<Poco::JSON::Object::Ptr> scopes;
-    Poco::JSON::Array::Ptr localArray;
+    void closeItem();
+
+    std::ostream* _output;
+    JsonWriter _writer;
+    size_t _flushSize = DEFAULT_FLUSH_SIZE;
+    size_t _recordStart = 0;
+    bool _inItem = false;
+    bool _inRepetition = false;
+    Poco::Timestamp _timestamp;
+    bool _hasTimestamp = false;
+    std::string _feed;
+    std::string _source;
 };
 
 } /* namespace astlib */
-
@@ -26,6 +26,8 @@ void SimpleValueDecoder::begin(int cat)
 {
     _msg = std::make_shared<SimpleAsterixRecord>();
     _msg->setCategory(cat);
+    if (_hasTimestamp)
+        _msg->setTimestamp(_timestamp);
 }
 
 void SimpleValueDecoder::beginItem(const ItemDescription& uapItem)
@@ -72,4 +74,15 @@ void SimpleValueDecoder::end()
     _msg = nullptr;
 }
 
+void SimpleValueDecoder::abort()
+{
+    _msg = nullptr;
+}
+
+void SimpleValueDecoder::setTimestamp(const Poco::Timestamp& timestamp)
+{
+    _timestamp = timestamp;
+    _hasTimestamp = true;
+}
+
 } /* namespace astlib */
@@ -37,11 +37,15 @@ public:
     virtual void decodeReal(const CodecContext& context, double value, int index);
     virtual void decodeString(const CodecContext& context, const std::string& value, int index);
     virtual void end();
+    virtual void abort();
+    virtual void setTimestamp(const Poco::Timestamp& timestamp);
 
     virtual void onMessageDecoded(SimpleAsterixRecordPtr ptr) = 0;
 
 private:
     SimpleAsterixRecordPtr _msg;
+    Poco::Timestamp _timestamp;
+    bool _hasTimestamp = false;     ///< records are stamped by creation time otherwise
 };
 
 } /* namespace astlib */
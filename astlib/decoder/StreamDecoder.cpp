@@ -0,0 +1,156 @@
+///
+/// \package astlib
+/// \file StreamDecoder.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "StreamDecoder.h"
+
+#include <algorithm>
+
+namespace astlib
+{
+
+// CAT + LEN
+static constexpr size_t HEADER_SIZE = 3;
+
+StreamDecoder::StreamDecoder(CodecPolicy policy) :
+    _decoder(policy)
+{
+}
+
+StreamDecoder::~StreamDecoder()
+{
+}
+
+void StreamDecoder::setCodec(CodecDescriptionPtr codec)
+{
+    _decoder.setCodec(codec);
+}
+
+void StreamDecoder::setCodecs(const CodecRegister& codecRegister)
+{
+    _decoder.setCodecs(codecRegister);
+}
+
+DatagramDecoder::Result StreamDecoder::push(ValueDecoder& valueDecoder, const Byte data[], size_t bytes) noexcept
+{
+    DatagramDecoder::Result result;
+
+    while(bytes > 0)
+    {
+        if (!_pending.empty())
+        {
+            // Continue with block started by previous chunk
+            size_t length = headerLength(_pending.data(), _pending.size());
+
+            if (length == INCOMPLETE)
+            {
+                _pending.push_back(*data++);
+                bytes--;
+                _position++;
+                continue;
+            }
+            if (length == 0)
+            {
+                result.skippedBytes++;
+                _pending.erase(_pending.begin());
+                continue;
+            }
+
+            size_t count = std::min(length - _pending.size(), bytes);
+            _pending.insert(_pending.end(), data, data + count);
+            data += count;
+            bytes -= count;
+            _position += count;
+
+            if (_pending.size() == length)
+            {
+                decodeBlock(valueDecoder, _pending.data(), length, _position - length, result);
+                _pending.clear();
+            }
+            continue;
+        }
+
+        size_t length = headerLength(data, bytes);
+
+        if (length == 0)
+        {
+            result.skippedBytes++;
+            data++;
+            bytes--;
+            _position++;
+            continue;
+        }
+
+        if (length == INCOMPLETE || length > bytes)
+        {
+            // Incomplete block, whole rest of chunk is buffered
+            if (length != INCOMPLETE)
+                _pending.reserve(length);
+            _pending.assign(data, data + bytes);
+            _position += bytes;
+            break;
+        }
+
+        // Complete block decoded in place
+        decodeBlock(valueDecoder, data, length, _position, result);
+        data += length;
+        bytes -= length;
+        _position += length;
+    }
+
+    return result;
+}
+
+size_t StreamDecoder::headerLength(const Byte data[], size_t bytes)
+{
+    if (bytes < HEADER_SIZE)
+        return INCOMPLETE;
+
+    size_t length = ByteUtils::loadBigEndian(data + 1, 2);
+
+    // Category 0 is not used, it is mostly zero padding
+    if (data[0] == 0 || length < HEADER_SIZE)
+        return 0;
+    if (length == HEADER_SIZE)
+        return length;
+    if (bytes < HEADER_SIZE + 1)
+        return INCOMPLETE;
+
+    // Record starts with non empty FSPEC
+    return (length > HEADER_SIZE + 1 && data[HEADER_SIZE] != 0) ? length : 0;
+}
+
+void StreamDecoder::decodeBlock(ValueDecoder& valueDecoder, const Byte block[], size_t length, Poco::UInt64 position, DatagramDecoder::Result& result)
+{
+    DatagramDecoder::Result blockResult = _decoder.decode(valueDecoder, block, length);
+
+    if (!blockResult.lastError.ok())
+        blockResult.lastError.offset += size_t(position);
+
+    result += blockResult;
+}
+
+size_t StreamDecoder::getPendingSize() const
+{
+    return _pending.size();
+}
+
+Poco::UInt64 StreamDecoder::getPosition() const
+{
+    return _position;
+}
+
+void StreamDecoder::reset()
+{
+    _pending.clear();
+    _position = 0;
+}
+
+} /* namespace astlib */
@@ -0,0 +1,80 @@
+///
+/// \package astlib
+/// \file StreamDecoder.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "DatagramDecoder.h"
+
+#include <vector>
+
+namespace astlib
+{
+
+/**
+ * Push-style decoder of continuous byte stream (TCP, serial over IP, files), where data blocks
+ * are split arbitrarily across reads. Complete blocks are decoded directly from pushed chunk,
+ * only block crossing the chunk boundary is copied into internal buffer.
+ * Stream is framed by LEN of data blocks, implausible header (category 0, LEN less than 3
+ * or empty FSPEC) is skipped byte by byte.
+ */
+class ASTLIB_API StreamDecoder
+{
+public:
+    StreamDecoder(CodecPolicy policy = CodecPolicy());
+    ~StreamDecoder();
+
+    /**
+     * Register codec for its category, replaces previous one.
+     */
+    void setCodec(CodecDescriptionPtr codec);
+
+    /**
+     * Register latest editions of all codecs from register.
+     */
+    void setCodecs(const CodecRegister& codecRegister);
+
+    /**
+     * Decodes all data blocks completed by chunk.
+     * @param valueDecoder callback object for pushing decoded items to user code
+     * @param data next chunk of the stream
+     * @param bytes size of chunk
+     * @return statistics of blocks decoded by this call, error offset is relative to stream start
+     */
+    DatagramDecoder::Result push(ValueDecoder& valueDecoder, const Byte data[], size_t bytes) noexcept;
+
+    /**
+     * @return number of buffered bytes of incomplete data block
+     */
+    size_t getPendingSize() const;
+
+    /**
+     * @return number of bytes pushed since construction or reset()
+     */
+    Poco::UInt64 getPosition() const;
+
+    /**
+     * Drops incomplete data block, i.e. on reconnection.
+     */
+    void reset();
+
+private:
+    static constexpr size_t INCOMPLETE = size_t(-1);
+
+    /// @return length of data block, 0 for implausible header or INCOMPLETE when more bytes are needed
+    static size_t headerLength(const Byte data[], size_t bytes);
+    void decodeBlock(ValueDecoder& valueDecoder, const Byte block[], size_t length, Poco::UInt64 position, DatagramDecoder::Result& result);
+
+    DatagramDecoder _decoder;
+    std::vector<Byte> _pending;
+    Poco::UInt64 _position = 0;     ///< stream offset of the first byte after pending data
+};
+
+} /* namespace astlib */
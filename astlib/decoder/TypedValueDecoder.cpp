@@ -39,79 +39,52 @@ void TypedValueDecoder::decode(const CodecContext& ctx, Poco::UInt64 value, int
         throw Exception("TypedValueDecoder::decode: " + asterixCodeToSymbol(code) + " scalar value doesn't expects an index");
     }
 
-    Encoding::ValueType encoding = ctx.bits.encoding.toValue();
+    const BitsPlan& plan = ctx.plan;
 
-    switch(code.type())
+    switch(plan.kind)
     {
-        case PrimitiveType::Boolean:
+        case BitsPlan::Boolean:
             decodeBoolean(ctx, bool(value), index);
             break;
 
-        case PrimitiveType::Real:
-        {
-            double unit = 1.0;
-
-            if (ctx.policy.normalizeValues)
-            {
-                switch(ctx.bits.units.toValue())
-                {
-                    case Units::FT:
-                        unit = 0.3048;
-                        break;
-                    case Units::NM:
-                        unit = 1852.0;
-                        break;
-                    case Units::FL:
-                        unit = 0.3048 * 100.0;
-                        break;
-                }
-            }
-
-            if (encoding == Encoding::Unsigned)
-            {
-                decodeReal(ctx, value * ctx.bits.scale * unit, index);
-            }
-            else
-            {
-                decodeReal(ctx, ByteUtils::toSigned(value, ctx.width) * ctx.bits.scale * unit, index);
-            }
+        case BitsPlan::UnsignedReal:
+            decodeReal(ctx, value * (ctx.policy.normalizeValues ? plan.scale : ctx.bits.scale), index);
+            break;
+
+        case BitsPlan::Real:
+            decodeReal(ctx, ByteUtils::toSigned(value, ctx.width) * (ctx.policy.normalizeValues ? plan.scale : ctx.bits.scale), index);
             break;
-        }
 
-        case PrimitiveType::Integer:
+        case BitsPlan::Integer:
             decodeSigned(ctx, ByteUtils::toSigned(value, ctx.width), index);
             break;
 
-        case PrimitiveType::Unsigned:
-            if (encoding == Encoding::Octal)
-                decodeUnsigned(ctx, ByteUtils::oct2dec(value), index);
-            else
-                decodeUnsigned(ctx, value, index);
+        case BitsPlan::Unsigned:
+            decodeUnsigned(ctx, value, index);
+            break;
+
+        case BitsPlan::Octal:
+            decodeUnsigned(ctx, ByteUtils::oct2dec(value), index);
             break;
 
-        default:
+        case BitsPlan::Ascii:
         {
-            switch (encoding)
-            {
-                case Encoding::Ascii:
-                {
-                    std::string str((const char*)&value, ctx.bits.effectiveBitsWidth()/8);
-                    std::reverse(str.begin(), str.end());
-                    decodeString(ctx, str, index);
-                    break;
-                }
-                case Encoding::Octal:
-                    decodeUnsigned(ctx, ByteUtils::oct2dec(value), index);
-                    break;
-                case Encoding::SixBitsChar:
-                    decodeString(ctx, ByteUtils::fromSixBitString((const Byte*)&value), index);
-                    break;
-                case Encoding::Hex:
-                    decodeString(ctx, Poco::NumberFormatter::formatHex(value, ctx.width/8*2), index);
-                    break;
-            }
+            std::string str((const char*)&value, ctx.width/8);
+            std::reverse(str.begin(), str.end());
+            decodeString(ctx, str, index);
             break;
         }
+
+        case BitsPlan::SixBitsChar:
+            decodeString(ctx, ByteUtils::fromSixBitString((const Byte*)&value), index);
+            break;
+
+        case BitsPlan::Hex:
+            decodeString(ctx, Poco::NumberFormatter::formatHex(value, ctx.width/8*2), index);
+            break;
+
+        case BitsPlan::None:
+            break;
     }
 }
 
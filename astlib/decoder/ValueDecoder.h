@@ -14,6 +14,8 @@
 
 #include "astlib/CodecContext.h"
 
+#include <Poco/Timestamp.h>
+
 namespace astlib
 {
 
@@ -25,6 +27,7 @@ namespace astlib
  * - start of each round for repetitive items
  * - each decoded primite value
  * - end of record
+ * - abort of record, when decoding of started record failed
  */
 class ASTLIB_API ValueDecoder
 {
@@ -44,6 +47,14 @@ public:
     virtual void endRepetitive()
     {
     }
+    /// Record started by begin() is corrupted and won't be finished by end()
+    virtual void abort()
+    {
+    }
+    /// Capture or receive time of records decoded next
+    virtual void setTimestamp(const Poco::Timestamp& timestamp)
+    {
+    }
 };
 
 }
@@ -0,0 +1,176 @@
+///
+/// \package astlib
+/// \file BatchAsterixEncoder.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "BatchAsterixEncoder.h"
+#include "SimpleValueEncoder.h"
+#include "astlib/Exception.h"
+
+#include <Poco/Environment.h>
+#include <Poco/Runnable.h>
+#include <algorithm>
+#include <cstring>
+
+namespace astlib
+{
+
+/**
+ * Encodes one contiguous range of records into private scratch buffer (first phase)
+ * and copies it to its final position in shared output buffer (second phase).
+ */
+class BatchAsterixEncoder::Worker :
+    public Poco::Runnable
+{
+public:
+    Worker(CodecPolicy policy) :
+        encoder(policy)
+    {
+    }
+
+    void run()
+    {
+        try
+        {
+            if (copyPhase)
+                copy();
+            else
+                encode();
+        }
+        catch(Exception& e)
+        {
+            error = e.displayText();
+        }
+        catch(std::exception& e)
+        {
+            error = e.what();
+        }
+    }
+
+    void encode()
+    {
+        size_t position = 0;
+
+        offsets.clear();
+        for(size_t i = begin; i < end; i++)
+        {
+            if (scratch.size() < position + BinaryAsterixEncoder::MAX_PACKET_SIZE)
+                scratch.resize(2 * (position + BinaryAsterixEncoder::MAX_PACKET_SIZE));
+
+            SimpleValueEncoder valueEncoder((*records)[i]);
+            offsets.push_back(position);
+            position += encoder.encode(*codec, valueEncoder, scratch.data() + position, scratch.size() - position);
+        }
+        encodedSize = position;
+    }
+
+    void copy()
+    {
+        if (encodedSize)
+            memcpy(output->buffer.data() + outputOffset, scratch.data(), encodedSize);
+
+        for(size_t i = 0; i < offsets.size(); i++)
+            output->offsets[begin + i] = outputOffset + offsets[i];
+    }
+
+    BinaryAsterixEncoder encoder;
+    const CodecDescription* codec = nullptr;
+    const std::vector<SimpleAsterixRecordPtr>* records = nullptr;
+    Result* output = nullptr;
+    size_t begin = 0;
+    size_t end = 0;
+    size_t encodedSize = 0;
+    size_t outputOffset = 0;
+    bool copyPhase = false;
+    std::vector<Byte> scratch;
+    std::vector<size_t> offsets;
+    std::string error;
+};
+
+BatchAsterixEncoder::BatchAsterixEncoder(CodecPolicy policy, int threads) :
+    _policy(policy),
+    _pool(1, threads > 0 ? threads : std::max(1, int(Poco::Environment::processorCount())))
+{
+    int count = _pool.capacity();
+    for(int i = 0; i < count; i++)
+    {
+        _workers.emplace_back(new Worker(policy));
+    }
+}
+
+BatchAsterixEncoder::~BatchAsterixEncoder()
+{
+    _pool.joinAll();
+}
+
+int BatchAsterixEncoder::getThreadCount() const
+{
+    return int(_workers.size());
+}
+
+void BatchAsterixEncoder::encode(const CodecDescription& codec, const std::vector<SimpleAsterixRecordPtr>& records, Result& result)
+{
+    size_t count = records.size();
+    size_t workerCount = std::min(_workers.size(), count);
+
+    result.offsets.resize(count + 1);
+    result.offsets[0] = 0;
+    if (count == 0)
+    {
+        result.buffer.clear();
+        return;
+    }
+
+    // Contiguous ranges keep output order without any synchronization between workers
+    size_t chunk = (count + workerCount - 1) / workerCount;
+    for(size_t i = 0; i < workerCount; i++)
+    {
+        Worker& worker = *_workers[i];
+        worker.codec = &codec;
+        worker.records = &records;
+        worker.output = &result;
+        worker.begin = std::min(count, i * chunk);
+        worker.end = std::min(count, worker.begin + chunk);
+        worker.encodedSize = 0;
+        worker.copyPhase = false;
+        worker.error.clear();
+    }
+
+    runPhase(workerCount);
+
+    size_t total = 0;
+    for(size_t i = 0; i < workerCount; i++)
+    {
+        Worker& worker = *_workers[i];
+        if (!worker.error.empty())
+            throw Exception("BatchAsterixEncoder::encode(): " + worker.error);
+
+        worker.outputOffset = total;
+        worker.copyPhase = true;
+        total += worker.encodedSize;
+    }
+
+    result.buffer.resize(total);
+    result.offsets[count] = total;
+
+    runPhase(workerCount);
+}
+
+void BatchAsterixEncoder::runPhase(size_t workerCount)
+{
+    // Calling thread takes the first range itself
+    for(size_t i = 1; i < workerCount; i++)
+    {
+        _pool.start(*_workers[i]);
+    }
+    _workers[0]->run();
+    _pool.joinAll();
+}
+
+} /* namespace astlib */
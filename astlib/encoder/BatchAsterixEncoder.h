@@ -0,0 +1,72 @@
+///
+/// \package astlib
+/// \file BatchAsterixEncoder.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "BinaryAsterixEncoder.h"
+#include "astlib/SimpleAsterixRecord.h"
+
+#include <Poco/ThreadPool.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace astlib
+{
+
+/**
+ * Encodes batches of records in parallel on own thread pool.
+ * Every record is encoded as standalone data block, all blocks are stored in one
+ * contiguous output buffer in the same order as input records.
+ */
+class ASTLIB_API BatchAsterixEncoder
+{
+public:
+    /**
+     * Encoded batch, record i occupies bytes <offsets[i], offsets[i+1]) of buffer.
+     * Object can be reused between batches, its memory is recycled.
+     */
+    struct Result
+    {
+        std::vector<Byte> buffer;
+        std::vector<size_t> offsets;
+
+        size_t size() const { return offsets.empty() ? 0 : offsets.size()-1; }
+        const Byte* data(size_t index) const { return buffer.data() + offsets[index]; }
+        size_t length(size_t index) const { return offsets[index+1] - offsets[index]; }
+    };
+
+    /**
+     * @param policy policy for all internal encoders
+     * @param threads worker count, zero means one worker per processor
+     */
+    BatchAsterixEncoder(CodecPolicy policy = CodecPolicy(), int threads = 0);
+    ~BatchAsterixEncoder();
+
+    /**
+     * Encodes all records with codec, blocks until whole batch is done.
+     * If any record fails, Exception of first failed record (in input order) is thrown.
+     */
+    void encode(const CodecDescription& codec, const std::vector<SimpleAsterixRecordPtr>& records, Result& result);
+
+    int getThreadCount() const;
+
+private:
+    class Worker;
+
+    void runPhase(size_t workerCount);
+
+    CodecPolicy _policy;
+    Poco::ThreadPool _pool;
+    std::vector<std::unique_ptr<Worker>> _workers;
+};
+
+} /* namespace astlib */
@@ -36,9 +36,74 @@ BinaryAsterixEncoder::~BinaryAsterixEncoder()
 }
 
 size_t BinaryAsterixEncoder::encode(const CodecDescription& codec, ValueEncoder& valueEncoder, std::vector<Byte>& buffer, const std::string& uap)
+{
+    Byte* aux = scratch(_payload, MAX_PACKET_SIZE);
+    std::vector<Byte> reducedFspec;
+    size_t encodedSize = encodeRecord(codec, valueEncoder, reducedFspec, aux);
+
+    size_t len = 1 + 2 + reducedFspec.size() + encodedSize;
+    buffer.resize(len);
+    writeDataBlock(codec, reducedFspec, aux, encodedSize, buffer.data());
+    return len;
+}
+
+size_t BinaryAsterixEncoder::encode(const CodecDescription& codec, ValueEncoder& valueEncoder, Byte buffer[], size_t capacity, const std::string& uap)
+{
+    Byte* aux = scratch(_payload, MAX_PACKET_SIZE);
+    std::vector<Byte> reducedFspec;
+    size_t encodedSize = encodeRecord(codec, valueEncoder, reducedFspec, aux);
+
+    size_t len = 1 + 2 + reducedFspec.size() + encodedSize;
+    if (len > capacity)
+        throw Exception("BinaryAsterixEncoder::encode(): buffer too small, record needs " + std::to_string(len) + " bytes");
+
+    writeDataBlock(codec, reducedFspec, aux, encodedSize, buffer);
+    return len;
+}
+
+size_t BinaryAsterixEncoder::appendRecord(const CodecDescription& codec, ValueEncoder& valueEncoder, std::vector<Byte>& block)
+{
+    Byte* aux = scratch(_payload, MAX_PACKET_SIZE);
+    std::vector<Byte> reducedFspec;
+    size_t encodedSize = encodeRecord(codec, valueEncoder, reducedFspec, aux);
+
+    if (block.empty())
+    {
+        block.push_back(Byte(codec.getCategoryDescription().getCategory()));
+        block.push_back(0);
+        block.push_back(3);
+    }
+
+    size_t recordSize = reducedFspec.size() + encodedSize;
+    if (recordSize == 0)
+        return 0;
+
+    size_t len = block.size() + recordSize;
+    if (len > MAX_PACKET_SIZE)
+        throw Exception("BinaryAsterixEncoder::appendRecord(): data block would exceed " + std::to_string(MAX_PACKET_SIZE) + " bytes");
+
+    size_t offset = block.size();
+    block.resize(len);
+    if (reducedFspec.size())
+        memcpy(&block[offset], reducedFspec.data(), reducedFspec.size());
+    writePayload(aux, encodedSize, &block[offset + reducedFspec.size()]);
+    block[1] = (len >> 8) & 0xFF;
+    block[2] = len & 0xFF;
+
+    return recordSize;
+}
+
+Byte* BinaryAsterixEncoder::scratch(std::vector<Byte>& buffer, size_t size)
+{
+    // Allocated once per encoder, large arrays would overflow stacks of pool threads
+    if (buffer.size() < size)
+        buffer.resize(size);
+    return buffer.data();
+}
+
+size_t BinaryAsterixEncoder::encodeRecord(const CodecDescription& codec, ValueEncoder& valueEncoder, std::vector<Byte>& reducedFspec, Byte payload[])
 {
     FspecGenerator fspec;
-    Byte aux[MAX_PACKET_SIZE];
 
     if (_policy.verbose)
     {
@@ -46,9 +111,9 @@ size_t BinaryAsterixEncoder::encode(const CodecDescription& codec, ValueEncoder&
     }
 
     const CodecDescription::UapItems& uapItems = codec.enumerateUapItems();
-    size_t encodedSize = encodePayload(codec, valueEncoder, uapItems, fspec, aux);
+    size_t encodedSize = encodePayload(codec, valueEncoder, uapItems, fspec, payload);
 
-    auto reducedFspec = fspec.getArray();
+    reducedFspec = fspec.getArray();
     if (_policy.verbose)
     {
         std::cout << "Encoded FSPEC: ";
@@ -56,8 +121,13 @@ size_t BinaryAsterixEncoder::encode(const CodecDescription& codec, ValueEncoder&
         std::cout << std::endl;
     }
 
+    return encodedSize;
+}
+
+void BinaryAsterixEncoder::writeDataBlock(const CodecDescription& codec, const std::vector<Byte>& reducedFspec, const Byte payload[], size_t encodedSize, Byte buffer[])
+{
     size_t len = 1 + 2 + reducedFspec.size() + encodedSize;
-    buffer.resize(len);
+
     buffer[0] = codec.getCategoryDescription().getCategory();
     // TODO: pre littleendian treba zvlast vetvu
     buffer[1] = (len >> 8) & 0xFF;
@@ -65,16 +135,38 @@ size_t BinaryAsterixEncoder::encode(const CodecDescription& codec, ValueEncoder&
     if (reducedFspec.size())
     {
         memcpy(&buffer[3], reducedFspec.data(), reducedFspec.size());
-        memcpy(&buffer[3 + reducedFspec.size()], aux, encodedSize);
+        writePayload(payload, encodedSize, &buffer[3 + reducedFspec.size()]);
     }
-    return len;
+}
+
+void BinaryAsterixEncoder::writePayload(const Byte payload[], size_t encodedSize, Byte buffer[]) const
+{
+    // Interleave encoded items from payload with items supplied already encoded
+    size_t position = 0;
+
+    for(const EncodedItem& item: _encodedItems)
+    {
+        memcpy(buffer, payload + position, item.position - position);
+        buffer += item.position - position;
+        encodedSize -= item.position - position;
+        position = item.position;
+
+        memcpy(buffer, item.data, item.length);
+        buffer += item.length;
+        encodedSize -= item.length;
+    }
+
+    memcpy(buffer, payload + position, encodedSize);
 }
 
 size_t BinaryAsterixEncoder::encodePayload(const CodecDescription& codec, ValueEncoder& valueEncoder, const CodecDescription::UapItems& uapItems, FspecGenerator& fspec, Byte buffer[])
 {
     size_t bufferPosition = 0;
+    size_t encodedItemsSize = 0;
     int currentItem = -1;
 
+    _encodedItems.clear();
+
     for(const auto& entry: uapItems)
     {
         currentItem++;
@@ -91,28 +183,38 @@ size_t BinaryAsterixEncoder::encodePayload(const CodecDescription& codec, ValueE
         if (_policy.verbose)
             std::cout << " Encoding[" << currentItem << "] " << item.getType().toString() << " " << codec.getCategoryDescription().getCategory() << "/" << item.getId() << ": " << item.getDescription() << std::endl;
 
-        switch(item.getType().toValue())
+        if (const Byte* encodedItem = valueEncoder.getEncodedItem(entry.first, item, len))
         {
-            case ItemFormat::Fixed:
-                len = encodeFixed(item, valueEncoder, uapItems, fspec, buffer + bufferPosition);
-                break;
-            case ItemFormat::Variable:
-                len = encodeVariable(item, valueEncoder, uapItems, fspec, buffer + bufferPosition);
-                break;
-            case ItemFormat::Repetitive:
-                len = encodeRepetitive(item, valueEncoder, uapItems, fspec, buffer + bufferPosition);
-                break;
-            case ItemFormat::Compound:
-                len = encodeCompound(item, valueEncoder, uapItems, fspec, buffer + bufferPosition);
-                break;
-            case ItemFormat::Explicit:
-                len = encodeExplicit(item, valueEncoder, uapItems, fspec, buffer + bufferPosition);
-                break;
+            // Copied straight to output by writePayload(), payload holds encoded items only
+            if (len > 0)
+                _encodedItems.push_back(EncodedItem{bufferPosition, encodedItem, len});
+            encodedItemsSize += len;
+        }
+        else
+        {
+            switch(item.getType().toValue())
+            {
+                case ItemFormat::Fixed:
+                    len = encodeFixed(item, valueEncoder, uapItems, fspec, buffer + bufferPosition);
+                    break;
+                case ItemFormat::Variable:
+                    len = encodeVariable(item, valueEncoder, uapItems, fspec, buffer + bufferPosition);
+                    break;
+                case ItemFormat::Repetitive:
+                    len = encodeRepetitive(item, valueEncoder, uapItems, fspec, buffer + bufferPosition);
+                    break;
+                case ItemFormat::Compound:
+                    len = encodeCompound(item, valueEncoder, uapItems, fspec, buffer + bufferPosition);
+                    break;
+                case ItemFormat::Explicit:
+                    len = encodeExplicit(item, valueEncoder, uapItems, fspec, buffer + bufferPosition);
+                    break;
+            }
+            bufferPosition += len;
         }
 
         if (len > 0)
         {
-            bufferPosition += len;
             fspec.addItem();
             if (_policy.verbose)
                 std::cout << "    encoded data length: " << len << "bytes" << std::endl;
@@ -123,7 +225,7 @@ size_t BinaryAsterixEncoder::encodePayload(const CodecDescription& codec, ValueE
         }
     }
 
-    return bufferPosition;
+    return bufferPosition + encodedItemsSize;
 }
 
 size_t BinaryAsterixEncoder::encodeFixed(const ItemDescription& item, ValueEncoder& valueEncoder, const CodecDescription::UapItems& uapItems, FspecGenerator& fspec, Byte buffer[])
@@ -215,7 +317,8 @@ size_t BinaryAsterixEncoder::encodeCompound(const ItemDescription& item, ValueEn
 {
     const CompoundItemDescription& compoundItem = static_cast<const CompoundItemDescription&>(item);
     const ItemDescriptionVector& items = compoundItem.getItemsVector();
-    Byte local[MAX_PACKET_SIZE/2];
+    // Sub items are never compound, so the scratch is not reused by nested calls
+    Byte* local = scratch(_compoundPayload, MAX_PACKET_SIZE/2);
     FspecGenerator localFspec;
     size_t allByteCount = 0;
 
@@ -335,14 +438,9 @@ size_t BinaryAsterixEncoder::encodeExplicit(const ItemDescription& item, ValueEn
 size_t BinaryAsterixEncoder::encodeBitset(const ItemDescription& item, const Fixed& fixed, ValueEncoder& valueEncoder, Byte buffer[], int index)
 {
     const BitsDescriptionArray& bitsDescriptions = fixed.bitsDescriptions;
-    Poco::UInt64 data = 0;
-    Poco::UInt64 data2 = 0;
-    Poco::UInt64 data3 = 0;
     bool encoded = false;
     int length = fixed.length;
 
-    poco_assert(length <= 24);
-
     for (const BitsDescription& bits : bitsDescriptions)
     {
         CodecContext context(item, _policy, bits, 0);
@@ -351,25 +449,17 @@ size_t BinaryAsterixEncoder::encodeBitset(const ItemDescription& item, const Fix
         if (valueEncoder.encode(context, value, index))
         {
             // TODO: obsluha rozsahu - treba detekovat pretecenie a nasledne bud hodit chybu alebo zalimitovat
-            encoded = true;
-            Poco::UInt64 mask = 0;
-            int leftShift = 0;
-
-            if (context.width == 1)
-            {
-                // Send non FX bits only
-                if (!bits.fx)
-                {
-                    mask = 1;
-                    leftShift = bits.bit-1;
-                }
-            }
-            else
+            if (!encoded)
             {
-                mask = bits.bitMask();
-                leftShift = bits.to-1;
+                memset(buffer, 0, length);
+                encoded = true;
             }
 
+            // FX bits have zero mask in plan, so they are never sent
+            Poco::UInt64 mask = context.plan.mask;
+            if (mask == 0)
+                continue;
+
             if (_policy.verbose)
             {
                 if (index == -1)
@@ -378,56 +468,18 @@ size_t BinaryAsterixEncoder::encodeBitset(const ItemDescription& item, const Fix
                     std::cout << "  " << bits.name << "[" << index << "] = " << (value&mask) << " (" << context.width << " bits)"<< std::endl;
             }
 
-            if (leftShift >= 63 && leftShift < 127)
-            {
-                data2 |= ((value & mask) << (64 - (128 - leftShift)));
-                // FIXME: prechod cez hranicu 8 bajtov
-                if ((leftShift + context.width) >= 128)
-                {
-                    data3 |= ((value & mask) >> (128 - leftShift));
-                }
-            }
-            else if (leftShift < 63)
-            {
-                data |= ((value & mask) << leftShift);
-                if ((leftShift + context.width) >= 64)
-                {
-                    data2 |= ((value & mask) >> (64 - leftShift));
-                }
-            }
-            else {
-               data3 |= ((value & mask) << (leftShift - 128));
-            }
+            ByteUtils::pokeBits(buffer, length, context.plan.shift, context.width, value);
         }
     }
 
     if (encoded)
     {
-        if (length <= 8)
-        {
-            ByteUtils::pokeBigEndian(buffer, data, length);
-        }
-        else if (length > 8 && length <= 16)
-        {
-            auto partialLen = length - 8;
-            ByteUtils::pokeBigEndian(buffer, data2, partialLen);
-            ByteUtils::pokeBigEndian(buffer + partialLen, data, 8);
-        }
-        else {
-            auto partialLen = length - 16;
-            ByteUtils::pokeBigEndian(buffer, data3, partialLen);
-            ByteUtils::pokeBigEndian(buffer + partialLen, data2, 8);
-            ByteUtils::pokeBigEndian(buffer + partialLen + 8, data, 8);
-        }
-
         if (_policy.verbose)
         {
-            if (length <= 8)
-                std::cout << "   " << Poco::NumberFormatter::formatHex(data, length*2) << std::endl;
-            else
-            {
-                std::cout << "   " << Poco::NumberFormatter::formatHex(data2, (length-8)*2) << ' ' << Poco::NumberFormatter::formatHex(data, 8*2) << std::endl;
-            }
+            std::cout << "  ";
+            for (int i = 0; i < length; i++)
+                std::cout << " " << Poco::NumberFormatter::formatHex(buffer[i], 2, false);
+            std::cout << std::endl;
         }
         return length;
     }
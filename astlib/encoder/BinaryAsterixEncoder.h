@@ -25,14 +25,31 @@ struct Fixed;
 class ASTLIB_API BinaryAsterixEncoder
 {
 public:
-    static constexpr int MAX_PACKET_SIZE = 8192;
+    static constexpr int MAX_PACKET_SIZE = 65535;   ///< full range of 16-bit LEN
 
     BinaryAsterixEncoder(CodecPolicy policy = CodecPolicy());
     ~BinaryAsterixEncoder();
 
     size_t encode(const CodecDescription& codec, ValueEncoder& valueEncoder, std::vector<Byte>& buffer, const std::string& uap = std::string());
 
+    /**
+     * Encodes one record as data block directly to caller's memory.
+     * @param buffer destination memory
+     * @param capacity size of the destination memory, Exception is thrown when encoded block doesn't fit
+     * @return size of encoded data block
+     */
+    size_t encode(const CodecDescription& codec, ValueEncoder& valueEncoder, Byte buffer[], size_t capacity, const std::string& uap = std::string());
+
+    /**
+     * Appends one record to data block in block and updates its LEN field.
+     * Empty block is initialized with CAT/LEN header first.
+     * @return size of appended record (FSPEC + items)
+     */
+    size_t appendRecord(const CodecDescription& codec, ValueEncoder& valueEncoder, std::vector<Byte>& block);
+
 private:
+    size_t encodeRecord(const CodecDescription& codec, ValueEncoder& valueEncoder, std::vector<Byte>& reducedFspec, Byte payload[]);
+    void writeDataBlock(const CodecDescription& codec, const std::vector<Byte>& reducedFspec, const Byte payload[], size_t encodedSize, Byte buffer[]);
     size_t encodePayload(const CodecDescription& codec, ValueEncoder& valueEncoder, const CodecDescription::UapItems& uapItems, FspecGenerator& fspec, Byte buffer[]);
     size_t encodeFixed(const ItemDescription& item, ValueEncoder& valueEncoder, const CodecDescription::UapItems& uapItems, FspecGenerator& fspec, Byte buffer[]);
     size_t encodeVariable(const ItemDescription& item, ValueEncoder& valueEncoder, const CodecDescription::UapItems& uapItems, FspecGenerator& fspec, Byte buffer[]);
@@ -40,8 +57,21 @@ private:
     size_t encodeCompound(const ItemDescription& item, ValueEncoder& valueEncoder, const CodecDescription::UapItems& uapItems, FspecGenerator& fspec, Byte buffer[]);
     size_t encodeExplicit(const ItemDescription& item, ValueEncoder& valueEncoder, const CodecDescription::UapItems& uapItems, FspecGenerator& fspec, Byte buffer[]);
     size_t encodeBitset(const ItemDescription& item, const Fixed& fixed, ValueEncoder& valueEncoder, Byte buffer[], int index);
+    void writePayload(const Byte payload[], size_t encodedSize, Byte buffer[]) const;
+    static Byte* scratch(std::vector<Byte>& buffer, size_t size);
+
+    /// Item supplied already encoded by ValueEncoder, copied to output directly instead of to payload
+    struct EncodedItem
+    {
+        size_t position;    ///< offset in payload where item belongs
+        const Byte* data;
+        size_t length;
+    };
 
     CodecPolicy _policy;
+    std::vector<EncodedItem> _encodedItems;
+    std::vector<Byte> _payload;            ///< items of encoded record
+    std::vector<Byte> _compoundPayload;    ///< sub items of compound item
 };
 
 } /* namespace astlib */
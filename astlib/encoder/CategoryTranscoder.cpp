@@ -0,0 +1,493 @@
+///
+/// \package astlib
+/// \file CategoryTranscoder.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "CategoryTranscoder.h"
+#include "astlib/model/FixedItemDescription.h"
+#include "astlib/model/VariableItemDescription.h"
+#include "astlib/model/RepetitiveItemDescription.h"
+#include "astlib/model/ExplicitItemDescription.h"
+#include "astlib/model/CompoundItemDescription.h"
+#include "astlib/Exception.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace astlib
+{
+
+/**
+ * Feeds BinaryAsterixEncoder from slots filled by source record scan.
+ */
+class CategoryTranscoder::SlotValueEncoder :
+    public ValueEncoder
+{
+public:
+    SlotValueEncoder(const CategoryTranscoder& transcoder) :
+        _transcoder(transcoder)
+    {
+    }
+
+    bool encode(const CodecContext& ctx, Poco::UInt64& value, int index)
+    {
+        auto iterator = _transcoder._targetSlots.find(&ctx.bits);
+        if (iterator == _transcoder._targetSlots.end())
+            return false;
+
+        const Slot& slot = _transcoder._slots[iterator->second];
+        if (!slot.present)
+            return false;
+
+        if (index < 0)
+        {
+            value = slot.array.empty() ? slot.value : slot.array.front();
+            return true;
+        }
+        if (size_t(index) < slot.array.size())
+        {
+            value = slot.array[index];
+            return true;
+        }
+        if (index == 0 && slot.array.empty())
+        {
+            value = slot.value;
+            return true;
+        }
+        return false;
+    }
+
+    const Byte* getEncodedItem(int frn, const ItemDescription& item, size_t& length)
+    {
+        if (size_t(frn) >= _transcoder._copySources.size() || _transcoder._copySources[frn] < 0)
+            return nullptr;
+
+        const ItemOffsetTable::Item* present = _transcoder._presentItems[_transcoder._copySources[frn]];
+        if (!present)
+        {
+            // Not present in source record, nothing to encode
+            length = 0;
+            return _empty;
+        }
+
+        length = present->length;
+        return _transcoder._record + present->offset;
+    }
+
+    size_t getArraySize(AsterixItemCode code) const
+    {
+        auto iterator = _transcoder._arraySlots.find(code.value);
+        if (iterator == _transcoder._arraySlots.end())
+            return 0;
+
+        const Slot& slot = _transcoder._slots[iterator->second];
+        if (!slot.present)
+            return 0;
+        return slot.array.empty() ? 1 : slot.array.size();
+    }
+
+private:
+    const CategoryTranscoder& _transcoder;
+    const Byte _empty[1] = {0};
+};
+
+template<typename Function>
+static void forEachBits(const ItemDescription& item, Function function)
+{
+    const FixedVector* fixedVector = nullptr;
+
+    switch(item.getType().toValue())
+    {
+        case ItemFormat::Fixed:
+            for(const BitsDescription& bits: static_cast<const FixedItemDescription&>(item).getFixed().bitsDescriptions)
+                function(bits);
+            return;
+        case ItemFormat::Variable:
+            fixedVector = &static_cast<const VariableItemDescription&>(item).getFixedVector();
+            break;
+        case ItemFormat::Repetitive:
+            fixedVector = &static_cast<const RepetitiveItemDescription&>(item).getFixedVector();
+            break;
+        case ItemFormat::Explicit:
+            fixedVector = &static_cast<const ExplicitItemDescription&>(item).getFixedVector();
+            break;
+        case ItemFormat::Compound:
+        {
+            const ItemDescriptionVector& items = static_cast<const CompoundItemDescription&>(item).getItemsVector();
+            // zero index is for Variable pseudo FSPEC
+            for(size_t i = 1; i < items.size(); i++)
+            {
+                if (items[i])
+                    forEachBits(*items[i], function);
+            }
+            return;
+        }
+    }
+
+    for(const Fixed& fixed: *fixedVector)
+    {
+        for(const BitsDescription& bits: fixed.bitsDescriptions)
+            function(bits);
+    }
+}
+
+static bool isValue(const BitsDescription& bits)
+{
+    return bits.code.isValid() && !bits.fx && bits.presence == 0;
+}
+
+CategoryTranscoder::CategoryTranscoder(CodecDescriptionPtr source, CodecDescriptionPtr target, CodecPolicy policy) :
+    _source(source),
+    _target(target),
+    _policy(policy),
+    _encoder(policy)
+{
+    poco_assert(_source && _target);
+}
+
+CategoryTranscoder::~CategoryTranscoder()
+{
+}
+
+void CategoryTranscoder::map(AsterixItemCode from, AsterixItemCode to)
+{
+    if (_compiled)
+        throw Exception("CategoryTranscoder::map(): mapping is already compiled");
+
+    _codeMap[from.value] = to.value;
+}
+
+size_t CategoryTranscoder::getMappingCount()
+{
+    if (!_compiled)
+        compile();
+
+    return _mappings.size();
+}
+
+size_t CategoryTranscoder::getCopiedItemCount()
+{
+    if (!_compiled)
+        compile();
+
+    return std::count_if(_copySources.begin(), _copySources.end(), [](int frn) { return frn >= 0; });
+}
+
+size_t CategoryTranscoder::transcode(const Byte buf[], size_t bytes, std::vector<Byte>& output)
+{
+    if (bytes < 4)
+        throw Exception("CategoryTranscoder::transcode(): too short data block");
+
+    if (buf[0] != _source->getCategoryDescription().getCategory())
+        throw Exception("CategoryTranscoder::transcode(): unexpected category " + std::to_string(buf[0]));
+
+    size_t size = (size_t(buf[1]) << 8) | buf[2];
+    if (size < 4 || size > bytes)
+        throw Exception("CategoryTranscoder::transcode(): bad size of data block " + std::to_string(size));
+
+    output.clear();
+
+    size_t count = 0;
+    for(size_t index = 3; index < size; count++)
+    {
+        index += transcodeRecord(buf + index, size - index, output);
+    }
+
+    return count;
+}
+
+size_t CategoryTranscoder::transcodeRecord(const Byte record[], size_t bytes, std::vector<Byte>& output)
+{
+    if (!_compiled)
+        compile();
+
+    for(size_t slot: _usedSlots)
+    {
+        _slots[slot].present = false;
+        _slots[slot].array.clear();
+    }
+    _usedSlots.clear();
+
+    size_t length = _table.scan(*_source, record, bytes);
+    _record = record;
+
+    std::fill(_presentItems.begin(), _presentItems.end(), nullptr);
+    for(const ItemOffsetTable::Item& present: _table.getItems())
+        _presentItems[present.frn] = &present;
+
+    for(const ItemOffsetTable::Part& part: _table.getParts())
+    {
+        const Byte* ptr = record + part.offset;
+        size_t partLength = part.fixed->length;
+
+        for(const BitsDescription& bits: part.fixed->bitsDescriptions)
+        {
+            auto iterator = _sourceMappings.find(&bits);
+            if (iterator == _sourceMappings.end())
+                continue;
+
+            const Mapping& mapping = _mappings[iterator->second];
+            Poco::UInt64 value = convert(mapping, ByteUtils::peekBits(ptr, partLength, mapping.sourceShift, mapping.sourceWidth));
+            Slot& slot = _slots[mapping.slot];
+
+            if (!slot.present)
+            {
+                slot.present = true;
+                _usedSlots.push_back(mapping.slot);
+            }
+
+            if (part.index < 0)
+                slot.value = value;
+            else
+            {
+                if (slot.array.size() <= size_t(part.index))
+                    slot.array.resize(part.index + 1);
+                slot.array[part.index] = value;
+            }
+        }
+    }
+
+    SlotValueEncoder valueEncoder(*this);
+    _encoder.appendRecord(*_target, valueEncoder, output);
+
+    return length;
+}
+
+void CategoryTranscoder::compile()
+{
+    // Target fields by code, first occurrence defines representation of the slot
+    std::unordered_map<Poco::UInt32, const BitsDescription*> targetBits;
+    std::unordered_map<Poco::UInt32, size_t> slots;
+    std::unordered_map<int, int> sourceFrns;
+
+    for(const auto& entry: _source->enumerateUapItems())
+    {
+        if (entry.second.item)
+            sourceFrns[entry.second.item->getId()] = entry.first;
+    }
+
+    const CodecDescription::UapItems& sourceUap = _source->enumerateUapItems();
+    const CodecDescription::UapItems& targetUap = _target->enumerateUapItems();
+    _presentItems.assign(sourceUap.empty() ? 0 : sourceUap.rbegin()->first + 1, nullptr);
+    _copySources.assign(targetUap.empty() ? 0 : targetUap.rbegin()->first + 1, -1);
+
+    for(const auto& entry: targetUap)
+    {
+        if (!entry.second.item)
+            continue;
+
+        const ItemDescription& item = *entry.second.item;
+        auto source = sourceFrns.find(item.getId());
+        if (source != sourceFrns.end() && sameLayout(*sourceUap.at(source->second).item, item))
+        {
+            _copySources[entry.first] = source->second;
+            continue;
+        }
+
+        forEachBits(item, [&](const BitsDescription& bits) {
+            if (isValue(bits))
+                targetBits.emplace(bits.code.value, &bits);
+        });
+    }
+
+    for(const auto& entry: _source->enumerateUapItems())
+    {
+        if (!entry.second.item)
+            continue;
+
+        forEachBits(*entry.second.item, [&](const BitsDescription& bits) {
+            if (!isValue(bits))
+                return;
+
+            auto mapped = _codeMap.find(bits.code.value);
+            Poco::UInt32 code = (mapped != _codeMap.end()) ? mapped->second : bits.code.value;
+            auto target = targetBits.find(code);
+            if (target == targetBits.end())
+                return;
+
+            Mapping mapping;
+            if (!compileMapping(bits, *target->second, mapping))
+                return;
+
+            auto slot = slots.find(code);
+            if (slot == slots.end())
+            {
+                slot = slots.emplace(code, _slots.size()).first;
+                _slots.emplace_back();
+            }
+            mapping.slot = slot->second;
+
+            _sourceMappings[&bits] = _mappings.size();
+            _mappings.push_back(mapping);
+        });
+    }
+
+    // All re-encoded target occurrences of mapped codes read the same slot
+    for(const auto& entry: _target->enumerateUapItems())
+    {
+        if (!entry.second.item || _copySources[entry.first] >= 0)
+            continue;
+
+        forEachBits(*entry.second.item, [&](const BitsDescription& bits) {
+            auto slot = slots.find(bits.code.value);
+            if (isValue(bits) && slot != slots.end())
+            {
+                _targetSlots[&bits] = slot->second;
+                if (bits.code.isArray())
+                    _arraySlots[bits.code.value] = slot->second;
+            }
+        });
+    }
+
+    _compiled = true;
+}
+
+bool CategoryTranscoder::sameLayout(const ItemDescription& source, const ItemDescription& target)
+{
+    if (source.getType().toValue() != target.getType().toValue())
+        return false;
+
+    switch(source.getType().toValue())
+    {
+        case ItemFormat::Fixed:
+            return sameLayout(FixedVector{static_cast<const FixedItemDescription&>(source).getFixed()},
+                              FixedVector{static_cast<const FixedItemDescription&>(target).getFixed()});
+        case ItemFormat::Variable:
+            return sameLayout(static_cast<const VariableItemDescription&>(source).getFixedVector(),
+                              static_cast<const VariableItemDescription&>(target).getFixedVector());
+        case ItemFormat::Repetitive:
+            return sameLayout(static_cast<const RepetitiveItemDescription&>(source).getFixedVector(),
+                              static_cast<const RepetitiveItemDescription&>(target).getFixedVector());
+        case ItemFormat::Explicit:
+            return sameLayout(static_cast<const ExplicitItemDescription&>(source).getFixedVector(),
+                              static_cast<const ExplicitItemDescription&>(target).getFixedVector());
+        case ItemFormat::Compound:
+        {
+            const ItemDescriptionVector& sourceItems = static_cast<const CompoundItemDescription&>(source).getItemsVector();
+            const ItemDescriptionVector& targetItems = static_cast<const CompoundItemDescription&>(target).getItemsVector();
+
+            if (sourceItems.size() != targetItems.size())
+                return false;
+
+            for(size_t i = 0; i < sourceItems.size(); i++)
+            {
+                if (bool(sourceItems[i]) != bool(targetItems[i]))
+                    return false;
+                if (sourceItems[i] && !sameLayout(*sourceItems[i], *targetItems[i]))
+                    return false;
+            }
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool CategoryTranscoder::sameLayout(const FixedVector& source, const FixedVector& target)
+{
+    if (source.size() != target.size())
+        return false;
+
+    for(size_t i = 0; i < source.size(); i++)
+    {
+        const BitsDescriptionArray& sourceBits = source[i].bitsDescriptions;
+        const BitsDescriptionArray& targetBits = target[i].bitsDescriptions;
+
+        if (source[i].length != target[i].length || sourceBits.size() != targetBits.size())
+            return false;
+
+        for(size_t j = 0; j < sourceBits.size(); j++)
+        {
+            const BitsDescription& a = sourceBits[j];
+            const BitsDescription& b = targetBits[j];
+
+            if (a.code.value != b.code.value || a.bit != b.bit || a.from != b.from || a.to != b.to ||
+                a.fx != b.fx || a.presence != b.presence || a.scale != b.scale ||
+                a.units.toValue() != b.units.toValue() || a.encoding.toValue() != b.encoding.toValue())
+                return false;
+        }
+    }
+
+    return true;
+}
+
+bool CategoryTranscoder::compileMapping(const BitsDescription& source, const BitsDescription& target, Mapping& mapping) const
+{
+    const BitsPlan sourcePlan = source.plan.compiled ? source.plan : BitsPlan(source);
+    const BitsPlan targetPlan = target.plan.compiled ? target.plan : BitsPlan(target);
+
+    if (sourcePlan.width > 64 || targetPlan.width > 64)
+        return false;
+
+    mapping.sourceSigned = (sourcePlan.kind == BitsPlan::Real || sourcePlan.kind == BitsPlan::Integer);
+    mapping.sourceShift = sourcePlan.shift;
+    mapping.sourceWidth = sourcePlan.width;
+    mapping.factor = 1.0;
+
+    switch(sourcePlan.kind)
+    {
+        case BitsPlan::Real:
+        case BitsPlan::UnsignedReal:
+            if (targetPlan.kind != BitsPlan::Real && targetPlan.kind != BitsPlan::UnsignedReal)
+                return false;
+            // Unit normalized scales make e.g. FL to FT conversion a single multiplication
+            mapping.factor = sourcePlan.scale / targetPlan.scale;
+            if (mapping.factor == 1.0)
+                break;
+            mapping.conversion = Scaled;
+            return true;
+
+        case BitsPlan::Ascii:
+        case BitsPlan::SixBitsChar:
+        case BitsPlan::Hex:
+        case BitsPlan::Octal:
+            // Encoded strings/codes can't be resized
+            if (targetPlan.kind != sourcePlan.kind || targetPlan.width != sourcePlan.width)
+                return false;
+            mapping.conversion = Copy;
+            return true;
+
+        case BitsPlan::Boolean:
+        case BitsPlan::Integer:
+        case BitsPlan::Unsigned:
+            if (targetPlan.kind == BitsPlan::Ascii || targetPlan.kind == BitsPlan::SixBitsChar || targetPlan.kind == BitsPlan::Hex)
+                return false;
+            break;
+
+        case BitsPlan::None:
+            return false;
+    }
+
+    mapping.conversion = (mapping.sourceSigned && targetPlan.width != sourcePlan.width) ? Signed : Copy;
+    return true;
+}
+
+Poco::UInt64 CategoryTranscoder::convert(const Mapping& mapping, Poco::UInt64 raw) const
+{
+    switch(mapping.conversion)
+    {
+        case Copy:
+            return raw;
+
+        case Signed:
+            // Encoder masks value to target width, so two's complement survives narrowing
+            return Poco::UInt64(ByteUtils::toSigned(raw, mapping.sourceWidth));
+
+        case Scaled:
+        {
+            double value = mapping.sourceSigned ? double(ByteUtils::toSigned(raw, mapping.sourceWidth)) : double(raw);
+            value *= mapping.factor;
+            return Poco::UInt64(Poco::Int64(value + (value < 0.0 ? -0.5 : 0.5)));
+        }
+    }
+
+    return raw;
+}
+
+} /* namespace astlib */
@@ -0,0 +1,118 @@
+///
+/// \package astlib
+/// \file CategoryTranscoder.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "BinaryAsterixEncoder.h"
+#include "astlib/decoder/ItemOffsetTable.h"
+
+#include <unordered_map>
+#include <vector>
+
+namespace astlib
+{
+
+/**
+ * Converts encoded records of one category to another one (e.g. cat048 to cat062)
+ * without building intermediate SimpleAsterixRecord.
+ * Fields are paired by AsterixItemCode (or explicit mapping), pairing is compiled
+ * once to field-to-field plan with precomputed scale/unit conversion factors.
+ * Items with the same id and identical layout in both codecs are copied byte-for-byte.
+ */
+class ASTLIB_API CategoryTranscoder
+{
+public:
+    CategoryTranscoder(CodecDescriptionPtr source, CodecDescriptionPtr target, CodecPolicy policy = CodecPolicy());
+    ~CategoryTranscoder();
+
+    /**
+     * Maps source field to target field with different code, call before first transcode().
+     */
+    void map(AsterixItemCode from, AsterixItemCode to);
+
+    /**
+     * Transcodes all records in source data block to one target data block.
+     * @param buf source data block, first byte is category
+     * @param output target data block, previous content is replaced
+     * @return number of transcoded records
+     */
+    size_t transcode(const Byte buf[], size_t bytes, std::vector<Byte>& output);
+
+    /**
+     * Transcodes one record starting with FSPEC and appends it to target data block.
+     * @return size of source record
+     */
+    size_t transcodeRecord(const Byte record[], size_t bytes, std::vector<Byte>& output);
+
+    /**
+     * @return number of compiled field pairs
+     */
+    size_t getMappingCount();
+
+    /**
+     * @return number of target UAP items copied byte-for-byte from source
+     */
+    size_t getCopiedItemCount();
+
+private:
+    /// How raw source value is converted to target raw value
+    enum Conversion
+    {
+        Copy,           ///< same representation, raw bits are copied
+        Signed,         ///< sign extended copy to wider/narrower field
+        Scaled,         ///< arithmetic conversion with precomputed factor
+    };
+
+    struct Mapping
+    {
+        size_t slot;
+        Conversion conversion;
+        bool sourceSigned;
+        int sourceShift;
+        int sourceWidth;
+        double factor;
+    };
+
+    struct Slot
+    {
+        bool present = false;
+        Poco::UInt64 value = 0;
+        std::vector<Poco::UInt64> array;
+    };
+
+    class SlotValueEncoder;
+
+    static bool sameLayout(const ItemDescription& source, const ItemDescription& target);
+    static bool sameLayout(const FixedVector& source, const FixedVector& target);
+
+    void compile();
+    bool compileMapping(const BitsDescription& source, const BitsDescription& target, Mapping& mapping) const;
+    Poco::UInt64 convert(const Mapping& mapping, Poco::UInt64 raw) const;
+
+    CodecDescriptionPtr _source;
+    CodecDescriptionPtr _target;
+    CodecPolicy _policy;
+    BinaryAsterixEncoder _encoder;
+    ItemOffsetTable _table;
+    const Byte* _record = nullptr;
+    bool _compiled = false;
+    std::vector<int> _copySources;                              ///< source FRN copied to target FRN, -1 for re-encoded items
+    std::vector<const ItemOffsetTable::Item*> _presentItems;    ///< present items of current record by source FRN
+    std::unordered_map<Poco::UInt32, Poco::UInt32> _codeMap;
+    std::unordered_map<const BitsDescription*, size_t> _sourceMappings;
+    std::unordered_map<const BitsDescription*, size_t> _targetSlots;
+    std::unordered_map<Poco::UInt32, size_t> _arraySlots;
+    std::vector<Mapping> _mappings;
+    std::vector<Slot> _slots;
+    std::vector<size_t> _usedSlots;
+};
+
+} /* namespace astlib */
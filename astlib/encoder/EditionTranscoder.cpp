@@ -0,0 +1,29 @@
+///
+/// \package astlib
+/// \file EditionTranscoder.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "EditionTranscoder.h"
+#include "astlib/Exception.h"
+
+namespace astlib
+{
+
+EditionTranscoder::EditionTranscoder(CodecDescriptionPtr source, CodecDescriptionPtr target, CodecPolicy policy) :
+    CategoryTranscoder(source, target, policy)
+{
+    if (source->getCategoryDescription().getCategory() != target->getCategoryDescription().getCategory())
+        throw Exception("EditionTranscoder: " + source->getCategoryDescription().toString() + " and " + target->getCategoryDescription().toString() + " are different categories");
+}
+
+EditionTranscoder::~EditionTranscoder()
+{
+}
+
+} /* namespace astlib */
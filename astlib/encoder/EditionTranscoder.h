@@ -0,0 +1,35 @@
+///
+/// \package astlib
+/// \file EditionTranscoder.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "CategoryTranscoder.h"
+
+namespace astlib
+{
+
+/**
+ * Upgrades/downgrades records between two editions of the same category
+ * (e.g. cat048 1.14 to 1.21). Editions are diffed once, unchanged items are
+ * copied byte-for-byte and only items with changed layout are re-encoded.
+ */
+class ASTLIB_API EditionTranscoder :
+    public CategoryTranscoder
+{
+public:
+    /**
+     * Throws Exception when codecs describe different categories.
+     */
+    EditionTranscoder(CodecDescriptionPtr source, CodecDescriptionPtr target, CodecPolicy policy = CodecPolicy());
+    ~EditionTranscoder();
+};
+
+} /* namespace astlib */
@@ -0,0 +1,131 @@
+///
+/// \package astlib
+/// \file RecordPatcher.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "RecordPatcher.h"
+#include "Exception.h"
+
+#include <cmath>
+
+namespace astlib
+{
+
+RecordPatcher::RecordPatcher(CodecPolicy policy) :
+    _policy(policy)
+{
+}
+
+RecordPatcher::~RecordPatcher()
+{
+}
+
+void RecordPatcher::set(AsterixItemCode code, Poco::UInt64 value)
+{
+    _rules.push_back(Rule{code, Set, value, 0.0, 0.0});
+}
+
+void RecordPatcher::setReal(AsterixItemCode code, double value)
+{
+    _rules.push_back(Rule{code, SetReal, 0, value, 0.0});
+}
+
+void RecordPatcher::shift(AsterixItemCode code, double delta, double modulo)
+{
+    for(Rule& rule: _rules)
+    {
+        if (rule.operation == Shift && rule.code.value == code.value)
+        {
+            rule.real = delta;
+            rule.modulo = modulo;
+            return;
+        }
+    }
+    _rules.push_back(Rule{code, Shift, 0, delta, modulo});
+}
+
+void RecordPatcher::clear()
+{
+    _rules.clear();
+}
+
+size_t RecordPatcher::patch(const CodecDescription& codec, Byte buf[], size_t bytes)
+{
+    if (bytes < 4)
+        throw Exception("RecordPatcher::patch(): too short data block");
+
+    size_t size = (size_t(buf[1]) << 8) | buf[2];
+    if (size < 4 || size > bytes)
+        throw Exception("RecordPatcher::patch(): bad size of data block " + std::to_string(size));
+
+    size_t count = 0;
+    for(size_t index = 3; index < size; count++)
+    {
+        index += patchRecord(codec, buf + index, size - index);
+    }
+
+    return count;
+}
+
+size_t RecordPatcher::patchRecord(const CodecDescription& codec, Byte record[], size_t bytes)
+{
+    size_t length = _table.scan(codec, record, bytes);
+
+    for(const Rule& rule: _rules)
+    {
+        apply(rule, record);
+    }
+
+    return length;
+}
+
+void RecordPatcher::apply(const Rule& rule, Byte record[])
+{
+    _fields.clear();
+    _table.findFields(rule.code, _fields);
+
+    for(const ItemOffsetTable::Field& field: _fields)
+    {
+        const BitsDescription& bits = *field.bits;
+        const BitsPlan plan = bits.plan.compiled ? bits.plan : BitsPlan(bits);
+        Byte* ptr = record + field.part->offset;
+        size_t length = field.part->fixed->length;
+
+        if (plan.width > 64)
+            throw Exception("RecordPatcher: field " + bits.name + " is wider than 64 bits");
+
+        double scale = _policy.normalizeValues ? plan.scale : bits.scale;
+        Poco::UInt64 value = rule.value;
+
+        if (rule.operation != Set)
+        {
+            double real = rule.real;
+
+            if (rule.operation == Shift)
+            {
+                Poco::UInt64 raw = ByteUtils::peekBits(ptr, length, plan.shift, plan.width);
+                double current = (plan.kind == BitsPlan::Real) ? double(ByteUtils::toSigned(raw, plan.width)) : double(raw);
+                real = current * scale + rule.real;
+                if (rule.modulo > 0.0)
+                {
+                    real = std::fmod(real, rule.modulo);
+                    if (real < 0.0)
+                        real += rule.modulo;
+                }
+            }
+
+            real /= scale;
+            value = Poco::UInt64(Poco::Int64(real + (real < 0.0 ? -0.5 : 0.5)));
+        }
+
+        ByteUtils::pokeBits(ptr, length, plan.shift, plan.width, value);
+    }
+}
+
+} /* namespace astlib */
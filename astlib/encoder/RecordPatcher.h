@@ -0,0 +1,94 @@
+///
+/// \package astlib
+/// \file RecordPatcher.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "astlib/CodecPolicy.h"
+#include "astlib/decoder/ItemOffsetTable.h"
+
+#include <vector>
+
+namespace astlib
+{
+
+/**
+ * Overwrites fixed-width fields of already encoded records in place.
+ * Useful for retagging (SAC/SIC, time of day, track number ...) without full decode/encode round trip.
+ * Rules are applied to every occurrence of the field, absent fields are left untouched.
+ */
+class ASTLIB_API RecordPatcher
+{
+public:
+    RecordPatcher(CodecPolicy policy = CodecPolicy());
+    ~RecordPatcher();
+
+    /**
+     * Stores raw (unscaled) value to field with code.
+     */
+    void set(AsterixItemCode code, Poco::UInt64 value);
+
+    /**
+     * Stores real value to field with code, value is scaled like in TypedValueEncoder.
+     */
+    void setReal(AsterixItemCode code, double value);
+
+    /**
+     * Adds delta to real field, result is wrapped to <0, modulo) if modulo is positive
+     * (e.g. 86400 for time of day). Shifting the same field again only replaces
+     * its delta and modulo, so the delta may change with every data block.
+     */
+    void shift(AsterixItemCode code, double delta, double modulo = 0.0);
+
+    /**
+     * Removes all rules.
+     */
+    void clear();
+
+    /**
+     * Patches all records in data block, buffer starts with CAT byte.
+     * @return number of patched records
+     */
+    size_t patch(const CodecDescription& codec, Byte buf[], size_t bytes);
+
+    /**
+     * Patches one record starting with FSPEC.
+     * @return record length in bytes
+     */
+    size_t patchRecord(const CodecDescription& codec, Byte record[], size_t bytes);
+
+    const ItemOffsetTable& getOffsetTable() const { return _table; }
+
+private:
+    enum Operation
+    {
+        Set,
+        SetReal,
+        Shift
+    };
+
+    struct Rule
+    {
+        AsterixItemCode code;
+        Operation operation;
+        Poco::UInt64 value;
+        double real;
+        double modulo;
+    };
+
+    void apply(const Rule& rule, Byte record[]);
+
+    CodecPolicy _policy;
+    ItemOffsetTable _table;
+    std::vector<Rule> _rules;
+    std::vector<ItemOffsetTable::Field> _fields;
+};
+
+} /* namespace astlib */
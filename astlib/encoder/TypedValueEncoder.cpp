@@ -13,7 +13,6 @@
 #include "astlib/ByteUtils.h"
 #include "astlib/AsterixItemDictionary.h"
 #include "astlib/Exception.h"
-#include <Poco/NumberParser.h>
 #include <iostream>
 
 namespace astlib
@@ -46,12 +45,12 @@ bool TypedValueEncoder::encode(const CodecContext& ctx, Poco::UInt64& value, int
         throw Exception("TypedValueEncoder::encode: " + asterixCodeToSymbol(code) + " scalar value doesn't expects an index");
     }
 
-    Encoding::ValueType encoding = ctx.bits.encoding.toValue();
+    const BitsPlan& plan = ctx.plan;
     bool encoded = false;
 
-    switch(code.type())
+    switch(plan.kind)
     {
-        case PrimitiveType::Boolean:
+        case BitsPlan::Boolean:
         {
             bool boolean = false;
             encoded = encodeBoolean(ctx, boolean, index);
@@ -60,39 +59,23 @@ bool TypedValueEncoder::encode(const CodecContext& ctx, Poco::UInt64& value, int
             break;
         }
 
-        case PrimitiveType::Real:
+        case BitsPlan::Real:
+        case BitsPlan::UnsignedReal:
         {
             double real;
             encoded = encodeReal(ctx, real, index);
             if (encoded)
             {
                 if (ctx.policy.normalizeValues)
-                {
-                    double unit = 1.0;
-
-                    switch(ctx.bits.units.toValue())
-                    {
-                        case Units::FT:
-                            unit = 0.3048;
-                            break;
-                        case Units::NM:
-                            unit = 1852.0;
-                            break;
-                        case Units::FL:
-                            unit = 0.3048 * 100.0;
-                            break;
-                    }
-                    value = Poco::UInt64(real / (ctx.bits.scale * unit));
-                }
-                else
-                {
-                    value = Poco::UInt64(real);
-                }
+                    real *= plan.inverseScale;
+
+                // Round to nearest, so decoded values survive the roundtrip
+                value = Poco::UInt64(Poco::Int64(real + (real < 0.0 ? -0.5 : 0.5)));
             }
             break;
         }
 
-        case PrimitiveType::Integer:
+        case BitsPlan::Integer:
         {
             Poco::Int64 integer = 0;
             encoded = encodeSigned(ctx, integer, index);
@@ -101,72 +84,56 @@ bool TypedValueEncoder::encode(const CodecContext& ctx, Poco::UInt64& value, int
             break;
         }
 
-        case PrimitiveType::Unsigned:
+        case BitsPlan::Unsigned:
         {
             encoded = encodeUnsigned(ctx, value, index);
-            if (encoding == Encoding::Octal)
-                value = ByteUtils::dec2oct(value);
             break;
         }
 
-        default:
+        case BitsPlan::Octal:
         {
-            switch (encoding)
+            Poco::UInt64 aux = 0;
+            encoded = encodeUnsigned(ctx, aux, index);
+            if (encoded)
+                value = ByteUtils::dec2oct(aux);
+            break;
+        }
+
+        case BitsPlan::Ascii:
+        {
+            _string.clear();
+            encoded = encodeString(ctx, _string, index);
+            if (encoded)
             {
-                case Encoding::Ascii:
-                {
-                    std::string str;
-                    encoded = encodeString(ctx, str, index);
-                    if (encoded)
-                    {
-                        //std::reverse(str.begin(), str.end());
-                        for(Byte byte: str)
-                        {
-                            value <<= 8;
-                            value |= byte;
-                        }
-                    }
-                    break;
-                }
-                case Encoding::Octal:
-                {
-                    Poco::UInt64 aux = 0;
-                    encoded = encodeUnsigned(ctx, aux, index);
-                    if (encoded)
-                    {
-                        value = ByteUtils::dec2oct(aux);
-                    }
-                    break;
-                }
-                case Encoding::SixBitsChar:
+                for(Byte byte: _string)
                 {
-                    std::string str;
-                    encoded = encodeString(ctx, str, index);
-                    if (encoded)
-                    {
-                        std::string aux = ByteUtils::toSixBitString(str);
-                        std::reverse(aux.begin(), aux.end());
-                        for(Byte byte: aux)
-                        {
-                            value <<= 8;
-                            value |= byte;
-                        }
-                    }
-                    break;
-                }
-                case Encoding::Hex:
-                {
-                    std::string str;
-                    encoded = encodeString(ctx, str, index);
-                    if (encoded)
-                    {
-                        value = Poco::NumberParser::parseHex64(str);
-                    }
-                    break;
+                    value <<= 8;
+                    value |= byte;
                 }
             }
             break;
         }
+
+        case BitsPlan::SixBitsChar:
+        {
+            _string.clear();
+            encoded = encodeString(ctx, _string, index);
+            if (encoded)
+                value = ByteUtils::packSixBitString(_string);
+            break;
+        }
+
+        case BitsPlan::Hex:
+        {
+            _string.clear();
+            encoded = encodeString(ctx, _string, index);
+            if (encoded)
+                value = ByteUtils::parseHex(_string);
+            break;
+        }
+
+        case BitsPlan::None:
+            break;
     }
 
     return encoded;
@@ -29,6 +29,10 @@ public:
     virtual bool encodeUnsigned(const CodecContext& ctx, Poco::UInt64& value, int index) = 0;
     virtual bool encodeReal(const CodecContext& ctx, double& value, int index) = 0;
     virtual bool encodeString(const CodecContext& ctx, std::string& value, int index) = 0;
+
+private:
+    /// Reused storage for string items, keeps its capacity between encoded fields
+    std::string _string;
 };
 
 } /* namespace astlib */
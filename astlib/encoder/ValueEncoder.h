@@ -12,6 +12,7 @@
 #pragma once
 
 #include "astlib/CodecContext.h"
+#include "astlib/ByteUtils.h"
 
 
 namespace astlib
@@ -26,6 +27,13 @@ public:
 
     /// When encoding repetitive items, this method is used to return size of vector items
     virtual size_t getArraySize(AsterixItemCode code) const = 0;
+
+    /// Supplies already encoded bytes of whole UAP item at FSPEC bit frn (e.g. item copied by transcoder).
+    /// Returns nullptr when item has to be encoded field by field, bytes must stay valid until record is written.
+    virtual const Byte* getEncodedItem(int frn, const ItemDescription& item, size_t& length)
+    {
+        return nullptr;
+    }
 };
 
 } /* namespace astlib */
@@ -0,0 +1,273 @@
+///
+/// \package astlib
+/// \file CborReader.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "CborReader.h"
+#include "astlib/Exception.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
+
+namespace astlib
+{
+
+namespace
+{
+
+Poco::UInt64 readBigEndian(const Byte* data, int bytes)
+{
+    Poco::UInt64 value = 0;
+    for(int i = 0; i < bytes; i++)
+        value = (value << 8) | data[i];
+    return value;
+}
+
+double halfToDouble(unsigned half)
+{
+    unsigned exponent = (half >> 10) & 0x1F;
+    unsigned mantissa = half & 0x3FF;
+    double value;
+    if (exponent == 0)
+        value = std::ldexp(mantissa, -24);
+    else if (exponent != 31)
+        value = std::ldexp(mantissa + 1024, int(exponent) - 25);
+    else
+        value = mantissa == 0 ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+    return (half & 0x8000) ? -value : value;
+}
+
+}
+
+CborReader::CborReader(const void* data, size_t size) :
+    _begin(static_cast<const Byte*>(data)),
+    _ptr(_begin),
+    _end(_begin + size)
+{
+}
+
+CborReader::Type CborReader::peek() const
+{
+    if (_ptr == _end)
+        fail("peek", "unexpected end");
+
+    Byte initial = *_ptr;
+    switch(initial >> 5)
+    {
+    case 0: return Unsigned;
+    case 1: return Negative;
+    case 2: return Bytes;
+    case 3: return Text;
+    case 4: return Array;
+    case 5: return Map;
+    case 7:
+        switch(initial & 0x1F)
+        {
+        case 20:
+        case 21:
+            return Boolean;
+        case 22:
+            return Null;
+        case 25:
+        case 26:
+        case 27:
+            return Real;
+        }
+        break;
+    }
+    fail("peek", "unsupported item");
+}
+
+bool CborReader::atEnd() const
+{
+    return _ptr == _end;
+}
+
+Poco::UInt64 CborReader::readUnsigned()
+{
+    return readHead(0);
+}
+
+Poco::Int64 CborReader::readSigned()
+{
+    // Out of range item is left unread, offset of error points to it
+    const Byte* start = _ptr;
+    bool negative = peek() == Negative;
+    Poco::UInt64 argument = readHead(negative ? 1 : 0);
+    if (argument > Poco::UInt64(std::numeric_limits<Poco::Int64>::max()))
+    {
+        _ptr = start;
+        fail("readSigned", "integer out of range");
+    }
+    return negative ? -1 - Poco::Int64(argument) : Poco::Int64(argument);
+}
+
+double CborReader::readReal()
+{
+    switch(peek())
+    {
+    case Unsigned:
+        return double(readHead(0));
+    case Negative:
+        return -1.0 - double(readHead(1));
+    case Real:
+        break;
+    default:
+        fail("readReal", "not a number");
+    }
+
+    Byte initial = *_ptr++;
+    switch(initial & 0x1F)
+    {
+    case 25:
+        return halfToDouble(unsigned(readBigEndian(take(2), 2)));
+    case 26:
+    {
+        Poco::UInt32 bits = Poco::UInt32(readBigEndian(take(4), 4));
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    default:
+    {
+        Poco::UInt64 bits = readBigEndian(take(8), 8);
+        double value;
+        std::memcpy(&value, &bits, sizeof(value));
+        return value;
+    }
+    }
+}
+
+bool CborReader::readBoolean()
+{
+    if (peek() != Boolean)
+        fail("readBoolean", "not a boolean");
+    return *_ptr++ == 0xF5;
+}
+
+void CborReader::readNull()
+{
+    if (peek() != Null)
+        fail("readNull", "not a null");
+    _ptr++;
+}
+
+const char* CborReader::readText(size_t& size)
+{
+    Poco::UInt64 length = readHead(3);
+    size = size_t(length);
+    return reinterpret_cast<const char*>(take(length));
+}
+
+const Byte* CborReader::readBytes(size_t& size)
+{
+    Poco::UInt64 length = readHead(2);
+    size = size_t(length);
+    return take(length);
+}
+
+size_t CborReader::readArray()
+{
+    Poco::UInt64 size = readHead(4);
+    // Every item has at least one byte, so the size is bounded by input
+    if (size > Poco::UInt64(_end - _ptr))
+        fail("readArray", "size exceeds input");
+    return size_t(size);
+}
+
+size_t CborReader::readMap()
+{
+    Poco::UInt64 size = readHead(5);
+    if (size > Poco::UInt64(_end - _ptr) / 2)
+        fail("readMap", "size exceeds input");
+    return size_t(size);
+}
+
+void CborReader::skip()
+{
+    // Number of items still to skip, containers add their items
+    Poco::UInt64 pending = 1;
+    while (pending--)
+    {
+        size_t size;
+        switch(peek())
+        {
+        case Unsigned:
+        case Negative:
+            readHead(*_ptr >> 5);
+            break;
+        case Bytes:
+            readBytes(size);
+            break;
+        case Text:
+            readText(size);
+            break;
+        case Array:
+            pending += readArray();
+            break;
+        case Map:
+            pending += 2 * Poco::UInt64(readMap());
+            break;
+        case Boolean:
+            readBoolean();
+            break;
+        case Null:
+            readNull();
+            break;
+        case Real:
+            readReal();
+            break;
+        }
+    }
+}
+
+size_t CborReader::getOffset() const
+{
+    return size_t(_ptr - _begin);
+}
+
+Poco::UInt64 CborReader::readHead(int expected)
+{
+    if (_ptr == _end)
+        fail("readHead", "unexpected end");
+    if ((*_ptr >> 5) != expected)
+        fail("readHead", "unexpected item type");
+
+    unsigned info = *_ptr & 0x1F;
+    _ptr++;
+    if (info < 24)
+        return info;
+    switch(info)
+    {
+    case 24: return readBigEndian(take(1), 1);
+    case 25: return readBigEndian(take(2), 2);
+    case 26: return readBigEndian(take(4), 4);
+    case 27: return readBigEndian(take(8), 8);
+    }
+    _ptr--;
+    fail("readHead", "indefinite length or reserved argument");
+}
+
+const Byte* CborReader::take(Poco::UInt64 size)
+{
+    if (size > Poco::UInt64(_end - _ptr))
+        fail("take", "unexpected end");
+    const Byte* data = _ptr;
+    _ptr += size;
+    return data;
+}
+
+void CborReader::fail(const char* method, const char* message) const
+{
+    throw Exception(std::string("CborReader::") + method + "(): " + message + " at offset " + std::to_string(_ptr - _begin));
+}
+
+} /* namespace astlib */
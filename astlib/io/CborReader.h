@@ -0,0 +1,94 @@
+///
+/// \package astlib
+/// \file CborReader.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "astlib/ByteUtils.h"
+
+#include <Poco/Types.h>
+
+#include <cstddef>
+
+namespace astlib
+{
+
+/**
+ * Pull parser of CBOR (RFC 8949) data items without copying input. Text and byte
+ * strings are returned as pointers into the input buffer, which must outlive them.
+ * Containers are read by their header followed by the given number of items.
+ * Indefinite lengths and tags are not supported, malformed input throws Exception.
+ */
+class ASTLIB_API CborReader
+{
+public:
+    enum Type {
+        Unsigned,
+        Negative,
+        Bytes,
+        Text,
+        Array,
+        Map,
+        Boolean,
+        Null,
+        Real
+    };
+
+    CborReader(const void* data, size_t size);
+
+    /// @return type of next item
+    Type peek() const;
+
+    /// @return true when whole input was read
+    bool atEnd() const;
+
+    Poco::UInt64 readUnsigned();
+
+    /// Reads unsigned or negative integer fitting into Int64
+    Poco::Int64 readSigned();
+
+    /// Reads half, single or double precision real, or integer
+    double readReal();
+
+    bool readBoolean();
+
+    void readNull();
+
+    /**
+     * @param size length in bytes
+     * @return UTF-8 text inside the input, not zero terminated
+     */
+    const char* readText(size_t& size);
+
+    const Byte* readBytes(size_t& size);
+
+    /// @return number of items
+    size_t readArray();
+
+    /// @return number of key/value pairs
+    size_t readMap();
+
+    /// Skips next item including nested items of containers
+    void skip();
+
+    /// @return position of next item
+    size_t getOffset() const;
+
+private:
+    Poco::UInt64 readHead(int expected);
+    const Byte* take(Poco::UInt64 size);
+    [[noreturn]] void fail(const char* method, const char* message) const;
+
+    const Byte* _begin;
+    const Byte* _ptr;
+    const Byte* _end;
+};
+
+} /* namespace astlib */
@@ -0,0 +1,190 @@
+///
+/// \package astlib
+/// \file CborWriter.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "CborWriter.h"
+
+#include <cfloat>
+#include <cmath>
+#include <cstring>
+
+namespace astlib
+{
+
+namespace
+{
+
+/// Big endian unsigned of given width
+void appendBigEndian(std::string& out, Poco::UInt64 value, int bytes)
+{
+    char data[8];
+    for(int i = bytes - 1; i >= 0; i--, value >>= 8)
+        data[i] = char(value & 0xFF);
+    out.append(data, bytes);
+}
+
+}
+
+void CborWriter::beginArray(size_t size)
+{
+    appendHead(_buffer, Array, size);
+}
+
+void CborWriter::beginMap(size_t size)
+{
+    appendHead(_buffer, Map, size);
+}
+
+void CborWriter::value(bool value)
+{
+    appendBoolean(_buffer, value);
+}
+
+void CborWriter::value(int value)
+{
+    appendNumber(_buffer, Poco::Int64(value));
+}
+
+void CborWriter::value(Poco::Int64 value)
+{
+    appendNumber(_buffer, value);
+}
+
+void CborWriter::value(Poco::UInt64 value)
+{
+    appendNumber(_buffer, value);
+}
+
+void CborWriter::value(double value)
+{
+    appendNumber(_buffer, value);
+}
+
+void CborWriter::value(const std::string& value)
+{
+    appendText(_buffer, value.data(), value.size());
+}
+
+void CborWriter::value(const char* text, size_t size)
+{
+    appendText(_buffer, text, size);
+}
+
+void CborWriter::null()
+{
+    appendNull(_buffer);
+}
+
+const std::string& CborWriter::getBuffer() const
+{
+    return _buffer;
+}
+
+std::string& CborWriter::getBuffer()
+{
+    return _buffer;
+}
+
+size_t CborWriter::size() const
+{
+    return _buffer.size();
+}
+
+void CborWriter::truncate(size_t size)
+{
+    if (size < _buffer.size())
+        _buffer.resize(size);
+}
+
+void CborWriter::clear()
+{
+    _buffer.clear();
+}
+
+void CborWriter::appendHead(std::string& out, MajorType type, Poco::UInt64 argument)
+{
+    char initial = char(type << 5);
+    if (argument < 24)
+    {
+        out += char(initial | argument);
+    }
+    else if (argument <= 0xFF)
+    {
+        out += char(initial | 24);
+        out += char(argument);
+    }
+    else if (argument <= 0xFFFF)
+    {
+        out += char(initial | 25);
+        appendBigEndian(out, argument, 2);
+    }
+    else if (argument <= 0xFFFFFFFF)
+    {
+        out += char(initial | 26);
+        appendBigEndian(out, argument, 4);
+    }
+    else
+    {
+        out += char(initial | 27);
+        appendBigEndian(out, argument, 8);
+    }
+}
+
+void CborWriter::appendNumber(std::string& out, Poco::Int64 value)
+{
+    // Negative integer n is encoded as -1 - n
+    if (value < 0)
+        appendHead(out, Negative, Poco::UInt64(-1 - value));
+    else
+        appendHead(out, Unsigned, Poco::UInt64(value));
+}
+
+void CborWriter::appendNumber(std::string& out, Poco::UInt64 value)
+{
+    appendHead(out, Unsigned, value);
+}
+
+void CborWriter::appendNumber(std::string& out, double value)
+{
+    // Conversion of doubles out of float range is undefined
+    float single = std::fabs(value) <= FLT_MAX || !std::isfinite(value) ? float(value) : 0.0f;
+    if (double(single) == value || value != value)
+    {
+        Poco::UInt32 bits;
+        std::memcpy(&bits, &single, sizeof(bits));
+        out += char(0xFA);
+        appendBigEndian(out, bits, 4);
+    }
+    else
+    {
+        Poco::UInt64 bits;
+        std::memcpy(&bits, &value, sizeof(bits));
+        out += char(0xFB);
+        appendBigEndian(out, bits, 8);
+    }
+}
+
+void CborWriter::appendBoolean(std::string& out, bool value)
+{
+    out += char(value ? 0xF5 : 0xF4);
+}
+
+void CborWriter::appendText(std::string& out, const char* text, size_t size)
+{
+    appendHead(out, Text, size);
+    out.append(text, size);
+}
+
+void CborWriter::appendNull(std::string& out)
+{
+    out += char(0xF6);
+}
+
+} /* namespace astlib */
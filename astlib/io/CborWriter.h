@@ -0,0 +1,79 @@
+///
+/// \package astlib
+/// \file CborWriter.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "astlib/ByteUtils.h"
+
+#include <Poco/Types.h>
+
+#include <string>
+
+namespace astlib
+{
+
+/**
+ * CBOR (RFC 8949) emitter appending into reusable byte buffer. Only definite
+ * lengths are written, so the caller passes sizes of arrays and maps in advance.
+ * Reals are written as float32 when exact, otherwise as float64.
+ */
+class ASTLIB_API CborWriter
+{
+public:
+    enum MajorType {
+        Unsigned = 0,
+        Negative = 1,
+        Bytes = 2,
+        Text = 3,
+        Array = 4,
+        Map = 5,
+        Tag = 6,
+        Simple = 7
+    };
+
+    void beginArray(size_t size);
+    /// @param size number of key/value pairs
+    void beginMap(size_t size);
+
+    void value(bool value);
+    void value(int value);
+    void value(Poco::Int64 value);
+    void value(Poco::UInt64 value);
+    void value(double value);
+    void value(const std::string& value);
+    void value(const char* text, size_t size);
+    void null();
+
+    /// Encoded data written so far
+    const std::string& getBuffer() const;
+    std::string& getBuffer();
+
+    size_t size() const;
+
+    /// Discards data after position, e.g. unfinished record
+    void truncate(size_t size);
+
+    void clear();
+
+    /// Initial byte with major type and argument in the shortest form
+    static void appendHead(std::string& out, MajorType type, Poco::UInt64 argument);
+    static void appendNumber(std::string& out, Poco::Int64 value);
+    static void appendNumber(std::string& out, Poco::UInt64 value);
+    static void appendNumber(std::string& out, double value);
+    static void appendBoolean(std::string& out, bool value);
+    static void appendText(std::string& out, const char* text, size_t size);
+    static void appendNull(std::string& out);
+
+private:
+    std::string _buffer;
+};
+
+} /* namespace astlib */
@@ -0,0 +1,278 @@
+///
+/// \package astlib
+/// \file FileWriter.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "FileWriter.h"
+#include "IoUring.h"
+#include "astlib/Exception.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(ASTLIB_HAS_IO_URING)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+namespace astlib
+{
+
+#if defined(ASTLIB_HAS_IO_URING)
+struct FileWriter::UringState
+{
+    UringState(unsigned entries) :
+        ring(entries)
+    {
+    }
+
+    ~UringState()
+    {
+        if (fd >= 0)
+            ::close(fd);
+    }
+
+    IoUring ring;
+    int fd = -1;
+    std::vector<Byte> memory;
+    size_t bufferSize = 0;
+    unsigned depth = 0;
+    std::vector<bool> busy;     ///< buffer is being written by kernel
+    unsigned current = 0;       ///< buffer filled by caller
+    size_t used = 0;
+    unsigned inFlight = 0;
+    Poco::UInt64 offset = 0;    ///< file offset of current buffer
+};
+#else
+struct FileWriter::UringState
+{
+};
+#endif
+
+FileWriter::FileWriter(const std::string& path, Backend backend, size_t bufferSize, unsigned depth) :
+    _path(path)
+{
+    bufferSize = std::max<size_t>(bufferSize, 4096);
+
+#if defined(ASTLIB_HAS_IO_URING)
+    if (backend == Uring)
+    {
+        try
+        {
+            depth = std::max(2u, depth);
+            _uring.reset(new UringState(depth * 2));
+            UringState& state = *_uring;
+            state.bufferSize = bufferSize;
+            state.depth = depth;
+            state.memory.resize(bufferSize * depth);
+            state.busy.resize(depth, false);
+
+            std::vector<iovec> vectors(depth);
+            for(unsigned i = 0; i < depth; i++)
+            {
+                vectors[i].iov_base = state.memory.data() + i * bufferSize;
+                vectors[i].iov_len = bufferSize;
+            }
+            if (!state.ring.registerBuffers(vectors.data(), depth))
+                _uring.reset();
+        }
+        catch(Exception&)
+        {
+            // No io_uring in kernel, stream is used
+            _uring.reset();
+        }
+    }
+
+    if (_uring)
+    {
+        _uring->fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (_uring->fd < 0)
+            throw Exception("FileWriter::FileWriter(): cannot create " + path + ": " + strerror(errno));
+        _open = true;
+        return;
+    }
+#endif
+
+    _streamBuffer.resize(bufferSize);
+    _stream.rdbuf()->pubsetbuf(_streamBuffer.data(), std::streamsize(_streamBuffer.size()));
+    _stream.open(path, std::ios::binary | std::ios::trunc);
+    if (!_stream)
+        throw Exception("FileWriter::FileWriter(): cannot create " + path);
+    _open = true;
+}
+
+FileWriter::~FileWriter()
+{
+    try
+    {
+        close();
+    }
+    catch(Exception&)
+    {
+    }
+}
+
+void FileWriter::write(const void* data, size_t bytes)
+{
+    if (!_open)
+        throw Exception("FileWriter::write(): file " + _path + " is closed");
+    _size += bytes;
+
+#if defined(ASTLIB_HAS_IO_URING)
+    if (_uring)
+    {
+        UringState& state = *_uring;
+        const Byte* ptr = static_cast<const Byte*>(data);
+
+        while (bytes > 0)
+        {
+            size_t chunk = std::min(bytes, state.bufferSize - state.used);
+            memcpy(state.memory.data() + state.current * state.bufferSize + state.used, ptr, chunk);
+            state.used += chunk;
+            ptr += chunk;
+            bytes -= chunk;
+
+            if (state.used == state.bufferSize)
+                submitBuffer();
+        }
+        return;
+    }
+#endif
+
+    _stream.write(static_cast<const char*>(data), std::streamsize(bytes));
+    if (!_stream)
+        throw Exception("FileWriter::write(): cannot write " + _path);
+}
+
+void FileWriter::write(const std::string& text)
+{
+    write(text.data(), text.size());
+}
+
+void FileWriter::flush()
+{
+    if (!_open)
+        return;
+
+#if defined(ASTLIB_HAS_IO_URING)
+    if (_uring)
+    {
+        if (_uring->used)
+            submitBuffer();
+        while (_uring->inFlight)
+            complete(true);
+        return;
+    }
+#endif
+
+    _stream.flush();
+    if (!_stream)
+        throw Exception("FileWriter::flush(): cannot write " + _path);
+}
+
+void FileWriter::close()
+{
+    if (!_open)
+        return;
+
+    flush();
+    _open = false;
+
+#if defined(ASTLIB_HAS_IO_URING)
+    if (_uring)
+    {
+        ::close(_uring->fd);
+        _uring->fd = -1;
+        return;
+    }
+#endif
+
+    _stream.close();
+}
+
+FileWriter::Backend FileWriter::getBackend() const
+{
+    return _uring ? Uring : Stream;
+}
+
+Poco::UInt64 FileWriter::getSize() const
+{
+    return _size;
+}
+
+void FileWriter::submitBuffer()
+{
+#if defined(ASTLIB_HAS_IO_URING)
+    UringState& state = *_uring;
+
+    io_uring_sqe* sqe = state.ring.getSqe();
+    while (!sqe)
+    {
+        complete(true);
+        sqe = state.ring.getSqe();
+    }
+
+    sqe->opcode = IORING_OP_WRITE_FIXED;
+    sqe->fd = state.fd;
+    sqe->addr = reinterpret_cast<Poco::UInt64>(state.memory.data() + state.current * state.bufferSize);
+    sqe->len = Poco::UInt32(state.used);
+    sqe->off = state.offset;
+    sqe->buf_index = Poco::UInt16(state.current);
+    sqe->user_data = (Poco::UInt64(state.used) << 32) | state.current;
+
+    int result = state.ring.submit();
+    if (result < 0)
+        throw Exception("FileWriter::submitBuffer(): io_uring_enter failed: " + std::string(strerror(-result)));
+
+    state.busy[state.current] = true;
+    state.inFlight++;
+    state.offset += state.used;
+    state.used = 0;
+    state.current = (state.current + 1) % state.depth;
+
+    // Next buffer is free when its previous write completed
+    complete(false);
+    while (state.busy[state.current])
+        complete(true);
+#endif
+}
+
+void FileWriter::complete(bool wait)
+{
+#if defined(ASTLIB_HAS_IO_URING)
+    UringState& state = *_uring;
+
+    if (wait && !state.ring.peek())
+    {
+        int result = state.ring.submit(1);
+        if (result < 0 && result != -EINTR)
+            throw Exception("FileWriter::complete(): io_uring_enter failed: " + std::string(strerror(-result)));
+    }
+
+    while (io_uring_cqe* cqe = state.ring.peek())
+    {
+        unsigned buffer = unsigned(cqe->user_data & 0xFFFFFFFF);
+        size_t length = size_t(cqe->user_data >> 32);
+        int result = cqe->res;
+        state.ring.seen();
+
+        state.busy[buffer] = false;
+        state.inFlight--;
+
+        // Regular files are written completely unless the disk is full
+        if (result < 0)
+            throw Exception("FileWriter::complete(): cannot write " + _path + ": " + strerror(-result));
+        if (size_t(result) != length)
+            throw Exception("FileWriter::complete(): short write to " + _path);
+    }
+#endif
+}
+
+} /* namespace astlib */
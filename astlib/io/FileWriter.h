@@ -0,0 +1,80 @@
+///
+/// \package astlib
+/// \file FileWriter.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "astlib/ByteUtils.h"
+
+#include <Poco/Types.h>
+
+#include <fstream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace astlib
+{
+
+/**
+ * Buffered sequential file writer. Stream backend is a plain buffered ofstream,
+ * Uring backend writes full buffers asynchronously from registered buffers,
+ * so the caller fills next buffer while previous ones are written.
+ */
+class ASTLIB_API FileWriter
+{
+public:
+    enum Backend {
+        Stream,     ///< std::ofstream
+        Uring       ///< io_uring WRITE_FIXED (Linux), falls back to Stream when unavailable
+    };
+
+    /**
+     * Creates or truncates file, throws Exception on failure.
+     * @param bufferSize size of one buffer
+     * @param depth number of buffers in flight for Uring backend
+     */
+    FileWriter(const std::string& path, Backend backend = Stream, size_t bufferSize = 1 << 20, unsigned depth = 4);
+    ~FileWriter();
+
+    void write(const void* data, size_t bytes);
+
+    void write(const std::string& text);
+
+    /**
+     * Writes buffered data and waits until all writes are completed.
+     */
+    void flush();
+
+    /**
+     * Flushes and closes file, further writes throw.
+     */
+    void close();
+
+    Backend getBackend() const;
+
+    /// @return number of bytes written so far, including buffered ones
+    Poco::UInt64 getSize() const;
+
+private:
+    struct UringState;
+
+    void submitBuffer();
+    void complete(bool wait);
+
+    std::string _path;
+    std::ofstream _stream;
+    std::vector<char> _streamBuffer;
+    std::unique_ptr<UringState> _uring;
+    Poco::UInt64 _size = 0;
+    bool _open = false;
+};
+
+} /* namespace astlib */
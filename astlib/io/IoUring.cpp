@@ -0,0 +1,259 @@
+///
+/// \package astlib
+/// \file IoUring.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "IoUring.h"
+
+#if defined(ASTLIB_HAS_IO_URING)
+
+#include "astlib/Exception.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace astlib
+{
+
+static int setup(unsigned entries, io_uring_params* params)
+{
+    return int(::syscall(__NR_io_uring_setup, entries, params));
+}
+
+static int enter(int fd, unsigned submit, unsigned wait, unsigned flags, const void* arg, size_t size)
+{
+    return int(::syscall(__NR_io_uring_enter, fd, submit, wait, flags, arg, size));
+}
+
+static int registerOp(int fd, unsigned opcode, const void* arg, unsigned count)
+{
+    return int(::syscall(__NR_io_uring_register, fd, opcode, arg, count));
+}
+
+template<typename T>
+static T* at(void* base, unsigned offset)
+{
+    return reinterpret_cast<T*>(static_cast<char*>(base) + offset);
+}
+
+IoUring::IoUring(unsigned entries)
+{
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+
+    _fd = setup(entries, &params);
+    if (_fd < 0)
+        throw Exception("IoUring::IoUring(): io_uring_setup failed: " + std::string(strerror(errno)));
+
+    if (!(params.features & IORING_FEAT_EXT_ARG))
+    {
+        ::close(_fd);
+        throw Exception("IoUring::IoUring(): kernel lacks IORING_FEAT_EXT_ARG");
+    }
+
+    _sqSize = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    _cqSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    bool single = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single)
+        _sqSize = _cqSize = std::max(_sqSize, _cqSize);
+
+    _sqMemory = ::mmap(nullptr, _sqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQ_RING);
+    if (_sqMemory == MAP_FAILED)
+    {
+        ::close(_fd);
+        throw Exception("IoUring::IoUring(): cannot map submission ring");
+    }
+
+    _cqMemory = single ? _sqMemory : ::mmap(nullptr, _cqSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_CQ_RING);
+    _sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    void* sqes = ::mmap(nullptr, _sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, IORING_OFF_SQES);
+    if (_cqMemory == MAP_FAILED || sqes == MAP_FAILED)
+    {
+        if (_cqMemory != MAP_FAILED && !single)
+            ::munmap(_cqMemory, _cqSize);
+        ::munmap(_sqMemory, _sqSize);
+        ::close(_fd);
+        throw Exception("IoUring::IoUring(): cannot map completion ring");
+    }
+    _sqes = static_cast<io_uring_sqe*>(sqes);
+
+    _sqHead = at<unsigned>(_sqMemory, params.sq_off.head);
+    _sqTail = at<unsigned>(_sqMemory, params.sq_off.tail);
+    _sqMask = *at<unsigned>(_sqMemory, params.sq_off.ring_mask);
+    _sqEntries = *at<unsigned>(_sqMemory, params.sq_off.ring_entries);
+    _sqeTail = _submitted = *_sqTail;
+
+    // Submission entries are used in ring order, so the index array is identity
+    unsigned* array = at<unsigned>(_sqMemory, params.sq_off.array);
+    for(unsigned i = 0; i < _sqEntries; i++)
+        array[i] = i;
+
+    _cqHead = at<unsigned>(_cqMemory, params.cq_off.head);
+    _cqTail = at<unsigned>(_cqMemory, params.cq_off.tail);
+    _cqMask = *at<unsigned>(_cqMemory, params.cq_off.ring_mask);
+    _cqes = at<io_uring_cqe>(_cqMemory, params.cq_off.cqes);
+}
+
+IoUring::~IoUring()
+{
+    for(unsigned i = 0; i < _bufferRingCount; i++)
+        ::munmap(_bufferRings[i].ring, _bufferRings[i].mappedSize);
+
+    ::munmap(_sqes, _sqesSize);
+    if (_cqMemory != _sqMemory)
+        ::munmap(_cqMemory, _cqSize);
+    ::munmap(_sqMemory, _sqSize);
+    ::close(_fd);
+}
+
+io_uring_sqe* IoUring::getSqe()
+{
+    unsigned head = __atomic_load_n(_sqHead, __ATOMIC_ACQUIRE);
+    if (_sqeTail - head >= _sqEntries)
+        return nullptr;
+
+    io_uring_sqe* sqe = &_sqes[_sqeTail & _sqMask];
+    _sqeTail++;
+    memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+int IoUring::submit(unsigned wait, const Poco::Timespan* timeout)
+{
+    unsigned count = _sqeTail - _submitted;
+    __atomic_store_n(_sqTail, _sqeTail, __ATOMIC_RELEASE);
+
+    unsigned flags = wait ? IORING_ENTER_GETEVENTS : 0;
+    __kernel_timespec time;
+    io_uring_getevents_arg arg;
+    memset(&arg, 0, sizeof(arg));
+
+    if (timeout)
+    {
+        time.tv_sec = timeout->totalMicroseconds() / 1000000;
+        time.tv_nsec = (timeout->totalMicroseconds() % 1000000) * 1000;
+        arg.ts = reinterpret_cast<Poco::UInt64>(&time);
+    }
+    arg.sigmask_sz = _NSIG / 8;
+    flags |= IORING_ENTER_EXT_ARG;
+
+    int result = enter(_fd, count, wait, flags, &arg, sizeof(arg));
+    if (result < 0)
+        return -errno;
+
+    _submitted += unsigned(result);
+    return result;
+}
+
+io_uring_cqe* IoUring::peek()
+{
+    unsigned head = *_cqHead;
+    if (head == __atomic_load_n(_cqTail, __ATOMIC_ACQUIRE))
+        return nullptr;
+    return &_cqes[head & _cqMask];
+}
+
+void IoUring::seen()
+{
+    __atomic_store_n(_cqHead, *_cqHead + 1, __ATOMIC_RELEASE);
+}
+
+bool IoUring::registerBuffers(const iovec vectors[], unsigned count)
+{
+    return registerOp(_fd, IORING_REGISTER_BUFFERS, vectors, count) == 0;
+}
+
+bool IoUring::registerBufferRing(Poco::UInt16 group, Byte buffers[], size_t bufferSize, unsigned count)
+{
+    if (_bufferRingCount >= sizeof(_bufferRings) / sizeof(_bufferRings[0]) || count == 0 || (count & (count - 1)) || count > 32768)
+        return false;
+
+    BufferRing& ring = _bufferRings[_bufferRingCount];
+    ring.mappedSize = count * sizeof(io_uring_buf);
+    void* memory = ::mmap(nullptr, ring.mappedSize, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (memory == MAP_FAILED)
+        return false;
+
+    io_uring_buf_reg reg;
+    memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<Poco::UInt64>(memory);
+    reg.ring_entries = count;
+    reg.bgid = group;
+
+    if (registerOp(_fd, IORING_REGISTER_PBUF_RING, &reg, 1) != 0)
+    {
+        ::munmap(memory, ring.mappedSize);
+        return false;
+    }
+
+    ring.ring = static_cast<io_uring_buf_ring*>(memory);
+    ring.buffers = buffers;
+    ring.bufferSize = bufferSize;
+    ring.mask = count - 1;
+    ring.tail = 0;
+    ring.group = group;
+    _bufferRingCount++;
+
+    for(unsigned id = 0; id < count; id++)
+        recycleBuffer(group, Poco::UInt16(id));
+    commitBuffers(group);
+    return true;
+}
+
+void IoUring::recycleBuffer(Poco::UInt16 group, Poco::UInt16 id)
+{
+    BufferRing& ring = bufferRing(group);
+    // Not ring->bufs, flexible array member of the kernel header is misplaced when compiled as C++
+    io_uring_buf& buffer = reinterpret_cast<io_uring_buf*>(ring.ring)[ring.tail & ring.mask];
+    buffer.addr = reinterpret_cast<Poco::UInt64>(ring.buffers + id * ring.bufferSize);
+    buffer.len = Poco::UInt32(ring.bufferSize);
+    buffer.bid = id;
+    ring.tail++;
+}
+
+void IoUring::commitBuffers(Poco::UInt16 group)
+{
+    BufferRing& ring = bufferRing(group);
+    __atomic_store_n(&ring.ring->tail, ring.tail, __ATOMIC_RELEASE);
+}
+
+Byte* IoUring::getBuffer(Poco::UInt16 group, Poco::UInt16 id) const
+{
+    const BufferRing& ring = bufferRing(group);
+    return ring.buffers + id * ring.bufferSize;
+}
+
+int IoUring::getFd() const
+{
+    return _fd;
+}
+
+IoUring::BufferRing& IoUring::bufferRing(Poco::UInt16 group)
+{
+    for(unsigned i = 0; i < _bufferRingCount; i++)
+    {
+        if (_bufferRings[i].group == group)
+            return _bufferRings[i];
+    }
+    throw Exception("IoUring::bufferRing(): unknown buffer group " + std::to_string(group));
+}
+
+const IoUring::BufferRing& IoUring::bufferRing(Poco::UInt16 group) const
+{
+    return const_cast<IoUring*>(this)->bufferRing(group);
+}
+
+} /* namespace astlib */
+
+#endif
@@ -0,0 +1,138 @@
+///
+/// \package astlib
+/// \file IoUring.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "astlib/ByteUtils.h"
+
+#include <Poco/Timespan.h>
+
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#include <linux/io_uring.h>
+#include <sys/uio.h>
+// Multishot receive and provided buffer rings came with the same headers (kernel 6.0)
+#if defined(IORING_RECV_MULTISHOT)
+#define ASTLIB_HAS_IO_URING 1
+#endif
+#endif
+#endif
+
+#if defined(ASTLIB_HAS_IO_URING)
+
+namespace astlib
+{
+
+/**
+ * Minimal io_uring instance built directly on system calls, without liburing.
+ * Holds submission and completion rings and optional provided buffer rings.
+ * Not thread safe, one instance serves one thread.
+ */
+class ASTLIB_API IoUring
+{
+public:
+    /**
+     * Creates ring, throws Exception when kernel does not provide io_uring
+     * or lacks required features (extended arguments of io_uring_enter).
+     */
+    explicit IoUring(unsigned entries);
+    ~IoUring();
+
+    /**
+     * @return zeroed submission entry or nullptr when submission queue is full
+     */
+    io_uring_sqe* getSqe();
+
+    /**
+     * Submits queued entries and optionally waits for completions.
+     * @param wait number of completions to wait for
+     * @param timeout maximal time of waiting, nullptr waits without limit
+     * @return number of submitted entries, negative errno on error (-ETIME on timeout)
+     */
+    int submit(unsigned wait = 0, const Poco::Timespan* timeout = nullptr);
+
+    /**
+     * @return oldest completion or nullptr, it must be released by seen()
+     */
+    io_uring_cqe* peek();
+
+    /**
+     * Releases completion returned by peek().
+     */
+    void seen();
+
+    /**
+     * Registers fixed buffers for *_FIXED operations.
+     * @return false when kernel refuses registration
+     */
+    bool registerBuffers(const iovec vectors[], unsigned count);
+
+    /**
+     * Creates provided buffer ring for group, buffers are handed to kernel immediately.
+     * @param count number of buffers, power of two
+     * @return false when kernel does not support buffer rings
+     */
+    bool registerBufferRing(Poco::UInt16 group, Byte buffers[], size_t bufferSize, unsigned count);
+
+    /**
+     * Returns buffer to provided ring of group, visible to kernel after commitBuffers().
+     */
+    void recycleBuffer(Poco::UInt16 group, Poco::UInt16 id);
+
+    void commitBuffers(Poco::UInt16 group);
+
+    /// @return buffer address of provided ring
+    Byte* getBuffer(Poco::UInt16 group, Poco::UInt16 id) const;
+
+    int getFd() const;
+
+private:
+    struct BufferRing
+    {
+        io_uring_buf_ring* ring = nullptr;
+        Byte* buffers = nullptr;
+        size_t bufferSize = 0;
+        unsigned mask = 0;
+        Poco::UInt16 tail = 0;
+        Poco::UInt16 group = 0;
+        size_t mappedSize = 0;
+    };
+
+    BufferRing& bufferRing(Poco::UInt16 group);
+    const BufferRing& bufferRing(Poco::UInt16 group) const;
+
+    int _fd = -1;
+    void* _sqMemory = nullptr;
+    void* _cqMemory = nullptr;
+    size_t _sqSize = 0;
+    size_t _cqSize = 0;
+    io_uring_sqe* _sqes = nullptr;
+    size_t _sqesSize = 0;
+
+    unsigned* _sqHead = nullptr;
+    unsigned* _sqTail = nullptr;
+    unsigned _sqMask = 0;
+    unsigned _sqEntries = 0;
+    unsigned _sqeTail = 0;      ///< local tail, published by submit()
+    unsigned _submitted = 0;
+
+    unsigned* _cqHead = nullptr;
+    unsigned* _cqTail = nullptr;
+    unsigned _cqMask = 0;
+    io_uring_cqe* _cqes = nullptr;
+
+    BufferRing _bufferRings[4];
+    unsigned _bufferRingCount = 0;
+};
+
+} /* namespace astlib */
+
+#endif
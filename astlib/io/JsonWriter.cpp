@@ -0,0 +1,343 @@
+///
+/// \package astlib
+/// \file JsonWriter.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "JsonWriter.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace astlib
+{
+
+namespace
+{
+
+const char DIGITS[] =
+    "00010203040506070809"
+    "10111213141516171819"
+    "20212223242526272829"
+    "30313233343536373839"
+    "40414243444546474849"
+    "50515253545556575859"
+    "60616263646566676869"
+    "70717273747576777879"
+    "80818283848586878889"
+    "90919293949596979899";
+
+/// Writes digits backwards from end, two at a time
+char* formatUnsigned(Poco::UInt64 value, char* end)
+{
+    while (value >= 100)
+    {
+        unsigned pair = unsigned(value % 100) * 2;
+        value /= 100;
+        *--end = DIGITS[pair + 1];
+        *--end = DIGITS[pair];
+    }
+    if (value >= 10)
+    {
+        unsigned pair = unsigned(value) * 2;
+        *--end = DIGITS[pair + 1];
+        *--end = DIGITS[pair];
+    }
+    else
+    {
+        *--end = char('0' + value);
+    }
+    return end;
+}
+
+}
+
+JsonWriter::JsonWriter(bool pretty, int indent) :
+    _pretty(pretty),
+    _indent(indent)
+{
+}
+
+void JsonWriter::beginObject()
+{
+    separator();
+    _buffer += '{';
+    _first.push_back(true);
+}
+
+void JsonWriter::endObject()
+{
+    bool empty = _first.back();
+    _first.pop_back();
+    if (!empty)
+        indent();
+    _buffer += '}';
+}
+
+void JsonWriter::beginArray()
+{
+    separator();
+    _buffer += '[';
+    _first.push_back(true);
+}
+
+void JsonWriter::endArray()
+{
+    bool empty = _first.back();
+    _first.pop_back();
+    if (!empty)
+        indent();
+    _buffer += ']';
+}
+
+void JsonWriter::key(const std::string& name)
+{
+    separator();
+    _buffer += '"';
+    appendEscaped(_buffer, name.data(), name.size());
+    _buffer += _pretty ? "\" : " : "\":";
+    _afterKey = true;
+}
+
+void JsonWriter::key(const char* name)
+{
+    separator();
+    _buffer += '"';
+    appendEscaped(_buffer, name, std::strlen(name));
+    _buffer += _pretty ? "\" : " : "\":";
+    _afterKey = true;
+}
+
+void JsonWriter::value(bool value)
+{
+    separator();
+    _buffer += value ? "true" : "false";
+}
+
+void JsonWriter::value(int value)
+{
+    separator();
+    appendNumber(_buffer, Poco::Int64(value));
+}
+
+void JsonWriter::value(Poco::Int64 value)
+{
+    separator();
+    appendNumber(_buffer, value);
+}
+
+void JsonWriter::value(Poco::UInt64 value)
+{
+    separator();
+    appendNumber(_buffer, value);
+}
+
+void JsonWriter::value(double value)
+{
+    separator();
+    appendNumber(_buffer, value);
+}
+
+void JsonWriter::value(const std::string& value)
+{
+    separator();
+    _buffer += '"';
+    appendEscaped(_buffer, value.data(), value.size());
+    _buffer += '"';
+}
+
+void JsonWriter::value(const char* value)
+{
+    separator();
+    _buffer += '"';
+    appendEscaped(_buffer, value, std::strlen(value));
+    _buffer += '"';
+}
+
+void JsonWriter::null()
+{
+    separator();
+    _buffer += "null";
+}
+
+void JsonWriter::newline()
+{
+    _buffer += '\n';
+}
+
+size_t JsonWriter::getDepth() const
+{
+    return _first.size();
+}
+
+bool JsonWriter::isPretty() const
+{
+    return _pretty;
+}
+
+const std::string& JsonWriter::getBuffer() const
+{
+    return _buffer;
+}
+
+std::string& JsonWriter::getBuffer()
+{
+    return _buffer;
+}
+
+size_t JsonWriter::size() const
+{
+    return _buffer.size();
+}
+
+void JsonWriter::truncate(size_t size)
+{
+    if (size < _buffer.size())
+        _buffer.resize(size);
+    _first.clear();
+    _afterKey = false;
+}
+
+void JsonWriter::clear()
+{
+    truncate(0);
+}
+
+void JsonWriter::appendEscaped(std::string& out, const char* text, size_t size)
+{
+    static const char HEX[] = "0123456789abcdef";
+    const char* run = text;
+    const char* end = text + size;
+
+    // Copy unescaped runs at once
+    for(const char* ptr = text; ptr < end; ptr++)
+    {
+        unsigned char c = static_cast<unsigned char>(*ptr);
+        if (c >= 0x20 && c != '"' && c != '\\')
+            continue;
+
+        out.append(run, ptr - run);
+        run = ptr + 1;
+        switch(c)
+        {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        default:
+            out += "\\u00";
+            out += HEX[c >> 4];
+            out += HEX[c & 15];
+        }
+    }
+    out.append(run, end - run);
+}
+
+void JsonWriter::appendNumber(std::string& out, Poco::Int64 value)
+{
+    char text[24];
+    char* end = text + sizeof(text);
+    // Negation in unsigned domain is defined for INT64_MIN too
+    Poco::UInt64 magnitude = value < 0 ? 0 - Poco::UInt64(value) : Poco::UInt64(value);
+    char* begin = formatUnsigned(magnitude, end);
+    if (value < 0)
+        *--begin = '-';
+    out.append(begin, end - begin);
+}
+
+void JsonWriter::appendNumber(std::string& out, Poco::UInt64 value)
+{
+    char text[24];
+    char* end = text + sizeof(text);
+    char* begin = formatUnsigned(value, end);
+    out.append(begin, end - begin);
+}
+
+void JsonWriter::appendNumber(std::string& out, double value)
+{
+    if (!std::isfinite(value))
+    {
+        out += "null";
+        return;
+    }
+
+    // Fast path: scaled by 1e9 the value is an exact integer, which covers LSB multiples
+    // of usual asterix units. Decimal text parses back to the same double, because
+    // division of exact integer by 1e9 is correctly rounded.
+    const double SCALE = 1e9;
+    double scaled = value * SCALE;
+    if (std::fabs(scaled) < 9007199254740992.0)
+    {
+        Poco::Int64 integer = Poco::Int64(std::llround(scaled));
+        if (double(integer) / SCALE == value)
+        {
+            Poco::UInt64 magnitude = integer < 0 ? 0 - Poco::UInt64(integer) : Poco::UInt64(integer);
+            Poco::UInt64 whole = magnitude / 1000000000;
+            unsigned fraction = unsigned(magnitude % 1000000000);
+
+            if (integer < 0)
+                out += '-';
+            appendNumber(out, whole);
+            if (fraction)
+            {
+                char digits[9];
+                int length = 9;
+                for(int i = 8; i >= 0; i--, fraction /= 10)
+                    digits[i] = char('0' + fraction % 10);
+                while (digits[length - 1] == '0')
+                    length--;
+                out += '.';
+                out.append(digits, length);
+            }
+            return;
+        }
+    }
+
+    // Shortest of 15, 16 or 17 significant digits reading back exactly
+    char text[32];
+    int length = 0;
+    for(int precision = 15; precision <= 17; precision++)
+    {
+        length = std::snprintf(text, sizeof(text), "%.*g", precision, value);
+        if (std::strtod(text, nullptr) == value)
+            break;
+    }
+    out.append(text, length);
+}
+
+void JsonWriter::separator()
+{
+    if (_afterKey)
+    {
+        _afterKey = false;
+        return;
+    }
+    if (_first.empty())
+        return;
+
+    if (_first.back())
+        _first.back() = false;
+    else
+        _buffer += ',';
+    indent();
+}
+
+void JsonWriter::indent()
+{
+    if (!_pretty)
+        return;
+    _buffer += '\n';
+    _buffer.append(_first.size() * _indent, ' ');
+}
+
+} /* namespace astlib */
@@ -0,0 +1,97 @@
+///
+/// \package astlib
+/// \file JsonWriter.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "astlib/ByteUtils.h"
+
+#include <Poco/Types.h>
+
+#include <string>
+#include <vector>
+
+namespace astlib
+{
+
+/**
+ * Streaming Json emitter appending directly into reusable text buffer.
+ * Commas, quotes and indentation are handled by the writer, caller only
+ * opens/closes containers and emits keys and values in document order.
+ * Compact mode writes no whitespace, pretty mode indents nested values.
+ */
+class ASTLIB_API JsonWriter
+{
+public:
+    explicit JsonWriter(bool pretty = false, int indent = 2);
+
+    void beginObject();
+    void endObject();
+    void beginArray();
+    void endArray();
+
+    /**
+     * Object member name, must be followed by value or container.
+     */
+    void key(const std::string& name);
+    void key(const char* name);
+
+    void value(bool value);
+    void value(int value);
+    void value(Poco::Int64 value);
+    void value(Poco::UInt64 value);
+    /// NaN and infinity are written as null
+    void value(double value);
+    void value(const std::string& value);
+    void value(const char* value);
+    void null();
+
+    /**
+     * Ends top level value with line feed, e.g. one record per line in compact mode.
+     */
+    void newline();
+
+    /// @return current nesting depth, zero between top level values
+    size_t getDepth() const;
+
+    bool isPretty() const;
+
+    /// Text written so far
+    const std::string& getBuffer() const;
+    std::string& getBuffer();
+
+    size_t size() const;
+
+    /**
+     * Discards text after position, used to drop unfinished value.
+     * Nesting is reset, so it is meant for top level boundaries.
+     */
+    void truncate(size_t size);
+
+    void clear();
+
+    static void appendEscaped(std::string& out, const char* text, size_t size);
+    static void appendNumber(std::string& out, Poco::Int64 value);
+    static void appendNumber(std::string& out, Poco::UInt64 value);
+    /// Shortest text reading back to the same double, NaN and infinity as null
+    static void appendNumber(std::string& out, double value);
+
+private:
+    void separator();
+    void indent();
+
+    std::string _buffer;
+    std::vector<bool> _first;   ///< first member of open container not written yet
+    bool _afterKey = false;
+    bool _pretty;
+    int _indent;
+};
+
+} /* namespace astlib */
@@ -0,0 +1,317 @@
+///
+/// \package astlib
+/// \file NdjsonSink.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "NdjsonSink.h"
+#include "astlib/Exception.h"
+
+#include <Poco/File.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+namespace astlib
+{
+
+NdjsonSink::NdjsonSink(const std::string& target, size_t bufferSize) :
+    _path(target),
+    _buffer(std::max<size_t>(bufferSize, 4096))
+{
+    if (target == "-")
+    {
+#if defined(__linux__)
+        _fd = STDOUT_FILENO;
+#else
+        _file = stdout;
+#endif
+        _open = true;
+        _path.clear();
+    }
+    else if (target.compare(0, 5, "unix:") == 0)
+    {
+        _path = target.substr(5);
+        _socket = true;
+    }
+    open();
+}
+
+NdjsonSink::NdjsonSink(int fd, size_t bufferSize) :
+    _buffer(std::max<size_t>(bufferSize, 4096))
+{
+#if defined(__linux__)
+    if (fd < 0)
+        throw Exception("NdjsonSink::NdjsonSink(): invalid descriptor");
+    _fd = fd;
+    _open = true;
+#else
+    throw Exception("NdjsonSink::NdjsonSink(): descriptor targets are not supported on this platform");
+#endif
+}
+
+NdjsonSink::~NdjsonSink()
+{
+    try
+    {
+        close();
+    }
+    catch(...)
+    {
+    }
+}
+
+void NdjsonSink::write(const char* data, size_t size)
+{
+    if (!_open)
+        throw Exception("NdjsonSink::write(): sink is closed");
+
+    if (_used == 0)
+        _buffered.update();
+
+    if (_used + size <= _buffer.size())
+    {
+        std::memcpy(_buffer.data() + _used, data, size);
+        _used += size;
+        if (_used == _buffer.size())
+            writeOut(nullptr, 0);
+    }
+    else
+    {
+        // Buffer and the chunk go out by one writev(), chunk is not copied
+        writeOut(data, size);
+    }
+
+    if (_used && _flushInterval && _buffered.isElapsed(_flushInterval))
+        writeOut(nullptr, 0);
+}
+
+void NdjsonSink::poll()
+{
+    if (_used && _flushInterval && _buffered.isElapsed(_flushInterval))
+        writeOut(nullptr, 0);
+    else if (_used == 0 && _maxAge && _fileSize && _opened.isElapsed(Poco::Timestamp::TimeDiff(_maxAge) * 1000000))
+        rotate();
+}
+
+void NdjsonSink::flush()
+{
+    if (_open && _used)
+        writeOut(nullptr, 0);
+}
+
+void NdjsonSink::close()
+{
+    if (!_open)
+        return;
+
+    flush();
+    closeTarget();
+}
+
+void NdjsonSink::setFlushInterval(Poco::Int64 microseconds)
+{
+    _flushInterval = std::max<Poco::Int64>(microseconds, 0);
+}
+
+void NdjsonSink::setRotation(Poco::UInt64 maxBytes, unsigned maxAge)
+{
+    if ((maxBytes || maxAge) && (_path.empty() || _socket))
+        throw Exception("NdjsonSink::setRotation(): only file target can be rotated");
+
+    _maxBytes = maxBytes;
+    _maxAge = maxAge;
+}
+
+Poco::UInt64 NdjsonSink::getBytesWritten() const
+{
+    return _written;
+}
+
+size_t NdjsonSink::getWriteCount() const
+{
+    return _writes;
+}
+
+unsigned NdjsonSink::getRotationCount() const
+{
+    return _rotations;
+}
+
+void NdjsonSink::open()
+{
+    if (_path.empty())
+        return;
+
+#if defined(__linux__)
+    if (_socket)
+    {
+        sockaddr_un address;
+        std::memset(&address, 0, sizeof(address));
+        address.sun_family = AF_UNIX;
+        if (_path.size() >= sizeof(address.sun_path))
+            throw Exception("NdjsonSink::open(): socket path too long " + _path);
+        std::memcpy(address.sun_path, _path.data(), _path.size());
+
+        _fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        if (_fd < 0)
+            throw Exception("NdjsonSink::open(): socket() failed: " + std::string(std::strerror(errno)));
+        if (::connect(_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0)
+        {
+            int error = errno;
+            ::close(_fd);
+            _fd = -1;
+            throw Exception("NdjsonSink::open(): cannot connect to " + _path + ": " + std::strerror(error));
+        }
+    }
+    else
+    {
+        _fd = ::open(_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+        if (_fd < 0)
+            throw Exception("NdjsonSink::open(): cannot create " + _path + ": " + std::strerror(errno));
+    }
+#else
+    if (_socket)
+        throw Exception("NdjsonSink::open(): unix socket targets are not supported on this platform");
+
+    _file = std::fopen(_path.c_str(), "wb");
+    if (_file == nullptr)
+        throw Exception("NdjsonSink::open(): cannot create " + _path + ": " + std::strerror(errno));
+    // Data are already collected in large blocks
+    std::setvbuf(_file, nullptr, _IONBF, 0);
+#endif
+    _open = true;
+    _owned = true;
+    _fileSize = 0;
+    _opened.update();
+}
+
+void NdjsonSink::closeTarget()
+{
+#if defined(__linux__)
+    if (_owned)
+        ::close(_fd);
+    _fd = -1;
+#else
+    if (_owned)
+        std::fclose(_file);
+    else
+        std::fflush(_file);
+    _file = nullptr;
+#endif
+    _open = false;
+}
+
+void NdjsonSink::writeOut(const char* extra, size_t extraSize)
+{
+    size_t total = _used + extraSize;
+#if defined(__linux__)
+    iovec vectors[2];
+    int count = 0;
+    if (_used)
+    {
+        vectors[count].iov_base = _buffer.data();
+        vectors[count++].iov_len = _used;
+    }
+    if (extraSize)
+    {
+        vectors[count].iov_base = const_cast<char*>(extra);
+        vectors[count++].iov_len = extraSize;
+    }
+
+    iovec* vector = vectors;
+    while (count)
+    {
+        ssize_t result;
+        if (_socket)
+        {
+            // Socket must not raise SIGPIPE when consumer goes away
+            msghdr header;
+            std::memset(&header, 0, sizeof(header));
+            header.msg_iov = vector;
+            header.msg_iovlen = count;
+            result = ::sendmsg(_fd, &header, MSG_NOSIGNAL);
+        }
+        else
+        {
+            result = ::writev(_fd, vector, count);
+        }
+        _writes++;
+        if (result < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            // Buffer is discarded, the next flush must not resend its already written head
+            int error = errno;
+            _used = 0;
+            throw Exception("NdjsonSink::writeOut(): write failed: " + std::string(std::strerror(error)));
+        }
+
+        // Partial write (pipe, socket), continue with the rest
+        size_t done = size_t(result);
+        while (count && done >= vector->iov_len)
+        {
+            done -= vector->iov_len;
+            vector++;
+            count--;
+        }
+        if (count)
+        {
+            vector->iov_base = static_cast<char*>(vector->iov_base) + done;
+            vector->iov_len -= done;
+        }
+    }
+#else
+    // Unbuffered stdio, two writes instead of writev()
+    if ((_used && std::fwrite(_buffer.data(), 1, _used, _file) != _used) ||
+        (extraSize && std::fwrite(extra, 1, extraSize, _file) != extraSize))
+    {
+        int error = errno;
+        _used = 0;
+        throw Exception("NdjsonSink::writeOut(): write failed: " + std::string(std::strerror(error)));
+    }
+    _writes += (_used != 0) + (extraSize != 0);
+#endif
+
+    _used = 0;
+    _written += total;
+    _fileSize += total;
+
+    if ((_maxBytes && _fileSize >= _maxBytes) || (_maxAge && _opened.isElapsed(Poco::Timestamp::TimeDiff(_maxAge) * 1000000)))
+        rotate();
+}
+
+void NdjsonSink::rotate()
+{
+    // First free sequence number, older rotations are never overwritten
+    unsigned sequence = _rotations;
+    std::string rotated;
+    do
+    {
+        rotated = _path + "." + std::to_string(++sequence);
+    }
+    while (Poco::File(rotated).exists());
+
+    closeTarget();
+    if (std::rename(_path.c_str(), rotated.c_str()) != 0)
+        throw Exception("NdjsonSink::rotate(): cannot rename " + _path + ": " + std::strerror(errno));
+    _rotations++;
+    open();
+}
+
+} /* namespace astlib */
@@ -0,0 +1,119 @@
+///
+/// \package astlib
+/// \file NdjsonSink.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "OutputSink.h"
+
+#include <Poco/Timestamp.h>
+#include <Poco/Types.h>
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace astlib
+{
+
+/**
+ * Newline delimited Json sink, records of many batches are collected in one large
+ * buffer and written by single write()/writev() call. Buffer is written when full,
+ * when the oldest buffered record is older than flush interval, or on flush().
+ * Chunks not fitting into the buffer are written together with it by writev()
+ * without copying, other platforms use unbuffered stdio. File targets may be rotated
+ * by size and age, the current file is renamed to "<path>.<n>" and a new one is
+ * created at record boundary.
+ */
+class ASTLIB_API NdjsonSink :
+    public OutputSink
+{
+public:
+    enum {
+        DEFAULT_BUFFER_SIZE = 1 << 20,
+        DEFAULT_FLUSH_INTERVAL = 100000     ///< microseconds
+    };
+
+    /**
+     * Opens target, throws Exception on failure.
+     * @param target file path, "-" for standard output or "unix:<path>" for Unix stream socket (Linux)
+     */
+    explicit NdjsonSink(const std::string& target, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    /**
+     * Writes to already open descriptor, e.g. pipe, which is not closed by sink (Linux).
+     */
+    explicit NdjsonSink(int fd, size_t bufferSize = DEFAULT_BUFFER_SIZE);
+
+    /// Flushes and closes target, errors are ignored
+    ~NdjsonSink();
+
+    void write(const char* data, size_t size) override;
+    using OutputSink::write;
+
+    void poll() override;
+
+    void flush() override;
+
+    /**
+     * Flushes and closes target, further writes throw.
+     */
+    void close();
+
+    /**
+     * @param microseconds maximal age of buffered record, zero flushes only full buffer
+     */
+    void setFlushInterval(Poco::Int64 microseconds);
+
+    /**
+     * Enables rotation of file target, zero disables the limit.
+     * @param maxBytes size of file triggering rotation
+     * @param maxAge age of file in seconds triggering rotation
+     */
+    void setRotation(Poco::UInt64 maxBytes, unsigned maxAge = 0);
+
+    /// @return number of bytes written to target, without buffered ones
+    Poco::UInt64 getBytesWritten() const;
+
+    /// @return number of write system calls
+    size_t getWriteCount() const;
+
+    /// @return number of files rotated out so far
+    unsigned getRotationCount() const;
+
+private:
+    void open();
+    void closeTarget();
+    void writeOut(const char* extra, size_t extraSize);
+    void rotate();
+
+    std::string _path;
+#if defined(__linux__)
+    int _fd = -1;
+#else
+    std::FILE* _file = nullptr;
+#endif
+    bool _open = false;
+    bool _owned = false;
+    bool _socket = false;
+    std::vector<char> _buffer;
+    size_t _used = 0;
+    Poco::Timestamp _buffered;      ///< time of the oldest buffered chunk
+    Poco::Timestamp _opened;
+    Poco::Int64 _flushInterval = DEFAULT_FLUSH_INTERVAL;
+    Poco::UInt64 _maxBytes = 0;
+    unsigned _maxAge = 0;
+    Poco::UInt64 _fileSize = 0;
+    Poco::UInt64 _written = 0;
+    size_t _writes = 0;
+    unsigned _rotations = 0;
+};
+
+} /* namespace astlib */
@@ -0,0 +1,48 @@
+///
+/// \package astlib
+/// \file OutputSink.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "astlib/ByteUtils.h"
+
+#include <cstddef>
+#include <string>
+
+namespace astlib
+{
+
+/**
+ * Destination of formatted records. Text is passed in chunks of whole records,
+ * so the sink may split output only between chunks. All methods are called
+ * from one thread, e.g. the output thread of DecodePipeline.
+ */
+class ASTLIB_API OutputSink
+{
+public:
+    virtual ~OutputSink() = default;
+
+    virtual void write(const char* data, size_t size) = 0;
+
+    void write(const std::string& text)
+    {
+        write(text.data(), text.size());
+    }
+
+    /// Called when there is nothing to write, time based flushing is done here
+    virtual void poll()
+    {
+    }
+
+    /// Writes all buffered data to destination
+    virtual void flush() = 0;
+};
+
+} /* namespace astlib */
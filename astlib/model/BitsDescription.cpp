@@ -14,6 +14,80 @@
 namespace astlib
 {
 
+BitsPlan::BitsPlan(const BitsDescription& bits) :
+    width(bits.effectiveBitsWidth()),
+    compiled(true)
+{
+    if (width == 1)
+    {
+        shift = bits.bit - 1;
+        mask = bits.fx ? 0 : 1;
+    }
+    else
+    {
+        shift = bits.to - 1;
+        mask = (width >= 64) ? ~0ULL : ((1ULL << width) - 1);
+    }
+
+    scale = bits.scale * unitFactor(bits.units);
+    inverseScale = 1.0 / scale;
+
+    Encoding::ValueType encoding = bits.encoding.toValue();
+
+    switch(bits.code.type())
+    {
+        case PrimitiveType::Boolean:
+            kind = Boolean;
+            break;
+
+        case PrimitiveType::Real:
+            kind = (encoding == Encoding::Unsigned) ? UnsignedReal : Real;
+            break;
+
+        case PrimitiveType::Integer:
+            kind = Integer;
+            break;
+
+        case PrimitiveType::Unsigned:
+            kind = (encoding == Encoding::Octal) ? Octal : Unsigned;
+            break;
+
+        default:
+        {
+            switch (encoding)
+            {
+                case Encoding::Ascii:
+                    kind = Ascii;
+                    break;
+                case Encoding::Octal:
+                    kind = Octal;
+                    break;
+                case Encoding::SixBitsChar:
+                    kind = SixBitsChar;
+                    break;
+                case Encoding::Hex:
+                    kind = Hex;
+                    break;
+            }
+            break;
+        }
+    }
+}
+
+double BitsPlan::unitFactor(Units units)
+{
+    switch(units.toValue())
+    {
+        case Units::FT:
+            return 0.3048;
+        case Units::NM:
+            return 1852.0;
+        case Units::FL:
+            return 0.3048 * 100.0;
+    }
+    return 1.0;
+}
+
 void BitsDescription::addEnumeration(const std::string& key, int value)
 {
     values[key] = value;
@@ -41,6 +115,11 @@ Poco::UInt64 BitsDescription::bitMask() const
     return (1ULL << effectiveBitsWidth()) - 1;
 }
 
+void BitsDescription::compile()
+{
+    plan = BitsPlan(*this);
+}
+
 BitsDescription& BitsDescription::operator =(const BitsDescription &)
 {
 	return *this;
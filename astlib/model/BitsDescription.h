@@ -19,6 +19,43 @@
 namespace astlib
 {
 
+class BitsDescription;
+
+/**
+ * Precompiled codec plan for one BitsDescription.
+ * Holds everything encode/decode loops need per field (value kind, shift, mask,
+ * unit scale and its reciprocal), so it is evaluated once when the codec is loaded.
+ */
+struct ASTLIB_API BitsPlan
+{
+    enum Kind
+    {
+        None,           ///< value is not passed to user code
+        Boolean,
+        Integer,
+        Unsigned,
+        Octal,          ///< octal coded unsigned (Mode 3/A, Mode 1 ...)
+        Real,           ///< signed raw value multiplied by scale
+        UnsignedReal,   ///< unsigned raw value multiplied by scale
+        Ascii,
+        SixBitsChar,
+        Hex
+    };
+
+    BitsPlan() {}
+    explicit BitsPlan(const BitsDescription& bits);
+
+    static double unitFactor(Units units);
+
+    Kind kind = None;
+    int width = 1;                  ///< effective bit width
+    int shift = 0;                  ///< position of the lowest bit inside Fixed
+    Poco::UInt64 mask = 0;          ///< value mask before shifting, zero for FX bits
+    double scale = 1.0;             ///< bits.scale with unit normalization applied
+    double inverseScale = 1.0;      ///< reciprocal of scale, for encoding
+    bool compiled = false;
+};
+
 class ASTLIB_API BitsDescription
 {
 public:
@@ -42,6 +79,7 @@ public:
     double min = -100000000000;
     double max = 100000000000;
     Units units = Units::None;
+    BitsPlan plan;
 
     void addEnumeration(const std::string& key, int value);
 
@@ -50,6 +88,11 @@ public:
 
     std::string toString() const;
 
+    /**
+     * Precompute codec plan from current attributes, call when all attributes are set.
+     */
+    void compile();
+
 	BitsDescription& operator =(const BitsDescription&);
 };
 
@@ -71,6 +71,13 @@ void CodecDescription::addUapItem(int frn, int itemId, bool mandatory)
 {
     auto item = getDataItemById(itemId);
     _uapItems[frn] = UapItem{ item, mandatory };
+
+    if (frn >= 0)
+    {
+        if (size_t(frn) >= _uapTable.size())
+            _uapTable.resize(frn + 1);
+        _uapTable[frn] = UapItem{ item, mandatory };
+    }
 }
 
 const CodecDescription::UapItems& CodecDescription::enumerateUapItems() const
@@ -68,6 +68,15 @@ public:
     void addUapItem(int frn, int itemId, bool mandatory);
     const UapItems& enumerateUapItems() const;
 
+    /**
+     * Direct FRN indexed access for decoders.
+     * @return UAP item for FSPEC bit or nullptr when bit has no item
+     */
+    const UapItem* getUapItem(int frn) const
+    {
+        return (size_t(frn) < _uapTable.size() && _uapTable[frn].item) ? &_uapTable[frn] : nullptr;
+    }
+
     void addPrimitiveItem(const std::string& name, const PrimitiveItem& item);
     const Dictionary& getDictionary() const;
 
@@ -76,6 +85,7 @@ private:
     ItemDescriptionTable _dataItems;
     Parameters _parameters;
     UapItems _uapItems;
+    std::vector<UapItem> _uapTable;
     Dictionary _itemDictionary;
 };
 
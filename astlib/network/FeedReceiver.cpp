@@ -0,0 +1,395 @@
+///
+/// \package astlib
+/// \file FeedReceiver.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "FeedReceiver.h"
+#include "astlib/io/IoUring.h"
+#include "astlib/Exception.h"
+
+#include <Poco/Net/NetworkInterface.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <sys/epoll.h>
+#include <unistd.h>
+#endif
+
+namespace astlib
+{
+
+#if defined(ASTLIB_HAS_IO_URING)
+static constexpr Poco::UInt16 BUFFER_GROUP = 1;
+static constexpr unsigned MIN_BUFFER_COUNT = 64;
+static constexpr unsigned MAX_BUFFER_COUNT = 1024;
+static constexpr size_t BUFFER_MEMORY = 32 * 1024 * 1024;
+
+struct FeedReceiver::UringState
+{
+    UringState(unsigned entries, size_t payloadSize) :
+        ring(entries)
+    {
+        memset(&header, 0, sizeof(header));
+        header.msg_namelen = sizeof(sockaddr_storage);
+        header.msg_controllen = UdpReceiver::getControlSize();
+        bufferSize = sizeof(io_uring_recvmsg_out) + header.msg_namelen + header.msg_controllen + payloadSize;
+        // Keep buffers 8 byte aligned for the recvmsg_out header
+        bufferSize = (bufferSize + 7) & ~size_t(7);
+        // Power of two count, fewer buffers for big datagrams
+        bufferCount = MAX_BUFFER_COUNT;
+        while (bufferCount > MIN_BUFFER_COUNT && bufferSize * bufferCount > BUFFER_MEMORY)
+            bufferCount /= 2;
+        buffers.resize(bufferSize * bufferCount);
+    }
+
+    IoUring ring;
+    msghdr header;              ///< layout of multishot buffers, read by kernel
+    size_t bufferSize;
+    unsigned bufferCount;
+    std::vector<Byte> buffers;
+    std::vector<Poco::UInt16> used;     ///< buffers of packets returned by previous receive()
+    std::vector<size_t> rearm;
+};
+#else
+struct FeedReceiver::UringState
+{
+};
+#endif
+
+Feed Feed::parse(const std::string& text)
+{
+    Feed feed;
+    std::string address = text;
+
+    size_t equals = address.find('=');
+    if (equals != std::string::npos)
+    {
+        feed.name = address.substr(0, equals);
+        address.erase(0, equals + 1);
+    }
+
+    size_t at = address.rfind('@');
+    if (at != std::string::npos)
+    {
+        feed.interfaceName = address.substr(at + 1);
+        address.erase(at);
+    }
+
+    if (address.find(':') == std::string::npos)
+        throw Exception("Feed::parse(): missing port in " + text);
+
+    feed.address = Poco::Net::SocketAddress(address);
+    if (feed.name.empty())
+        feed.name = address;
+    return feed;
+}
+
+FeedReceiver::FeedReceiver(size_t batch, bool reusePort, Backend backend, size_t maxDatagramSize) :
+    _batch(batch),
+    _maxDatagramSize(maxDatagramSize),
+    _reusePort(reusePort)
+{
+#if defined(__linux__)
+    _epoll = ::epoll_create1(EPOLL_CLOEXEC);
+    if (_epoll < 0)
+        throw Exception("FeedReceiver::FeedReceiver(): epoll_create1 failed: " + std::string(strerror(errno)));
+#endif
+
+#if defined(ASTLIB_HAS_IO_URING)
+    if (backend == Uring)
+    {
+        try
+        {
+            _uring.reset(new UringState(256, std::max<size_t>(1, std::min(maxDatagramSize, size_t(UdpReceiver::MAX_DATAGRAM_SIZE)))));
+            if (!_uring->ring.registerBufferRing(BUFFER_GROUP, _uring->buffers.data(), _uring->bufferSize, _uring->bufferCount))
+                _uring.reset();
+        }
+        catch(Exception&)
+        {
+            // Kernel without io_uring or forbidden by seccomp, epoll stays in use
+            _uring.reset();
+        }
+    }
+#endif
+}
+
+FeedReceiver::~FeedReceiver()
+{
+#if defined(__linux__)
+    ::close(_epoll);
+#endif
+}
+
+size_t FeedReceiver::addFeed(const Feed& feed, int receiveBufferSize)
+{
+    std::unique_ptr<Source> source(new Source);
+    source->feed = feed;
+
+    const Poco::Net::IPAddress& host = feed.address.host();
+    bool multicast = host.isMulticast();
+
+    // Poco binds with both SO_REUSEADDR and SO_REUSEPORT when reuse is asked for, so a unicast
+    // port is shared only on request and the second process otherwise fails to bind
+    bool reuse = multicast || _reusePort;
+
+#if defined(__linux__)
+    // Bound to group address the socket gets only datagrams of this group, not all on the port
+    source->socket.bind(feed.address, reuse);
+#else
+    source->socket.bind(multicast ? Poco::Net::SocketAddress(Poco::Net::IPAddress::wildcard(host.family()), feed.address.port()) : feed.address, reuse);
+#endif
+
+    if (multicast)
+    {
+        if (feed.interfaceName.empty())
+            source->socket.joinGroup(host);
+        else
+            source->socket.joinGroup(host, Poco::Net::NetworkInterface::forName(feed.interfaceName));
+    }
+
+    // Ring of recvmmsg buffers is needed only without io_uring
+    if (!_uring)
+        createReceiver(*source);
+    if (receiveBufferSize > 0)
+        source->socket.setReceiveBufferSize(receiveBufferSize);
+    source->localPort = source->socket.address().port();
+
+    size_t index = _sources.size();
+
+#if defined(__linux__)
+    epoll_event event;
+    memset(&event, 0, sizeof(event));
+    event.events = EPOLLIN;
+    event.data.u64 = index;
+    if (::epoll_ctl(_epoll, EPOLL_CTL_ADD, source->socket.impl()->sockfd(), &event) < 0)
+        throw Exception("FeedReceiver::addFeed(): epoll_ctl failed: " + std::string(strerror(errno)));
+#endif
+
+    _sources.push_back(std::move(source));
+    if (_uring)
+        armFeed(index);
+    return index;
+}
+
+size_t FeedReceiver::receive(std::vector<RecordingPacket>& packets, const Poco::Timespan& timeout)
+{
+    if (_uring)
+        return receiveUring(packets, timeout);
+
+    packets.clear();
+
+#if defined(__linux__)
+    epoll_event events[64];
+    int count = ::epoll_wait(_epoll, events, 64, int(timeout.totalMilliseconds()));
+    if (count < 0)
+    {
+        if (errno == EINTR)
+            return 0;
+        throw Exception("FeedReceiver::receive(): epoll_wait failed: " + std::string(strerror(errno)));
+    }
+
+    for(int i = 0; i < count; i++)
+        readFeed(size_t(events[i].data.u64), packets);
+#else
+    Poco::Net::Socket::SocketList readList, writeList, exceptList;
+    for(const auto& source: _sources)
+        readList.push_back(source->socket);
+
+    if (readList.empty() || Poco::Net::Socket::select(readList, writeList, exceptList, timeout) == 0)
+        return 0;
+
+    for(size_t index = 0; index < _sources.size(); index++)
+    {
+        for(const auto& socket: readList)
+        {
+            if (socket == _sources[index]->socket)
+                readFeed(index, packets);
+        }
+    }
+#endif
+
+    return packets.size();
+}
+
+size_t FeedReceiver::receiveUring(std::vector<RecordingPacket>& packets, const Poco::Timespan& timeout)
+{
+#if defined(ASTLIB_HAS_IO_URING)
+    packets.clear();
+    IoUring& ring = _uring->ring;
+
+    // Previous packets are released, their buffers go back to kernel
+    for(Poco::UInt16 id: _uring->used)
+        ring.recycleBuffer(BUFFER_GROUP, id);
+    if (!_uring->used.empty())
+        ring.commitBuffers(BUFFER_GROUP);
+    _uring->used.clear();
+
+    int result = ring.submit(1, &timeout);
+    if (result < 0 && result != -ETIME && result != -EINTR && result != -EBUSY)
+        throw Exception("FeedReceiver::receive(): io_uring_enter failed: " + std::string(strerror(-result)));
+
+    Poco::Timestamp now;
+    bool unsupported = false;
+
+    while (io_uring_cqe* cqe = ring.peek())
+    {
+        size_t index = size_t(cqe->user_data);
+        int bytes = cqe->res;
+        unsigned flags = cqe->flags;
+        ring.seen();
+
+        // Terminated multishot request, i.e. after running out of buffers
+        if (!(flags & IORING_CQE_F_MORE))
+            _uring->rearm.push_back(index);
+
+        if (flags & IORING_CQE_F_BUFFER)
+            _uring->used.push_back(Poco::UInt16(flags >> IORING_CQE_BUFFER_SHIFT));
+
+        if (bytes < 0)
+        {
+            if (bytes == -EINVAL || bytes == -EOPNOTSUPP)
+                unsupported = true;
+            continue;
+        }
+        if (!(flags & IORING_CQE_F_BUFFER) || index >= _sources.size())
+            continue;
+
+        Byte* buffer = ring.getBuffer(BUFFER_GROUP, _uring->used.back());
+        const io_uring_recvmsg_out* out = reinterpret_cast<const io_uring_recvmsg_out*>(buffer);
+        size_t nameOffset = sizeof(io_uring_recvmsg_out);
+        size_t controlOffset = nameOffset + _uring->header.msg_namelen;
+        size_t payloadOffset = controlOffset + _uring->header.msg_controllen;
+        if (size_t(bytes) < payloadOffset)
+            continue;
+
+        // Cut data block would fail to decode or decode partially, datagram is counted and dropped
+        if (out->flags & MSG_TRUNC)
+        {
+            _truncated++;
+            continue;
+        }
+
+        Source& source = *_sources[index];
+        RecordingPacket packet;
+        packet.data = buffer + payloadOffset;
+        packet.size = std::min<size_t>(out->payloadlen, size_t(bytes) - payloadOffset);
+        packet.destinationPort = source.localPort;
+        packet.feed = Poco::UInt16(index);
+
+        sockaddr_storage address;
+        memset(&address, 0, sizeof(address));
+        memcpy(&address, buffer + nameOffset, std::min<size_t>(out->namelen, sizeof(address)));
+        UdpReceiver::setSender(packet, address);
+
+        msghdr control;
+        memset(&control, 0, sizeof(control));
+        control.msg_control = buffer + controlOffset;
+        control.msg_controllen = out->controllen;
+        packet.timestamp = UdpReceiver::receiveTime(control, now);
+
+        packets.push_back(packet);
+        source.uringPackets++;
+    }
+
+    if (unsupported && packets.empty())
+    {
+        // Kernel accepted the ring but not multishot recvmsg, sockets are still registered to epoll
+        _uring.reset();
+        for(auto& source: _sources)
+            createReceiver(*source);
+        return receive(packets, Poco::Timespan(0));
+    }
+
+    for(size_t index: _uring->rearm)
+        armFeed(index);
+    _uring->rearm.clear();
+
+    return packets.size();
+#else
+    return 0;
+#endif
+}
+
+void FeedReceiver::armFeed(size_t index)
+{
+#if defined(ASTLIB_HAS_IO_URING)
+    IoUring& ring = _uring->ring;
+    io_uring_sqe* sqe = ring.getSqe();
+    if (!sqe)
+    {
+        ring.submit();
+        sqe = ring.getSqe();
+    }
+
+    sqe->opcode = IORING_OP_RECVMSG;
+    sqe->fd = _sources[index]->socket.impl()->sockfd();
+    sqe->addr = reinterpret_cast<Poco::UInt64>(&_uring->header);
+    sqe->len = 1;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = BUFFER_GROUP;
+    sqe->user_data = index;
+#endif
+}
+
+void FeedReceiver::createReceiver(Source& source)
+{
+    source.receiver.reset(new UdpReceiver(source.socket, _batch, 0, _maxDatagramSize));
+}
+
+void FeedReceiver::readFeed(size_t index, std::vector<RecordingPacket>& packets)
+{
+    size_t first = packets.size();
+    _sources[index]->receiver->read(packets);
+
+    for(size_t i = first; i < packets.size(); i++)
+        packets[i].feed = Poco::UInt16(index);
+}
+
+size_t FeedReceiver::getFeedCount() const
+{
+    return _sources.size();
+}
+
+const Feed& FeedReceiver::getFeed(size_t index) const
+{
+    return _sources.at(index)->feed;
+}
+
+Poco::Net::SocketAddress FeedReceiver::getLocalAddress(size_t index) const
+{
+    return _sources.at(index)->socket.address();
+}
+
+Poco::UInt64 FeedReceiver::getPacketCount(size_t index) const
+{
+    const Source& source = *_sources.at(index);
+    return (source.receiver ? source.receiver->getPacketCount() : 0) + source.uringPackets;
+}
+
+FeedReceiver::Backend FeedReceiver::getBackend() const
+{
+    return _uring ? Uring : Epoll;
+}
+
+Poco::UInt64 FeedReceiver::getTruncatedCount() const
+{
+    Poco::UInt64 count = _truncated;
+    for(const auto& source: _sources)
+    {
+        if (source->receiver)
+            count += source->receiver->getTruncatedCount();
+    }
+    return count;
+}
+
+} /* namespace astlib */
@@ -0,0 +1,122 @@
+///
+/// \package astlib
+/// \file FeedReceiver.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "UdpReceiver.h"
+
+#include <Poco/Net/MulticastSocket.h>
+#include <Poco/Net/SocketAddress.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace astlib
+{
+
+/**
+ * UDP feed, unicast port or multicast group.
+ */
+struct ASTLIB_API Feed
+{
+    std::string name;
+    Poco::Net::SocketAddress address;   ///< multicast group or local address with port
+    std::string interfaceName;          ///< interface for joining group, empty for system default
+
+    /**
+     * Parses "[name=]host:port[@interface]", name defaults to "host:port".
+     */
+    static Feed parse(const std::string& text);
+};
+
+/**
+ * Fan-in receiver of many UDP feeds driven by one epoll loop (select on other platforms).
+ * Datagrams are tagged by feed index and sender, so one decoding stage can serve all feeds.
+ * For spreading load over cores create one receiver per thread with reusePort, the kernel
+ * then balances unicast datagrams between their sockets.
+ *
+ * With Uring backend every socket has one multishot recvmsg request writing datagrams into
+ * ring of provided buffers, so a busy receiver needs one system call per wakeup for all feeds.
+ */
+class ASTLIB_API FeedReceiver
+{
+public:
+    enum Backend {
+        Epoll,      ///< readiness by epoll/select, datagrams read by recvmmsg
+        Uring       ///< io_uring multishot receive (Linux 6.0+), falls back to Epoll when unavailable
+    };
+
+    /**
+     * @param batch maximal number of datagrams read from one socket per wakeup
+     * @param reusePort bind sockets with SO_REUSEPORT
+     * @param backend requested backend, see getBackend() for the one in use
+     * @param maxDatagramSize receive buffer size of one datagram, every Epoll feed holds batch of them
+     *        and Uring shares up to 1024 of them between all feeds, longer datagrams are dropped
+     *        and counted as truncated
+     */
+    FeedReceiver(size_t batch = UdpReceiver::DEFAULT_BATCH, bool reusePort = false, Backend backend = Epoll, size_t maxDatagramSize = UdpReceiver::MAX_DATAGRAM_SIZE);
+    ~FeedReceiver();
+
+    /**
+     * Binds socket for feed and joins multicast group, throws Poco::Exception on failure.
+     * @param receiveBufferSize socket receive buffer size, zero keeps system default
+     * @return feed index used as RecordingPacket::feed
+     */
+    size_t addFeed(const Feed& feed, int receiveBufferSize = 0);
+
+    /**
+     * Waits up to timeout and receives pending datagrams of all ready feeds.
+     * Packet data stay valid until the next call.
+     * @return number of packets, zero on timeout
+     */
+    size_t receive(std::vector<RecordingPacket>& packets, const Poco::Timespan& timeout);
+
+    size_t getFeedCount() const;
+    const Feed& getFeed(size_t index) const;
+
+    /// @return local address of feed socket
+    Poco::Net::SocketAddress getLocalAddress(size_t index) const;
+
+    /// @return number of datagrams received by feed
+    Poco::UInt64 getPacketCount(size_t index) const;
+
+    Backend getBackend() const;
+
+    /// @return number of datagrams dropped for exceeding maximal datagram size or io_uring buffer size
+    Poco::UInt64 getTruncatedCount() const;
+
+private:
+    struct Source
+    {
+        Feed feed;
+        Poco::Net::MulticastSocket socket;
+        std::unique_ptr<UdpReceiver> receiver;     ///< Epoll backend only
+        Poco::UInt16 localPort = 0;
+        Poco::UInt64 uringPackets = 0;
+    };
+    struct UringState;
+
+    void readFeed(size_t index, std::vector<RecordingPacket>& packets);
+    size_t receiveUring(std::vector<RecordingPacket>& packets, const Poco::Timespan& timeout);
+    void armFeed(size_t index);
+    void createReceiver(Source& source);
+
+    std::vector<std::unique_ptr<Source>> _sources;
+    size_t _batch;
+    size_t _maxDatagramSize;
+    bool _reusePort;
+    int _epoll = -1;
+    std::unique_ptr<UringState> _uring;
+    Poco::UInt64 _truncated = 0;
+};
+
+} /* namespace astlib */
@@ -0,0 +1,211 @@
+///
+/// \package astlib
+/// \file PacketCapture.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "PacketCapture.h"
+#include "astlib/recording/PcapReader.h"
+#include "astlib/recording/PcapWriter.h"
+#include "astlib/Exception.h"
+
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <arpa/inet.h>
+#include <linux/if_ether.h>
+#include <linux/if_packet.h>
+#include <net/if.h>
+#include <net/if_arp.h>
+#include <poll.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+namespace astlib
+{
+
+#if defined(__linux__)
+
+PacketCapture::PacketCapture(const std::string& interfaceName, int port, size_t blockSize, unsigned blockCount, unsigned blockTimeout) :
+    _blockSize(blockSize),
+    _blockCount(blockCount),
+    _port(port)
+{
+    unsigned index = 0;
+    if (!interfaceName.empty())
+    {
+        index = ::if_nametoindex(interfaceName.c_str());
+        if (index == 0)
+            throw Exception("PacketCapture::PacketCapture(): unknown interface " + interfaceName);
+    }
+
+    _fd = ::socket(AF_PACKET, SOCK_RAW, htons(ETH_P_ALL));
+    if (_fd < 0)
+        throw Exception("PacketCapture::PacketCapture(): cannot open packet socket: " + std::string(strerror(errno)));
+
+    try
+    {
+        int version = TPACKET_V3;
+        if (::setsockopt(_fd, SOL_PACKET, PACKET_VERSION, &version, sizeof(version)) < 0)
+            throw Exception("PacketCapture::PacketCapture(): TPACKET_V3 not supported");
+
+        tpacket_req3 request;
+        memset(&request, 0, sizeof(request));
+        request.tp_block_size = unsigned(blockSize);
+        request.tp_block_nr = blockCount;
+        request.tp_frame_size = TPACKET_ALIGNMENT << 7;   // nominal only, V3 packs frames of any size
+        request.tp_frame_nr = unsigned(blockSize / request.tp_frame_size) * blockCount;
+        request.tp_retire_blk_tov = blockTimeout;
+        if (::setsockopt(_fd, SOL_PACKET, PACKET_RX_RING, &request, sizeof(request)) < 0)
+            throw Exception("PacketCapture::PacketCapture(): cannot create ring: " + std::string(strerror(errno)));
+
+        _ringSize = blockSize * blockCount;
+        void* ring = ::mmap(nullptr, _ringSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, _fd, 0);
+        if (ring == MAP_FAILED)
+            throw Exception("PacketCapture::PacketCapture(): cannot map ring: " + std::string(strerror(errno)));
+        _ring = static_cast<Byte*>(ring);
+
+        sockaddr_ll address;
+        memset(&address, 0, sizeof(address));
+        address.sll_family = AF_PACKET;
+        address.sll_protocol = htons(ETH_P_ALL);
+        address.sll_ifindex = int(index);
+        if (::bind(_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+            throw Exception("PacketCapture::PacketCapture(): cannot bind to " + interfaceName + ": " + strerror(errno));
+    }
+    catch(...)
+    {
+        if (_ring)
+            ::munmap(_ring, _ringSize);
+        ::close(_fd);
+        throw;
+    }
+}
+
+PacketCapture::~PacketCapture()
+{
+    ::munmap(_ring, _ringSize);
+    ::close(_fd);
+}
+
+size_t PacketCapture::receive(std::vector<RecordingPacket>& packets, const Poco::Timespan& timeout)
+{
+    packets.clear();
+    releaseBlock();
+
+    tpacket_block_desc* block = reinterpret_cast<tpacket_block_desc*>(_ring + _block * _blockSize);
+    if (!(__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER))
+    {
+        pollfd descriptor;
+        descriptor.fd = _fd;
+        descriptor.events = POLLIN | POLLERR;
+        descriptor.revents = 0;
+        ::poll(&descriptor, 1, int(timeout.totalMilliseconds()));
+
+        if (!(__atomic_load_n(&block->hdr.bh1.block_status, __ATOMIC_ACQUIRE) & TP_STATUS_USER))
+            return 0;
+    }
+    _holding = true;
+
+    const Byte* ptr = reinterpret_cast<const Byte*>(block) + block->hdr.bh1.offset_to_first_pkt;
+    for(unsigned i = 0; i < block->hdr.bh1.num_pkts; i++)
+    {
+        const tpacket3_hdr* header = reinterpret_cast<const tpacket3_hdr*>(ptr);
+        const sockaddr_ll* link = reinterpret_cast<const sockaddr_ll*>(ptr + TPACKET_ALIGN(sizeof(tpacket3_hdr)));
+        const Byte* frame = ptr + header->tp_mac;
+        Poco::Int64 nanoseconds = Poco::Int64(header->tp_sec) * 1000000000 + header->tp_nsec;
+        _frames++;
+
+        // Frames sent by this host are seen too when capturing on all interfaces,
+        // interfaces without Ethernet header (tunnels) are not supported
+        bool ethernet = link->sll_hatype == ARPHRD_ETHER || link->sll_hatype == ARPHRD_LOOPBACK;
+        if (ethernet && link->sll_pkttype != PACKET_OUTGOING)
+        {
+            if (_recorder)
+                _recorder->write(nanoseconds, frame, header->tp_snaplen, header->tp_len);
+
+            RecordingPacket packet;
+            if (PcapReader::parseUdp(PcapReader::LINKTYPE_ETHERNET, frame, header->tp_snaplen, _port, packet))
+            {
+                packet.timestamp = Poco::Timestamp(nanoseconds / 1000);
+                packets.push_back(packet);
+            }
+        }
+
+        ptr += header->tp_next_offset;
+    }
+
+    return packets.size();
+}
+
+void PacketCapture::releaseBlock()
+{
+    if (!_holding)
+        return;
+
+    tpacket_block_desc* block = reinterpret_cast<tpacket_block_desc*>(_ring + _block * _blockSize);
+    __atomic_store_n(&block->hdr.bh1.block_status, TP_STATUS_KERNEL, __ATOMIC_RELEASE);
+    _block = (_block + 1) % _blockCount;
+    _holding = false;
+}
+
+Poco::UInt64 PacketCapture::getDropCount()
+{
+    // Kernel resets counters by every read
+    tpacket_stats_v3 stats;
+    socklen_t length = sizeof(stats);
+    if (::getsockopt(_fd, SOL_PACKET, PACKET_STATISTICS, &stats, &length) == 0)
+        _drops += stats.tp_drops;
+    return _drops;
+}
+
+#else
+
+PacketCapture::PacketCapture(const std::string& interfaceName, int port, size_t blockSize, unsigned blockCount, unsigned blockTimeout) :
+    _blockSize(blockSize),
+    _blockCount(blockCount),
+    _port(port)
+{
+    throw Exception("PacketCapture::PacketCapture(): AF_PACKET capture is available on Linux only");
+}
+
+PacketCapture::~PacketCapture()
+{
+}
+
+size_t PacketCapture::receive(std::vector<RecordingPacket>& packets, const Poco::Timespan& timeout)
+{
+    packets.clear();
+    return 0;
+}
+
+void PacketCapture::releaseBlock()
+{
+}
+
+Poco::UInt64 PacketCapture::getDropCount()
+{
+    return _drops;
+}
+
+#endif
+
+void PacketCapture::setRecorder(PcapWriter* recorder)
+{
+    _recorder = recorder;
+}
+
+Poco::UInt64 PacketCapture::getFrameCount() const
+{
+    return _frames;
+}
+
+} /* namespace astlib */
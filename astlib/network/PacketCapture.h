@@ -0,0 +1,80 @@
+///
+/// \package astlib
+/// \file PacketCapture.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "astlib/recording/RecordingPacket.h"
+
+#include <Poco/Timespan.h>
+
+#include <string>
+#include <vector>
+
+namespace astlib
+{
+
+class PcapWriter;
+
+/**
+ * Live capture of UDP datagrams from network interface through memory mapped
+ * AF_PACKET TPACKET_V3 ring (Linux only). Kernel fills whole blocks of frames,
+ * Ethernet/IP/UDP headers are parsed in user space and payloads are returned
+ * directly from the ring without copying. Needs CAP_NET_RAW.
+ */
+class ASTLIB_API PacketCapture
+{
+public:
+    /**
+     * Opens ring on interface, throws Exception on failure or on other platforms.
+     * @param interfaceName interface name, empty captures all interfaces
+     * @param port UDP destination port filter, zero disables filter
+     * @param blockSize ring block size, multiple of page size
+     * @param blockCount number of ring blocks
+     * @param blockTimeout milliseconds after which kernel retires partially filled block
+     */
+    PacketCapture(const std::string& interfaceName, int port = 0, size_t blockSize = 1 << 22, unsigned blockCount = 64, unsigned blockTimeout = 10);
+    ~PacketCapture();
+
+    /**
+     * Frames of following blocks are written to recorder before filtering, nullptr disables.
+     */
+    void setRecorder(PcapWriter* recorder);
+
+    /**
+     * Waits up to timeout for next filled block and returns its UDP payloads.
+     * The block is returned to kernel on the next call, packets are valid until then.
+     * @return number of packets, zero on timeout or for block without matching datagrams
+     */
+    size_t receive(std::vector<RecordingPacket>& packets, const Poco::Timespan& timeout);
+
+    /// @return number of received frames
+    Poco::UInt64 getFrameCount() const;
+
+    /// @return number of frames dropped by kernel because the ring was full
+    Poco::UInt64 getDropCount();
+
+private:
+    void releaseBlock();
+
+    int _fd = -1;
+    Byte* _ring = nullptr;
+    size_t _ringSize = 0;
+    size_t _blockSize;
+    unsigned _blockCount;
+    unsigned _block = 0;            ///< next block to read
+    bool _holding = false;          ///< block _block is owned by user
+    int _port;
+    PcapWriter* _recorder = nullptr;
+    Poco::UInt64 _frames = 0;
+    Poco::UInt64 _drops = 0;
+};
+
+} /* namespace astlib */
@@ -0,0 +1,231 @@
+///
+/// \package astlib
+/// \file UdpReceiver.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "UdpReceiver.h"
+#include "astlib/Exception.h"
+
+#include <Poco/Net/SocketAddress.h>
+#include <Poco/ByteOrder.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+
+#if defined(__linux__)
+#include <netinet/in.h>
+#include <time.h>
+#endif
+
+namespace astlib
+{
+
+#if defined(__linux__)
+// Room for one SCM_TIMESTAMPNS message
+static constexpr size_t CONTROL_SIZE = CMSG_SPACE(sizeof(timespec));
+#endif
+
+UdpReceiver::UdpReceiver(const Poco::Net::DatagramSocket& socket, size_t batch, size_t slots, size_t slotSize) :
+    _socket(socket),
+    _batch(std::max<size_t>(1, batch)),
+    _slots(std::max(_batch, slots)),
+    _slotSize(std::max<size_t>(1, std::min(slotSize, size_t(MAX_DATAGRAM_SIZE))))
+{
+    _buffers.resize(_slots * _slotSize);
+    _localPort = _socket.address().port();
+
+#if defined(__linux__)
+    _headers.resize(_batch);
+    _vectors.resize(_slots);
+    _addresses.resize(_slots);
+    _control.resize(_slots * CONTROL_SIZE);
+
+    int enable = 1;
+    _kernelTimestamps = ::setsockopt(_socket.impl()->sockfd(), SOL_SOCKET, SO_TIMESTAMPNS, &enable, sizeof(enable)) == 0;
+#endif
+}
+
+UdpReceiver::~UdpReceiver()
+{
+}
+
+int UdpReceiver::setReceiveBufferSize(int bytes)
+{
+    _socket.setReceiveBufferSize(bytes);
+    return _socket.getReceiveBufferSize();
+}
+
+size_t UdpReceiver::receive(std::vector<RecordingPacket>& packets, const Poco::Timespan& timeout)
+{
+    packets.clear();
+
+    if (!_socket.poll(timeout, Poco::Net::Socket::SELECT_READ))
+        return 0;
+
+    return read(packets);
+}
+
+size_t UdpReceiver::read(std::vector<RecordingPacket>& packets)
+{
+    size_t first = packets.size();
+
+#if defined(__linux__)
+    // Batch never straddles the end of ring
+    if (_next + _batch > _slots)
+        _next = 0;
+
+    for(size_t i = 0; i < _batch; i++)
+    {
+        size_t slot = _next + i;
+        _vectors[slot].iov_base = _buffers.data() + slot * _slotSize;
+        _vectors[slot].iov_len = _slotSize;
+
+        msghdr& header = _headers[i].msg_hdr;
+        header.msg_name = &_addresses[slot];
+        header.msg_namelen = sizeof(sockaddr_storage);
+        header.msg_iov = &_vectors[slot];
+        header.msg_iovlen = 1;
+        header.msg_control = _kernelTimestamps ? _control.data() + slot * CONTROL_SIZE : nullptr;
+        header.msg_controllen = _kernelTimestamps ? CONTROL_SIZE : 0;
+        header.msg_flags = 0;
+    }
+
+    int count = ::recvmmsg(_socket.impl()->sockfd(), _headers.data(), unsigned(_batch), MSG_DONTWAIT, nullptr);
+    if (count < 0)
+    {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+            return 0;
+        throw Exception("UdpReceiver::receive(): recvmmsg failed: " + std::string(strerror(errno)));
+    }
+
+    Poco::Timestamp now;
+    packets.reserve(first + size_t(count));
+
+    for(int i = 0; i < count; i++)
+    {
+        size_t slot = _next + size_t(i);
+        msghdr& header = _headers[size_t(i)].msg_hdr;
+
+        // Cut data block would fail to decode or decode partially
+        if (header.msg_flags & MSG_TRUNC)
+        {
+            _truncatedCount++;
+            continue;
+        }
+
+        packets.emplace_back();
+        RecordingPacket& packet = packets.back();
+
+        packet.data = _buffers.data() + slot * _slotSize;
+        packet.size = _headers[size_t(i)].msg_len;
+        packet.destinationPort = _localPort;
+        setSender(packet, _addresses[slot]);
+        packet.timestamp = receiveTime(header, now);
+    }
+
+    _next += size_t(count);
+#else
+    do
+    {
+        if (_next >= _slots)
+            _next = 0;
+
+        Poco::Net::SocketAddress sender;
+        Byte* buffer = _buffers.data() + _next * _slotSize;
+        int bytes = _socket.receiveFrom(buffer, int(_slotSize), sender);
+        if (bytes < 0)
+            break;
+
+        RecordingPacket packet;
+        packet.data = buffer;
+        packet.size = size_t(bytes);
+        packet.sourcePort = sender.port();
+        if (sender.family() == Poco::Net::IPAddress::IPv4)
+            packet.sourceAddress = Poco::ByteOrder::fromNetwork(*reinterpret_cast<const Poco::UInt32*>(sender.host().addr()));
+        packet.destinationPort = _localPort;
+        packets.push_back(packet);
+        _next++;
+    }
+    while (packets.size() - first < _batch && _socket.poll(Poco::Timespan(0), Poco::Net::Socket::SELECT_READ));
+#endif
+
+    size_t received = packets.size() - first;
+    if (received)
+    {
+        _packetCount += received;
+        _batchCount++;
+    }
+    return received;
+}
+
+bool UdpReceiver::hasKernelTimestamps() const
+{
+    return _kernelTimestamps;
+}
+
+Poco::UInt64 UdpReceiver::getPacketCount() const
+{
+    return _packetCount;
+}
+
+Poco::UInt64 UdpReceiver::getBatchCount() const
+{
+    return _batchCount;
+}
+
+Poco::UInt64 UdpReceiver::getTruncatedCount() const
+{
+    return _truncatedCount;
+}
+
+Poco::Net::DatagramSocket& UdpReceiver::getSocket()
+{
+    return _socket;
+}
+
+#if defined(__linux__)
+size_t UdpReceiver::getControlSize()
+{
+    return CONTROL_SIZE;
+}
+
+void UdpReceiver::setSender(RecordingPacket& packet, const sockaddr_storage& address)
+{
+    packet.sourcePort = 0;
+    packet.sourceAddress = 0;
+
+    if (address.ss_family == AF_INET)
+    {
+        const sockaddr_in& ipv4 = reinterpret_cast<const sockaddr_in&>(address);
+        packet.sourcePort = ntohs(ipv4.sin_port);
+        packet.sourceAddress = ntohl(ipv4.sin_addr.s_addr);
+    }
+    else if (address.ss_family == AF_INET6)
+    {
+        packet.sourcePort = ntohs(reinterpret_cast<const sockaddr_in6&>(address).sin6_port);
+    }
+}
+
+Poco::Timestamp UdpReceiver::receiveTime(msghdr& header, const Poco::Timestamp& fallback)
+{
+    for(cmsghdr* message = CMSG_FIRSTHDR(&header); message; message = CMSG_NXTHDR(&header, message))
+    {
+        if (message->cmsg_level == SOL_SOCKET && message->cmsg_type == SCM_TIMESTAMPNS)
+        {
+            timespec time;
+            memcpy(&time, CMSG_DATA(message), sizeof(time));
+            return Poco::Timestamp(Poco::Timestamp::TimeVal(time.tv_sec) * 1000000 + time.tv_nsec / 1000);
+        }
+    }
+    return fallback;
+}
+#endif
+
+} /* namespace astlib */
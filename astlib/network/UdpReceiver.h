@@ -0,0 +1,119 @@
+///
+/// \package astlib
+/// \file UdpReceiver.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "astlib/recording/RecordingPacket.h"
+
+#include <Poco/Net/DatagramSocket.h>
+#include <Poco/Timespan.h>
+
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#endif
+
+namespace astlib
+{
+
+/**
+ * Batched receiver of UDP datagrams. On Linux all pending datagrams are read by one
+ * recvmmsg() call into preallocated ring of buffers and stamped with kernel receive
+ * time (SO_TIMESTAMPNS). Other platforms receive one datagram per call and stamp
+ * with user space time.
+ */
+class ASTLIB_API UdpReceiver
+{
+public:
+    static constexpr size_t DEFAULT_BATCH = 64;
+    static constexpr size_t MAX_DATAGRAM_SIZE = 65535;     ///< full range of asterix LEN
+
+    /**
+     * @param socket bound socket, it is shared with caller
+     * @param batch maximal number of datagrams returned by one receive()
+     * @param slots number of buffers in ring, at least batch
+     * @param slotSize size of one ring buffer, longer datagrams are dropped and counted as truncated
+     */
+    UdpReceiver(const Poco::Net::DatagramSocket& socket, size_t batch = DEFAULT_BATCH, size_t slots = 0, size_t slotSize = MAX_DATAGRAM_SIZE);
+    ~UdpReceiver();
+
+    /**
+     * Requests socket receive buffer size.
+     * @return size granted by the kernel, it may be limited by system settings
+     */
+    int setReceiveBufferSize(int bytes);
+
+    /**
+     * Waits for data up to timeout and receives all pending datagrams up to batch size.
+     * Packet data point into the ring, they stay valid until the ring wraps around,
+     * i.e. for at least (slots - batch) following datagrams.
+     * @return number of packets, zero on timeout
+     */
+    size_t receive(std::vector<RecordingPacket>& packets, const Poco::Timespan& timeout);
+
+    /**
+     * Receives pending datagrams up to batch size without waiting, i.e. after readiness
+     * was signalled by select/epoll. Packets are appended to the vector.
+     * @return number of appended packets
+     */
+    size_t read(std::vector<RecordingPacket>& packets);
+
+    /// @return true when packets carry kernel receive time
+    bool hasKernelTimestamps() const;
+
+    /// @return number of received datagrams
+    Poco::UInt64 getPacketCount() const;
+
+    /// @return number of receive calls returning data
+    Poco::UInt64 getBatchCount() const;
+
+    /// @return number of datagrams dropped for exceeding slot size
+    Poco::UInt64 getTruncatedCount() const;
+
+    Poco::Net::DatagramSocket& getSocket();
+
+#if defined(__linux__)
+    /// @return size of control buffer for receive timestamp
+    static size_t getControlSize();
+
+    /**
+     * Fills sender port and IPv4 address of packet.
+     */
+    static void setSender(RecordingPacket& packet, const sockaddr_storage& address);
+
+    /**
+     * @return SO_TIMESTAMPNS time from control messages of received header or fallback
+     */
+    static Poco::Timestamp receiveTime(msghdr& header, const Poco::Timestamp& fallback);
+#endif
+
+private:
+    Poco::Net::DatagramSocket _socket;
+    size_t _batch;
+    size_t _slots;
+    size_t _slotSize;
+    size_t _next = 0;                   ///< first ring slot for next receive
+    std::vector<Byte> _buffers;
+    bool _kernelTimestamps = false;
+    Poco::UInt16 _localPort = 0;
+    Poco::UInt64 _packetCount = 0;
+    Poco::UInt64 _batchCount = 0;
+    Poco::UInt64 _truncatedCount = 0;
+#if defined(__linux__)
+    std::vector<mmsghdr> _headers;
+    std::vector<iovec> _vectors;
+    std::vector<sockaddr_storage> _addresses;
+    std::vector<Byte> _control;
+#endif
+};
+
+} /* namespace astlib */
@@ -0,0 +1,431 @@
+///
+/// \package astlib
+/// \file DecodePipeline.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "DecodePipeline.h"
+#include "astlib/decoder/DatagramDecoder.h"
+#include "astlib/decoder/JsonValueDecoder.h"
+#include "astlib/Exception.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <exception>
+
+namespace astlib
+{
+
+struct DecodePipeline::Worker :
+    public Poco::Runnable
+{
+    Worker(DecodePipeline& owner, const CodecRegister& codecRegister, bool pretty) :
+        owner(owner),
+        json(pretty),
+        outbox(OUTBOX_SIZE)
+    {
+        decoder.setCodecs(codecRegister);
+    }
+
+    void run()
+    {
+        owner.decode(*this);
+    }
+
+    enum { OUTBOX_SIZE = 64 };
+
+    DecodePipeline& owner;
+    DatagramDecoder decoder;
+    JsonValueDecoder json;
+    SpscQueue<std::string> outbox;
+    Poco::Thread thread;
+    std::atomic<size_t> records { 0 };
+    int feed = -1;                      ///< feed and sender of the last tagged packet
+    Poco::UInt32 sourceAddress = 0;
+    Poco::UInt16 sourcePort = 0;
+};
+
+DecodePipeline::DecodePipeline(const CodecRegister& codecRegister, Output output, size_t workers, size_t depth, DropPolicy policy, bool pretty) :
+    _output(output),
+    _policy(policy),
+    _free(std::max<size_t>(depth, 1)),
+    _pending(std::max<size_t>(depth, 1)),
+    _outputRunnable(*this, &DecodePipeline::output)
+{
+    if (!_output)
+        throw Exception("DecodePipeline::DecodePipeline(): missing output");
+
+    for(size_t i = 0; i < std::max<size_t>(depth, 1); i++)
+    {
+        _batches.emplace_back(new Batch());
+        _free.push(_batches.back().get());
+    }
+    for(size_t i = 0; i < std::max<size_t>(workers, 1); i++)
+        _workers.emplace_back(new Worker(*this, codecRegister, pretty));
+}
+
+DecodePipeline::DecodePipeline(const CodecRegister& codecRegister, OutputSink& sink, size_t workers, size_t depth, DropPolicy policy, bool pretty) :
+    DecodePipeline(codecRegister, [&sink](const std::string& text) { sink.write(text); }, workers, depth, policy, pretty)
+{
+    _sink = &sink;
+}
+
+DecodePipeline::~DecodePipeline()
+{
+    try
+    {
+        stop();
+    }
+    catch(...)
+    {
+    }
+}
+
+void DecodePipeline::start()
+{
+    if (_running)
+        return;
+
+    _stopping = false;
+    _error = nullptr;
+    _activeWorkers = _workers.size();
+    for(size_t i = 0; i < _workers.size(); i++)
+    {
+        _workers[i]->thread.setName("decode" + std::to_string(i));
+        _workers[i]->thread.start(*_workers[i]);
+    }
+    _outputThread.setName("output");
+    _outputThread.start(_outputRunnable);
+    _running = true;
+}
+
+void DecodePipeline::stop()
+{
+    if (!_running)
+        return;
+
+    _stopping.store(true, std::memory_order_release);
+    for(auto& worker: _workers)
+        worker->thread.join();
+    _outputThread.join();
+    _running = false;
+
+    if (_error)
+        std::rethrow_exception(_error);
+}
+
+bool DecodePipeline::push(const std::vector<RecordingPacket>& packets)
+{
+    if (packets.empty())
+        return true;
+
+    // Shedding goes first, so the drop policy sees only admitted packets and the load
+    // counts batches being decoded as well
+    static thread_local std::vector<const RecordingPacket*> admitted;
+    admitted.clear();
+
+    double load = 1.0 - double(_free.size()) / _batches.size();
+    bool critical = false;
+    size_t bytes = 0;
+    for(const RecordingPacket& packet: packets)
+    {
+        if (!_shedder.admit(packet, load))
+            continue;
+
+        admitted.push_back(&packet);
+        critical = critical || _shedder.isCritical(packet);
+        bytes += packet.size;
+    }
+
+    if (admitted.empty())
+        return true;
+
+    Batch* batch = acquire(critical);
+    if (batch == nullptr)
+    {
+        for(const RecordingPacket* packet: admitted)
+            _shedder.countDrop(*packet);
+        _dropCount += admitted.size();
+        return false;
+    }
+
+    // Receiver buffers are reused by the next receive, payloads are copied into one block
+    batch->data.resize(bytes);
+    batch->packets.clear();
+    batch->critical = critical;
+
+    Byte* target = batch->data.data();
+    for(const RecordingPacket* packet: admitted)
+    {
+        RecordingPacket copy = *packet;
+        if (packet->size)
+            std::memcpy(target, packet->data, packet->size);
+        copy.data = target;
+        target += packet->size;
+        batch->packets.push_back(copy);
+    }
+    _packetCount += batch->packets.size();
+
+    // Pending queue holds all batches, push fails only transiently
+    unsigned spins = 0;
+    while (!_pending.push(batch))
+        idle(spins);
+    return true;
+}
+
+size_t DecodePipeline::getPacketCount() const
+{
+    return _packetCount;
+}
+
+size_t DecodePipeline::getDropCount() const
+{
+    return _dropCount;
+}
+
+void DecodePipeline::setFeedNames(const std::vector<std::string>& names)
+{
+    _feedNames = names;
+}
+
+LoadShedder& DecodePipeline::getShedder()
+{
+    return _shedder;
+}
+
+size_t DecodePipeline::getRecordCount() const
+{
+    size_t records = 0;
+    for(const auto& worker: _workers)
+        records += worker->records;
+    return records;
+}
+
+size_t DecodePipeline::getQueueDepth() const
+{
+    return _pending.size();
+}
+
+DecodePipeline::DropPolicy DecodePipeline::getPolicy() const
+{
+    return _policy;
+}
+
+DecodePipeline::DropPolicy DecodePipeline::parsePolicy(const std::string& name)
+{
+    if (name == "block")
+        return Block;
+    if (name == "newest")
+        return DropNewest;
+    if (name == "oldest")
+        return DropOldest;
+    throw Exception("DecodePipeline::parsePolicy(): unknown drop policy " + name);
+}
+
+void DecodePipeline::decode(Worker& worker)
+{
+    unsigned spins = 0;
+    Batch* batch = nullptr;
+
+    for(;;)
+    {
+        if (_pending.pop(batch))
+        {
+            spins = 0;
+            for(const RecordingPacket& packet: batch->packets)
+            {
+                worker.json.setTimestamp(packet.timestamp);
+                if (!_feedNames.empty())
+                    tag(worker, packet);
+                worker.records += worker.decoder.decode(worker.json, packet.data, packet.size).records;
+            }
+            release(batch);
+
+            std::string text;
+            worker.json.takeOutput(text);
+
+            // Slow output blocks here and the back pressure moves to receiver's drop policy
+            if (!text.empty())
+            {
+                while (!worker.outbox.push(std::move(text)))
+                    idle(spins);
+            }
+        }
+        else if (_stopping.load(std::memory_order_acquire))
+        {
+            // Batches pushed before stop() are visible now
+            if (_pending.empty())
+                break;
+        }
+        else
+        {
+            idle(spins);
+        }
+    }
+    _activeWorkers.fetch_sub(1, std::memory_order_release);
+}
+
+void DecodePipeline::tag(Worker& worker, const RecordingPacket& packet)
+{
+    // Batches usually come from few senders, strings are rebuilt only on change
+    if (worker.feed == int(packet.feed) && worker.sourceAddress == packet.sourceAddress && worker.sourcePort == packet.sourcePort)
+        return;
+
+    worker.feed = packet.feed;
+    worker.sourceAddress = packet.sourceAddress;
+    worker.sourcePort = packet.sourcePort;
+
+    std::string source;
+    if (packet.sourceAddress)
+    {
+        for(int shift = 24; shift >= 0; shift -= 8)
+        {
+            source += std::to_string((packet.sourceAddress >> shift) & 0xFF);
+            source += shift ? '.' : ':';
+        }
+        source += std::to_string(packet.sourcePort);
+    }
+
+    worker.json.setSource(packet.feed < _feedNames.size() ? _feedNames[packet.feed] : std::to_string(packet.feed), source);
+}
+
+void DecodePipeline::output()
+{
+    unsigned spins = 0;
+    std::string text;
+
+    for(;;)
+    {
+        bool finished = _activeWorkers.load(std::memory_order_acquire) == 0;
+        bool written = false;
+
+        for(auto& worker: _workers)
+        {
+            while (worker->outbox.pop(text))
+            {
+                written = true;
+                if (!_error)
+                    guarded([this, &text]() { _output(text); });
+            }
+        }
+
+        if (finished)
+            break;
+        if (written)
+        {
+            spins = 0;
+        }
+        else
+        {
+            if (_sink && !_error)
+                guarded([this]() { _sink->poll(); });
+            idle(spins);
+        }
+    }
+
+    if (_sink && !_error)
+        guarded([this]() { _sink->flush(); });
+}
+
+template <typename Action>
+void DecodePipeline::guarded(Action action)
+{
+    try
+    {
+        action();
+    }
+    catch(...)
+    {
+        // Workers must not block on a dead output, rest of the text is discarded
+        _error = std::current_exception();
+    }
+}
+
+DecodePipeline::Batch* DecodePipeline::acquire(bool critical)
+{
+    unsigned spins = 0;
+    Batch* batch = nullptr;
+
+    // Last free batches are kept for critical data, from the load where all other priorities are shed
+    double threshold = std::max({ _shedder.getThreshold(LoadShedder::High), _shedder.getThreshold(LoadShedder::Normal), _shedder.getThreshold(LoadShedder::Low) });
+    double free = std::ceil(_batches.size() * (1.0 - std::min(threshold, 1.0)));
+    size_t reserved = free > 1.0 ? size_t(free) - 1 : 0;
+
+    while ((!critical && _free.size() <= reserved) || !_free.pop(batch))
+    {
+        switch(_policy)
+        {
+        case DropNewest:
+            if (!critical)
+                return nullptr;
+            if ((batch = evict()) != nullptr)
+                return batch;
+            idle(spins);
+            break;
+
+        case DropOldest:
+            if ((batch = evict()) != nullptr)
+                return batch;
+            // Only critical batches are waiting, they outrank the new one
+            if (!critical && !_pending.empty())
+                return nullptr;
+            // All batches are being decoded right now
+            idle(spins);
+            break;
+
+        case Block:
+            idle(spins);
+            break;
+        }
+    }
+    return batch;
+}
+
+DecodePipeline::Batch* DecodePipeline::evict()
+{
+    Batch* batch = nullptr;
+
+    // One lap over waiting batches at most, critical ones go back to the tail
+    for(size_t count = _pending.size(); count > 0 && _pending.pop(batch); count--)
+    {
+        if (!batch->critical)
+        {
+            for(const RecordingPacket& packet: batch->packets)
+                _shedder.countEviction(packet);
+            _dropCount += batch->packets.size();
+            return batch;
+        }
+
+        // Pending queue holds all batches, push fails only transiently
+        unsigned spins = 0;
+        while (!_pending.push(batch))
+            idle(spins);
+    }
+    return nullptr;
+}
+
+void DecodePipeline::release(Batch* batch)
+{
+    unsigned spins = 0;
+    while (!_free.push(batch))
+        idle(spins);
+}
+
+void DecodePipeline::idle(unsigned& spins)
+{
+    // Spin briefly for low latency, then give the core away
+    if (++spins < 64)
+        return;
+    if (spins < 128)
+        Poco::Thread::yield();
+    else
+        Poco::Thread::sleep(1);
+}
+
+} /* namespace astlib */
@@ -0,0 +1,161 @@
+///
+/// \package astlib
+/// \file DecodePipeline.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "LoadShedder.h"
+#include "MpmcQueue.h"
+#include "SpscQueue.h"
+#include "astlib/io/OutputSink.h"
+#include "astlib/recording/RecordingPacket.h"
+#include "astlib/CodecRegister.h"
+
+#include <Poco/Thread.h>
+#include <Poco/RunnableAdapter.h>
+
+#include <atomic>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace astlib
+{
+
+/**
+ * Staged receive -> decode -> output pipeline, so the slow output does not stall reception.
+ * Receiver thread(s) copy packets into pooled batches passed by a bounded MPMC queue
+ * to decode workers. Every worker formats records to Json text and hands it over its own
+ * SPSC queue to the single output thread. A full pipeline blocks workers on the output
+ * side and applies the drop policy on the receive side. Before that, LoadShedder sheds
+ * low priority categories as the batches fill up; free batches left above the highest
+ * shedding threshold are reserved for critical categories, which may also displace
+ * the oldest waiting non critical batch instead of being dropped. Waiting critical
+ * batches are never evicted, eviction passes them over by requeueing, so they may be
+ * decoded after younger batches.
+ *
+ * Packets of one worker keep their order, with more workers records of different
+ * batches may be written out of order.
+ */
+class ASTLIB_API DecodePipeline
+{
+public:
+    enum DropPolicy {
+        Block,          ///< receiver waits for a free batch
+        DropNewest,     ///< incoming packets are discarded
+        DropOldest      ///< oldest waiting batch is discarded and reused
+    };
+
+    /// Called from output thread with formatted text of one batch
+    using Output = std::function<void(const std::string& text)>;
+
+    /**
+     * @param workers number of decode threads
+     * @param depth number of packet batches in flight
+     * @param pretty indented Json, otherwise one record per line
+     */
+    DecodePipeline(const CodecRegister& codecRegister, Output output, size_t workers = 1, size_t depth = 256, DropPolicy policy = DropNewest, bool pretty = true);
+
+    /**
+     * Writes to sink from output thread, sink is polled while idle and flushed by stop().
+     */
+    DecodePipeline(const CodecRegister& codecRegister, OutputSink& sink, size_t workers = 1, size_t depth = 256, DropPolicy policy = DropNewest, bool pretty = true);
+
+    /// Stops and drains pipeline
+    ~DecodePipeline();
+
+    /**
+     * Starts worker and output threads.
+     */
+    void start();
+
+    /**
+     * Decodes and writes all queued packets and joins threads.
+     * Rethrows the first exception thrown by output.
+     */
+    void stop();
+
+    /**
+     * Copies admitted packets into the pipeline, safe to call from several receiver threads.
+     * @return false when packets were dropped by DropNewest policy
+     */
+    bool push(const std::vector<RecordingPacket>& packets);
+
+    /// @return number of packets accepted by push()
+    size_t getPacketCount() const;
+
+    /// @return number of packets lost by drop policy, see LoadShedder for counts per category
+    size_t getDropCount() const;
+
+    /**
+     * Names of feeds indexed by RecordingPacket::feed, configure before start().
+     * When set, records are tagged with "feed" name and "source" address of the sender.
+     */
+    void setFeedNames(const std::vector<std::string>& names);
+
+    /**
+     * Category priorities and quotas, configure before start().
+     */
+    LoadShedder& getShedder();
+
+    /// @return number of decoded records
+    size_t getRecordCount() const;
+
+    /// @return number of batches waiting for decoding
+    size_t getQueueDepth() const;
+
+    DropPolicy getPolicy() const;
+
+    static DropPolicy parsePolicy(const std::string& name);
+
+private:
+    struct Batch
+    {
+        std::vector<Byte> data;
+        std::vector<RecordingPacket> packets;
+        bool critical = false;          ///< holds packet of critical category, never evicted
+    };
+
+    struct Worker;
+
+    void decode(Worker& worker);
+    void tag(Worker& worker, const RecordingPacket& packet);
+    void output();
+    /// Runs output action, the first exception is kept for stop()
+    template <typename Action>
+    void guarded(Action action);
+    Batch* acquire(bool critical);
+    /// Discards the oldest waiting non critical batch, nullptr when there is none
+    Batch* evict();
+    void release(Batch* batch);
+    static void idle(unsigned& spins);
+
+    Output _output;
+    OutputSink* _sink = nullptr;
+    DropPolicy _policy;
+    LoadShedder _shedder;
+    std::vector<std::string> _feedNames;
+    std::vector<std::unique_ptr<Batch>> _batches;
+    MpmcQueue<Batch*> _free;
+    MpmcQueue<Batch*> _pending;
+    std::vector<std::unique_ptr<Worker>> _workers;
+    Poco::Thread _outputThread;
+    Poco::RunnableAdapter<DecodePipeline> _outputRunnable;
+    std::atomic<bool> _stopping { false };
+    std::atomic<size_t> _activeWorkers { 0 };
+    std::atomic<size_t> _packetCount { 0 };
+    std::atomic<size_t> _dropCount { 0 };
+    std::exception_ptr _error;
+    bool _running = false;
+};
+
+} /* namespace astlib */
@@ -0,0 +1,202 @@
+///
+/// \package astlib
+/// \file LoadShedder.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "LoadShedder.h"
+#include "astlib/Exception.h"
+
+#include <Poco/NumberParser.h>
+#include <Poco/String.h>
+
+namespace astlib
+{
+
+LoadShedder::LoadShedder()
+{
+    _thresholds[Critical] = 2.0;
+    _thresholds[High] = 0.9;
+    _thresholds[Normal] = 0.75;
+    _thresholds[Low] = 0.5;
+
+    setPriority(2, Critical);
+    setPriority(4, Critical);
+    setPriority(34, Critical);
+    setPriority(1, Low);
+    setPriority(48, Low);
+}
+
+void LoadShedder::setPriority(int category, Priority priority)
+{
+    _rules[checkCategory(category)].priority = priority;
+}
+
+LoadShedder::Priority LoadShedder::getPriority(int category) const
+{
+    return Priority(_rules[checkCategory(category)].priority.load());
+}
+
+void LoadShedder::setQuota(int category, unsigned packetsPerSecond)
+{
+    _rules[checkCategory(category)].quota = packetsPerSecond;
+}
+
+unsigned LoadShedder::getQuota(int category) const
+{
+    return _rules[checkCategory(category)].quota;
+}
+
+void LoadShedder::setThreshold(Priority priority, double load)
+{
+    // Critical data are not shed at any load
+    if (priority != Critical)
+        _thresholds[priority] = load;
+}
+
+double LoadShedder::getThreshold(Priority priority) const
+{
+    return _thresholds[priority];
+}
+
+void LoadShedder::setRule(const std::string& rule)
+{
+    std::string::size_type equal = rule.find('=');
+    if (equal == std::string::npos)
+        throw Exception("LoadShedder::setRule(): missing '=' in " + rule);
+
+    std::string value = rule.substr(equal + 1);
+    unsigned quota = 0;
+    std::string::size_type colon = value.find(':');
+    if (colon != std::string::npos)
+    {
+        if (!Poco::NumberParser::tryParseUnsigned(value.substr(colon + 1), quota))
+            throw Exception("LoadShedder::setRule(): bad quota in " + rule);
+        value.resize(colon);
+    }
+
+    int category = 0;
+    if (!Poco::NumberParser::tryParse(Poco::trim(rule.substr(0, equal)), category))
+        throw Exception("LoadShedder::setRule(): bad category in " + rule);
+
+    setPriority(category, parsePriority(Poco::trim(value)));
+    setQuota(category, quota);
+}
+
+bool LoadShedder::admit(const RecordingPacket& packet, double load)
+{
+    if (packet.size == 0)
+        return true;
+
+    Rule& rule = _rules[packet.data[0]];
+    int priority = rule.priority.load(std::memory_order_relaxed);
+    if (priority == Critical)
+        return true;
+
+    if (load > _thresholds[priority])
+    {
+        rule.shed++;
+        return false;
+    }
+
+    unsigned quota = rule.quota.load(std::memory_order_relaxed);
+    if (quota)
+    {
+        // One second windows of packet time, the first thread in new window resets counter
+        Poco::Int64 second = packet.timestamp.epochMicroseconds() / 1000000;
+        Poco::Int64 window = rule.window.load();
+        if (second > window && rule.window.compare_exchange_strong(window, second))
+            rule.used = 0;
+
+        if (rule.used.fetch_add(1) >= quota)
+        {
+            rule.shed++;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool LoadShedder::isCritical(const RecordingPacket& packet) const
+{
+    return packet.size && _rules[packet.data[0]].priority.load(std::memory_order_relaxed) == Critical;
+}
+
+size_t LoadShedder::getShedCount(int category) const
+{
+    return _rules[checkCategory(category)].shed;
+}
+
+size_t LoadShedder::getShedCount() const
+{
+    size_t count = 0;
+    for(const Rule& rule: _rules)
+        count += rule.shed;
+    return count;
+}
+
+void LoadShedder::countEviction(const RecordingPacket& packet)
+{
+    if (packet.size)
+        _rules[packet.data[0]].evicted++;
+}
+
+size_t LoadShedder::getEvictCount(int category) const
+{
+    return _rules[checkCategory(category)].evicted;
+}
+
+size_t LoadShedder::getEvictCount() const
+{
+    size_t count = 0;
+    for(const Rule& rule: _rules)
+        count += rule.evicted;
+    return count;
+}
+
+void LoadShedder::countDrop(const RecordingPacket& packet)
+{
+    if (packet.size)
+        _rules[packet.data[0]].dropped++;
+}
+
+size_t LoadShedder::getDropCount(int category) const
+{
+    return _rules[checkCategory(category)].dropped;
+}
+
+size_t LoadShedder::getDropCount() const
+{
+    size_t count = 0;
+    for(const Rule& rule: _rules)
+        count += rule.dropped;
+    return count;
+}
+
+LoadShedder::Priority LoadShedder::parsePriority(const std::string& name)
+{
+    std::string lower = Poco::toLower(name);
+    if (lower == "critical")
+        return Critical;
+    if (lower == "high")
+        return High;
+    if (lower == "normal")
+        return Normal;
+    if (lower == "low")
+        return Low;
+    throw Exception("LoadShedder::parsePriority(): unknown priority " + name);
+}
+
+int LoadShedder::checkCategory(int category)
+{
+    if (category < 0 || category > 255)
+        throw Exception("LoadShedder::checkCategory(): category out of range " + std::to_string(category));
+    return category;
+}
+
+} /* namespace astlib */
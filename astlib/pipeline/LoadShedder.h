@@ -0,0 +1,120 @@
+///
+/// \package astlib
+/// \file LoadShedder.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "astlib/recording/RecordingPacket.h"
+
+#include <atomic>
+#include <string>
+
+namespace astlib
+{
+
+/**
+ * Priority aware admission of datagrams into the decode pipeline. Datagram is classified
+ * by the category of its first data block, buf[0], without decoding. When the pipeline
+ * is loaded, categories are shed from the lowest priority up, Critical ones are never shed.
+ * Optional quota limits packets per second of one category regardless of load.
+ *
+ * Default priorities keep safety nets (cat004) and service messages with north markers
+ * (cat002, cat034) as Critical and shed plots (cat001, cat048) first.
+ */
+class ASTLIB_API LoadShedder
+{
+public:
+    enum Priority {
+        Critical,   ///< never shed, pipeline keeps reserved batches for them
+        High,
+        Normal,
+        Low
+    };
+
+    LoadShedder();
+
+    void setPriority(int category, Priority priority);
+    Priority getPriority(int category) const;
+
+    /**
+     * @param packetsPerSecond quota by packet timestamps, zero disables quota
+     */
+    void setQuota(int category, unsigned packetsPerSecond);
+    unsigned getQuota(int category) const;
+
+    /**
+     * Sets queue load from which priority is shed.
+     * @param load fill ratio of decode queue from 0.0 to 1.0
+     */
+    void setThreshold(Priority priority, double load);
+    double getThreshold(Priority priority) const;
+
+    /**
+     * Applies rule "category=priority[:quota]", e.g. "48=low:5000", throws Exception when malformed.
+     */
+    void setRule(const std::string& rule);
+
+    /**
+     * Decides whether packet may be queued, safe to call from several threads.
+     * @param load current fill ratio of decode queue
+     */
+    bool admit(const RecordingPacket& packet, double load);
+
+    bool isCritical(const RecordingPacket& packet) const;
+
+    /// @return number of packets shed for category
+    size_t getShedCount(int category) const;
+
+    /// @return number of packets shed for all categories
+    size_t getShedCount() const;
+
+    /**
+     * Counts admitted packet discarded later with a batch evicted by the drop policy.
+     */
+    void countEviction(const RecordingPacket& packet);
+
+    /// @return number of evicted packets of category
+    size_t getEvictCount(int category) const;
+
+    /// @return number of evicted packets of all categories
+    size_t getEvictCount() const;
+
+    /**
+     * Counts admitted packet discarded by the drop policy for lack of free batch.
+     */
+    void countDrop(const RecordingPacket& packet);
+
+    /// @return number of dropped packets of category
+    size_t getDropCount(int category) const;
+
+    /// @return number of dropped packets of all categories
+    size_t getDropCount() const;
+
+    static Priority parsePriority(const std::string& name);
+
+private:
+    struct Rule
+    {
+        std::atomic<int> priority { Normal };
+        std::atomic<unsigned> quota { 0 };
+        std::atomic<Poco::Int64> window { 0 };
+        std::atomic<unsigned> used { 0 };
+        std::atomic<size_t> shed { 0 };
+        std::atomic<size_t> evicted { 0 };
+        std::atomic<size_t> dropped { 0 };
+    };
+
+    static int checkCategory(int category);
+
+    Rule _rules[256];
+    double _thresholds[Low + 1];
+};
+
+} /* namespace astlib */
@@ -0,0 +1,156 @@
+///
+/// \package astlib
+/// \file MpmcQueue.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace astlib
+{
+
+/**
+ * Bounded lock-free queue for any number of producers and consumers (D. Vyukov).
+ * Every slot carries a sequence number telling whether it is ready for push
+ * or pop in the current lap, so threads only contend on one CAS per operation.
+ * Capacity is rounded up to the power of two.
+ */
+template<typename T>
+class MpmcQueue
+{
+public:
+    explicit MpmcQueue(size_t capacity) :
+        _mask(roundUp(capacity) - 1),
+        _cells(new Cell[_mask + 1])
+    {
+        for(size_t i = 0; i <= _mask; i++)
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    /**
+     * @return false when queue is full, value is left untouched
+     */
+    bool push(T&& value)
+    {
+        size_t position = _tail.load(std::memory_order_relaxed);
+        for(;;)
+        {
+            Cell& cell = _cells[position & _mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(position);
+            if (diff == 0)
+            {
+                if (_tail.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    cell.value = std::move(value);
+                    cell.sequence.store(position + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = _tail.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool push(const T& value)
+    {
+        T copy(value);
+        return push(std::move(copy));
+    }
+
+    /**
+     * @return false when queue is empty
+     */
+    bool pop(T& value)
+    {
+        size_t position = _head.load(std::memory_order_relaxed);
+        for(;;)
+        {
+            Cell& cell = _cells[position & _mask];
+            size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            std::ptrdiff_t diff = std::ptrdiff_t(sequence) - std::ptrdiff_t(position + 1);
+            if (diff == 0)
+            {
+                if (_head.compare_exchange_weak(position, position + 1, std::memory_order_relaxed))
+                {
+                    value = std::move(cell.value);
+                    cell.sequence.store(position + _mask + 1, std::memory_order_release);
+                    return true;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                position = _head.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    /// @return approximate number of queued values
+    size_t size() const
+    {
+        size_t tail = _tail.load(std::memory_order_acquire);
+        size_t head = _head.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    size_t capacity() const
+    {
+        return _mask + 1;
+    }
+
+private:
+    static size_t roundUp(size_t value)
+    {
+        size_t result = 2;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+    enum { CACHE_LINE = 64 };
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        T value;
+    };
+
+    const size_t _mask;
+    std::unique_ptr<Cell[]> _cells;
+
+    char _pad0[CACHE_LINE];
+    std::atomic<size_t> _head { 0 };
+    char _pad1[CACHE_LINE];
+    std::atomic<size_t> _tail { 0 };
+    char _pad2[CACHE_LINE];
+};
+
+} /* namespace astlib */
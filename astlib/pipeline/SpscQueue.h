@@ -0,0 +1,123 @@
+///
+/// \package astlib
+/// \file SpscQueue.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace astlib
+{
+
+/**
+ * Bounded lock-free queue for exactly one producer and one consumer thread.
+ * Capacity is rounded up to the power of two. Each side keeps a cached copy
+ * of the opposite index, so the shared cache line is read only when the
+ * queue looks full or empty.
+ */
+template<typename T>
+class SpscQueue
+{
+public:
+    explicit SpscQueue(size_t capacity) :
+        _mask(roundUp(capacity) - 1),
+        _slots(_mask + 1)
+    {
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    /**
+     * Producer side.
+     * @return false when queue is full, value is left untouched
+     */
+    bool push(T&& value)
+    {
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _headCache > _mask)
+        {
+            _headCache = _head.load(std::memory_order_acquire);
+            if (tail - _headCache > _mask)
+                return false;
+        }
+        _slots[tail & _mask] = std::move(value);
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool push(const T& value)
+    {
+        T copy(value);
+        return push(std::move(copy));
+    }
+
+    /**
+     * Consumer side.
+     * @return false when queue is empty
+     */
+    bool pop(T& value)
+    {
+        size_t head = _head.load(std::memory_order_relaxed);
+        if (head == _tailCache)
+        {
+            _tailCache = _tail.load(std::memory_order_acquire);
+            if (head == _tailCache)
+                return false;
+        }
+        value = std::move(_slots[head & _mask]);
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @return approximate number of queued values, exact only from a quiet queue
+    size_t size() const
+    {
+        return _tail.load(std::memory_order_acquire) - _head.load(std::memory_order_acquire);
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    size_t capacity() const
+    {
+        return _mask + 1;
+    }
+
+private:
+    static size_t roundUp(size_t value)
+    {
+        size_t result = 2;
+        while (result < value)
+            result <<= 1;
+        return result;
+    }
+
+    enum { CACHE_LINE = 64 };
+
+    const size_t _mask;
+    std::vector<T> _slots;
+
+    // Consumer and producer indexes live on separate cache lines
+    char _pad0[CACHE_LINE];
+    std::atomic<size_t> _head { 0 };
+    size_t _tailCache = 0;
+    char _pad1[CACHE_LINE];
+    std::atomic<size_t> _tail { 0 };
+    size_t _headCache = 0;
+    char _pad2[CACHE_LINE];
+};
+
+} /* namespace astlib */
@@ -0,0 +1,100 @@
+///
+/// \package astlib
+/// \file ArchiveIndex.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "ArchiveIndex.h"
+
+#include <Poco/NumberFormatter.h>
+#include <cstring>
+
+namespace astlib
+{
+
+const char ArchiveIndexEntry::MAGIC[8] = { 'A', 'S', 'T', 'I', 'D', 'X', '0', '1' };
+
+static void storeLittleEndian(Byte buffer[], Poco::UInt64 value, size_t len)
+{
+    for(size_t i = 0; i < len; i++)
+        buffer[i] = Byte(value >> (8 * i));
+}
+
+static Poco::UInt64 loadLittleEndian(const Byte buffer[], size_t len)
+{
+    Poco::UInt64 value = 0;
+    for(size_t i = len; i > 0; i--)
+        value = (value << 8) | buffer[i - 1];
+    return value;
+}
+
+void ArchiveIndexEntry::store(Byte buffer[]) const
+{
+    storeLittleEndian(buffer, Poco::UInt64(time), 8);
+    storeLittleEndian(buffer + 8, offset, 4);
+    storeLittleEndian(buffer + 12, length, 2);
+    buffer[14] = category;
+    buffer[15] = flags;
+    buffer[16] = sac;
+    buffer[17] = sic;
+    buffer[18] = 0;
+    buffer[19] = 0;
+}
+
+void ArchiveIndexEntry::load(const Byte buffer[])
+{
+    time = Poco::Int64(loadLittleEndian(buffer, 8));
+    offset = Poco::UInt32(loadLittleEndian(buffer + 8, 4));
+    length = Poco::UInt16(loadLittleEndian(buffer + 12, 2));
+    category = buffer[14];
+    flags = buffer[15];
+    sac = buffer[16];
+    sic = buffer[17];
+}
+
+void ArchiveIndexEntry::describe(const Byte block[], size_t bytes)
+{
+    category = block[0];
+    flags = 0;
+    sac = sic = 0;
+
+    if (bytes < 4)
+        return;
+
+    size_t fspecLen = ByteUtils::scanFxChain(block + 3, bytes - 3);
+    if (fspecLen && (block[3] & 0x80) && 3 + fspecLen + 2 <= bytes)
+    {
+        sac = block[3 + fspecLen];
+        sic = block[3 + fspecLen + 1];
+        flags |= HasSource;
+    }
+}
+
+Poco::Int64 ArchiveIndexEntry::loadTime(const Byte buffer[])
+{
+    return Poco::Int64(loadLittleEndian(buffer, 8));
+}
+
+void ArchiveIndexEntry::storeHeader(Byte buffer[])
+{
+    memcpy(buffer, MAGIC, sizeof(MAGIC));
+    storeLittleEndian(buffer + 8, SIZE, 4);
+    storeLittleEndian(buffer + 12, 0, 4);
+}
+
+bool ArchiveIndexEntry::checkHeader(const Byte buffer[], size_t bytes)
+{
+    return bytes >= HEADER_SIZE && memcmp(buffer, MAGIC, sizeof(MAGIC)) == 0 && loadLittleEndian(buffer + 8, 4) == SIZE;
+}
+
+std::string ArchiveIndexEntry::segmentName(int segment, const char* extension)
+{
+    return Poco::NumberFormatter::format0(segment, 6) + extension;
+}
+
+} /* namespace astlib */
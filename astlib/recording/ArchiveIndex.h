@@ -0,0 +1,67 @@
+///
+/// \package astlib
+/// \file ArchiveIndex.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "astlib/ByteUtils.h"
+
+#include <Poco/Types.h>
+#include <string>
+
+namespace astlib
+{
+
+/**
+ * On-disk layout of indexed archive. Archive is a directory with numbered segments, each segment
+ * is a pair of files:
+ * - NNNNNN.dat with raw data blocks stored back to back
+ * - NNNNNN.idx with HEADER_SIZE bytes header followed by fixed size little endian entries,
+ *   one per data block in receive order
+ */
+struct ASTLIB_API ArchiveIndexEntry
+{
+    static constexpr size_t SIZE = 20;
+    static constexpr size_t HEADER_SIZE = 16;
+    static const char MAGIC[8];
+
+    /// Entry flags
+    enum Flags
+    {
+        HasSource = 1   ///< SAC/SIC were found in the first record
+    };
+
+    Poco::Int64 time = 0;       ///< receive time, microseconds since epoch
+    Poco::UInt32 offset = 0;    ///< offset of data block in segment data file
+    Poco::UInt16 length = 0;    ///< data block length (LEN)
+    Poco::UInt8 category = 0;
+    Poco::UInt8 flags = 0;
+    Poco::UInt8 sac = 0;
+    Poco::UInt8 sic = 0;
+
+    void store(Byte buffer[]) const;
+    void load(const Byte buffer[]);
+
+    /**
+     * Fills category and data source from data block. SAC/SIC is taken from the I010 item
+     * at FRN 1 of the first record, which is the layout of all standard categories.
+     */
+    void describe(const Byte block[], size_t length);
+
+    /// @return time of entry stored at buffer without full decoding
+    static Poco::Int64 loadTime(const Byte buffer[]);
+
+    static void storeHeader(Byte buffer[]);
+    static bool checkHeader(const Byte buffer[], size_t bytes);
+
+    static std::string segmentName(int segment, const char* extension);
+};
+
+} /* namespace astlib */
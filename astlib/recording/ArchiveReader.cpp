@@ -0,0 +1,183 @@
+///
+/// \package astlib
+/// \file ArchiveReader.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "ArchiveReader.h"
+#include "astlib/Exception.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+#include <algorithm>
+
+namespace astlib
+{
+
+ArchiveReader::ArchiveReader(const std::string& directory)
+{
+    Poco::Path path(directory);
+    path.makeDirectory();
+
+    for(int number = 0; ; number++)
+    {
+        Poco::File indexFile(path.setFileName(ArchiveIndexEntry::segmentName(number, ".idx")).toString());
+        Poco::File dataFile(path.setFileName(ArchiveIndexEntry::segmentName(number, ".dat")).toString());
+
+        if (!indexFile.exists() || !dataFile.exists())
+            break;
+
+        // Empty files can't be mapped and have nothing to query
+        if (indexFile.getSize() <= ArchiveIndexEntry::HEADER_SIZE || dataFile.getSize() == 0)
+            continue;
+
+        std::unique_ptr<Segment> segment(new Segment);
+        Poco::SharedMemory indexMemory(indexFile, Poco::SharedMemory::AM_READ);
+        Poco::SharedMemory dataMemory(dataFile, Poco::SharedMemory::AM_READ);
+        segment->indexMemory.swap(indexMemory);
+        segment->dataMemory.swap(dataMemory);
+
+        const Byte* index = reinterpret_cast<const Byte*>(segment->indexMemory.begin());
+        size_t indexSize = size_t(segment->indexMemory.end() - segment->indexMemory.begin());
+        if (!ArchiveIndexEntry::checkHeader(index, indexSize))
+            throw Exception("ArchiveReader: bad index " + indexFile.path());
+
+        segment->data = reinterpret_cast<const Byte*>(segment->dataMemory.begin());
+        segment->dataSize = size_t(segment->dataMemory.end() - segment->dataMemory.begin());
+        segment->entries = index + ArchiveIndexEntry::HEADER_SIZE;
+        // Partially written last entry is ignored
+        segment->count = (indexSize - ArchiveIndexEntry::HEADER_SIZE) / ArchiveIndexEntry::SIZE;
+        if (segment->count == 0)
+            continue;
+
+        segment->first = segment->last = ArchiveIndexEntry::loadTime(segment->entries);
+        for(size_t i = 1; i < segment->count; i++)
+        {
+            Poco::Timestamp::TimeVal time = ArchiveIndexEntry::loadTime(segment->entries + i * ArchiveIndexEntry::SIZE);
+            if (time < segment->last)
+                segment->sorted = false;
+            segment->first = std::min(segment->first, time);
+            segment->last = std::max(segment->last, time);
+        }
+
+        _blocks += segment->count;
+        _segments.push_back(std::move(segment));
+    }
+
+    if (_segments.empty())
+        throw Exception("ArchiveReader: no segments in " + directory);
+}
+
+ArchiveReader::~ArchiveReader()
+{
+}
+
+size_t ArchiveReader::Segment::lowerBound(Poco::Timestamp::TimeVal time) const
+{
+    if (!sorted)
+        return 0;
+
+    size_t low = 0;
+    size_t high = count;
+    while(low < high)
+    {
+        size_t middle = low + (high - low) / 2;
+        if (ArchiveIndexEntry::loadTime(entries + middle * ArchiveIndexEntry::SIZE) < time)
+            low = middle + 1;
+        else
+            high = middle;
+    }
+    return low;
+}
+
+template <class Function>
+void ArchiveReader::forEach(const Query& query, Function function) const
+{
+    for(const auto& segment: _segments)
+    {
+        if (segment->last < query.from || segment->first >= query.to)
+            continue;
+
+        for(size_t i = segment->lowerBound(query.from); i < segment->count; i++)
+        {
+            ArchiveIndexEntry entry;
+            entry.load(segment->entries + i * ArchiveIndexEntry::SIZE);
+
+            if (entry.time >= query.to)
+            {
+                if (segment->sorted)
+                    break;
+                continue;
+            }
+            if (entry.time < query.from)
+                continue;
+            if (query.category >= 0 && entry.category != query.category)
+                continue;
+            if ((query.sac >= 0 || query.sic >= 0) && !(entry.flags & ArchiveIndexEntry::HasSource))
+                continue;
+            if ((query.sac >= 0 && entry.sac != query.sac) || (query.sic >= 0 && entry.sic != query.sic))
+                continue;
+            if (size_t(entry.offset) + entry.length > segment->dataSize)
+                continue;
+
+            RecordingPacket packet;
+            packet.timestamp = entry.time;
+            packet.data = segment->data + entry.offset;
+            packet.size = entry.length;
+            function(packet);
+        }
+    }
+}
+
+size_t ArchiveReader::query(const Query& query, std::vector<RecordingPacket>& packets) const
+{
+    size_t count = 0;
+    forEach(query, [&](const RecordingPacket& packet) {
+        packets.push_back(packet);
+        count++;
+    });
+    return count;
+}
+
+DatagramDecoder::Result ArchiveReader::decode(const Query& query, DatagramDecoder& decoder, ValueDecoder& valueDecoder) const
+{
+    DatagramDecoder::Result result;
+    forEach(query, [&](const RecordingPacket& packet) {
+        valueDecoder.setTimestamp(packet.timestamp);
+        result += decoder.decode(valueDecoder, packet.data, packet.size);
+    });
+    return result;
+}
+
+size_t ArchiveReader::getSegmentCount() const
+{
+    return _segments.size();
+}
+
+size_t ArchiveReader::getBlockCount() const
+{
+    return _blocks;
+}
+
+Poco::Timestamp::TimeVal ArchiveReader::getStartTime() const
+{
+    Poco::Timestamp::TimeVal time = _segments.front()->first;
+    for(const auto& segment: _segments)
+        time = std::min(time, segment->first);
+    return time;
+}
+
+Poco::Timestamp::TimeVal ArchiveReader::getEndTime() const
+{
+    Poco::Timestamp::TimeVal time = _segments.front()->last;
+    for(const auto& segment: _segments)
+        time = std::max(time, segment->last);
+    return time + 1;
+}
+
+} /* namespace astlib */
@@ -0,0 +1,94 @@
+///
+/// \package astlib
+/// \file ArchiveReader.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "ArchiveIndex.h"
+#include "RecordingPacket.h"
+#include "astlib/decoder/DatagramDecoder.h"
+
+#include <Poco/SharedMemory.h>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace astlib
+{
+
+/**
+ * Memory mapped reader of indexed archive written by ArchiveWriter.
+ * Queries skip whole segments by their time range and binary search index entries,
+ * data files are touched only for matching blocks.
+ */
+class ASTLIB_API ArchiveReader
+{
+public:
+    /**
+     * Range query, negative values match anything.
+     */
+    struct Query
+    {
+        Poco::Timestamp::TimeVal from = 0;                  ///< inclusive, microseconds since epoch
+        Poco::Timestamp::TimeVal to = 0x7FFFFFFFFFFFFFFFLL; ///< exclusive
+        int category = -1;
+        int sac = -1;
+        int sic = -1;
+    };
+
+    /**
+     * Maps all segments of archive, throws Exception when there is no valid segment.
+     */
+    explicit ArchiveReader(const std::string& directory);
+    ~ArchiveReader();
+
+    /**
+     * Appends matching data blocks in archive order, packets point into mapped segments.
+     * @return number of found blocks
+     */
+    size_t query(const Query& query, std::vector<RecordingPacket>& packets) const;
+
+    /**
+     * Decodes matching data blocks, receive time is passed by ValueDecoder::setTimestamp().
+     */
+    DatagramDecoder::Result decode(const Query& query, DatagramDecoder& decoder, ValueDecoder& valueDecoder) const;
+
+    size_t getSegmentCount() const;
+    size_t getBlockCount() const;
+
+    /// @return receive time of the first and after the last block
+    Poco::Timestamp::TimeVal getStartTime() const;
+    Poco::Timestamp::TimeVal getEndTime() const;
+
+private:
+    struct Segment
+    {
+        Poco::SharedMemory dataMemory;
+        Poco::SharedMemory indexMemory;
+        const Byte* data = nullptr;
+        size_t dataSize = 0;
+        const Byte* entries = nullptr;
+        size_t count = 0;
+        Poco::Timestamp::TimeVal first = 0;
+        Poco::Timestamp::TimeVal last = 0;
+        bool sorted = true;     ///< entries are in non decreasing time order
+
+        /// @return index of first entry with time not less than time
+        size_t lowerBound(Poco::Timestamp::TimeVal time) const;
+    };
+
+    template <class Function>
+    void forEach(const Query& query, Function function) const;
+
+    std::vector<std::unique_ptr<Segment>> _segments;
+    size_t _blocks = 0;
+};
+
+} /* namespace astlib */
@@ -0,0 +1,147 @@
+///
+/// \package astlib
+/// \file ArchiveWriter.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "ArchiveWriter.h"
+#include "astlib/Exception.h"
+
+#include <Poco/File.h>
+#include <Poco/Path.h>
+
+namespace astlib
+{
+
+ArchiveWriter::ArchiveWriter(const std::string& directory, size_t segmentSize) :
+    _directory(directory),
+    _segmentSize(segmentSize)
+{
+    Poco::File(directory).createDirectories();
+
+    // Continue after last existing segment
+    while(Poco::File(Poco::Path(directory).makeDirectory().setFileName(ArchiveIndexEntry::segmentName(_segment, ".idx")).toString()).exists())
+        _segment++;
+}
+
+ArchiveWriter::~ArchiveWriter()
+{
+    try
+    {
+        close();
+    }
+    catch(...)
+    {
+    }
+}
+
+size_t ArchiveWriter::write(const Poco::Timestamp& time, const Byte buf[], size_t bytes)
+{
+    size_t blocks = 0;
+    size_t offset = 0;
+
+    while(offset + 3 <= bytes)
+    {
+        size_t length = (size_t(buf[offset + 1]) << 8) | buf[offset + 2];
+        if (length < 3 || length > bytes - offset)
+            break;
+
+        if (!_open || _dataSize + length > _segmentSize)
+        {
+            close();
+            openSegment();
+        }
+
+        ArchiveIndexEntry entry;
+        entry.time = time.epochMicroseconds();
+        entry.offset = Poco::UInt32(_dataSize);
+        entry.length = Poco::UInt16(length);
+        entry.describe(buf + offset, length);
+
+        size_t position = _entries.size();
+        _entries.resize(position + ArchiveIndexEntry::SIZE);
+        entry.store(_entries.data() + position);
+
+        _data.write(reinterpret_cast<const char*>(buf + offset), length);
+        _dataSize += length;
+        offset += length;
+        blocks++;
+    }
+
+    _dropped += bytes - offset;
+
+    if (_entries.size() >= 4096 * ArchiveIndexEntry::SIZE)
+    {
+        // Index stream may reach the file any time after write, data must be there before
+        _data.flush();
+        _index.write(reinterpret_cast<const char*>(_entries.data()), _entries.size());
+        _entries.clear();
+    }
+
+    return blocks;
+}
+
+void ArchiveWriter::flush()
+{
+    if (!_open)
+        return;
+
+    // Data first, so that index never points behind end of data file
+    _data.flush();
+    _index.write(reinterpret_cast<const char*>(_entries.data()), _entries.size());
+    _entries.clear();
+    _index.flush();
+
+    if (!_data || !_index)
+        throw Exception("ArchiveWriter: write error in " + _directory);
+}
+
+void ArchiveWriter::close()
+{
+    if (!_open)
+        return;
+
+    flush();
+    _data.close();
+    _index.close();
+    _open = false;
+}
+
+void ArchiveWriter::openSegment()
+{
+    Poco::Path path(_directory);
+    path.makeDirectory();
+
+    std::string dataPath = path.setFileName(ArchiveIndexEntry::segmentName(_segment, ".dat")).toString();
+    std::string indexPath = path.setFileName(ArchiveIndexEntry::segmentName(_segment, ".idx")).toString();
+
+    _data.open(dataPath, std::ios::binary | std::ios::trunc);
+    _index.open(indexPath, std::ios::binary | std::ios::trunc);
+    if (!_data || !_index)
+        throw Exception("ArchiveWriter: cannot create segment " + indexPath);
+
+    Byte header[ArchiveIndexEntry::HEADER_SIZE];
+    ArchiveIndexEntry::storeHeader(header);
+    _index.write(reinterpret_cast<const char*>(header), sizeof(header));
+
+    _segment++;
+    _dataSize = 0;
+    _open = true;
+}
+
+int ArchiveWriter::getSegmentCount() const
+{
+    return _segment;
+}
+
+size_t ArchiveWriter::getDroppedBytes() const
+{
+    return _dropped;
+}
+
+} /* namespace astlib */
@@ -0,0 +1,74 @@
+///
+/// \package astlib
+/// \file ArchiveWriter.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "ArchiveIndex.h"
+
+#include <Poco/Timestamp.h>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace astlib
+{
+
+/**
+ * Appends received data blocks to indexed archive (see ArchiveIndexEntry for layout).
+ * Existing archive is continued with new segment.
+ */
+class ASTLIB_API ArchiveWriter
+{
+public:
+    static constexpr size_t DEFAULT_SEGMENT_SIZE = 64 << 20;
+
+    /**
+     * Opens archive directory, creates it when it doesn't exist.
+     * @param segmentSize size of data file when new segment is started
+     */
+    ArchiveWriter(const std::string& directory, size_t segmentSize = DEFAULT_SEGMENT_SIZE);
+    ~ArchiveWriter();
+
+    /**
+     * Stores all data blocks of datagram, each one gets its own index entry.
+     * Bytes not forming valid data block are dropped.
+     * @return number of stored data blocks
+     */
+    size_t write(const Poco::Timestamp& time, const Byte buf[], size_t bytes);
+
+    /**
+     * Writes buffered data of current segment to disk.
+     */
+    void flush();
+
+    /**
+     * Closes current segment, next write starts a new one.
+     */
+    void close();
+
+    int getSegmentCount() const;
+    size_t getDroppedBytes() const;
+
+private:
+    void openSegment();
+
+    std::string _directory;
+    size_t _segmentSize;
+    int _segment = 0;           ///< number of the next segment
+    bool _open = false;
+    std::ofstream _data;
+    std::ofstream _index;
+    size_t _dataSize = 0;
+    size_t _dropped = 0;
+    std::vector<Byte> _entries; ///< index entries not written yet
+};
+
+} /* namespace astlib */
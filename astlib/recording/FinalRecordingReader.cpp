@@ -0,0 +1,104 @@
+///
+/// \package astlib
+/// \file FinalRecordingReader.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "FinalRecordingReader.h"
+
+namespace astlib
+{
+
+static const size_t HEADER_SIZE = 8;
+static const size_t TRAILER_SIZE = 4;
+static const Byte TRAILER_BYTE = 0xA5;
+static const Poco::Int64 DAY = 86400LL * 1000000;
+
+FinalRecordingReader::FinalRecordingReader(const std::string& path, Poco::Timestamp::TimeVal date) :
+    RecordingReader(path, HEADER_SIZE + TRAILER_SIZE),
+    _date(date)
+{
+    rewind();
+}
+
+FinalRecordingReader::~FinalRecordingReader()
+{
+}
+
+bool FinalRecordingReader::next(RecordingPacket& packet)
+{
+    while (_ptr < _end)
+    {
+        size_t length = recordLength(_ptr, size_t(_end - _ptr));
+        if (length == 0)
+        {
+            _ptr++;
+            _skipped++;
+            continue;
+        }
+
+        // Days are counted modulo 256 in the header
+        int day = _ptr[4];
+        if (_firstDay < 0)
+            _firstDay = day;
+        Poco::Int64 days = (day - _firstDay + 256) % 256;
+        Poco::Int64 ticks = Poco::Int64(ByteUtils::loadBigEndian(_ptr + 5, 3));
+
+        packet.timestamp = _date + days * DAY + ticks * 10000;
+        packet.data = _ptr + HEADER_SIZE;
+        packet.size = length - HEADER_SIZE - TRAILER_SIZE;
+        packet.sourcePort = 0;
+        packet.destinationPort = 0;
+        packet.sourceAddress = 0;
+        _ptr += length;
+        _packets++;
+        return true;
+    }
+    return false;
+}
+
+void FinalRecordingReader::rewind()
+{
+    _ptr = _begin;
+    _firstDay = -1;
+    _packets = 0;
+    _skipped = 0;
+}
+
+const char* FinalRecordingReader::getFormatName() const
+{
+    return "final";
+}
+
+bool FinalRecordingReader::probe(const Byte head[], size_t bytes)
+{
+    return recordLength(head, bytes) != 0;
+}
+
+size_t FinalRecordingReader::recordLength(const Byte data[], size_t bytes)
+{
+    if (bytes < HEADER_SIZE + TRAILER_SIZE)
+        return 0;
+
+    size_t length = size_t(ByteUtils::loadBigEndian(data, 2));
+    // At least data block header must be present
+    if (length < HEADER_SIZE + 3 + TRAILER_SIZE || length > bytes)
+        return 0;
+
+    const Byte* trailer = data + length - TRAILER_SIZE;
+    if (trailer[0] != TRAILER_BYTE || trailer[1] != TRAILER_BYTE || trailer[2] != TRAILER_BYTE || trailer[3] != TRAILER_BYTE)
+        return 0;
+
+    // Time of day is less than 24 hours
+    if (ByteUtils::loadBigEndian(data + 5, 3) >= 8640000)
+        return 0;
+
+    return length;
+}
+
+} /* namespace astlib */
@@ -0,0 +1,53 @@
+///
+/// \package astlib
+/// \file FinalRecordingReader.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "RecordingReader.h"
+
+namespace astlib
+{
+
+/**
+ * Reader of FINAL recordings. Each record has 8 bytes header (record length including header
+ * and trailer, board, line, recording day, time of day in 10 ms units) followed by asterix
+ * data and 0xA5A5A5A5 trailer. Corrupted record is skipped byte by byte until next valid one,
+ * getSkippedCount() returns number of skipped bytes.
+ */
+class ASTLIB_API FinalRecordingReader :
+    public RecordingReader
+{
+public:
+    /**
+     * @param date midnight of the first recording day, microseconds since epoch
+     */
+    explicit FinalRecordingReader(const std::string& path, Poco::Timestamp::TimeVal date = 0);
+    ~FinalRecordingReader();
+
+    virtual bool next(RecordingPacket& packet);
+    virtual void rewind();
+    virtual const char* getFormatName() const;
+
+    /**
+     * @return true when head of file starts with complete FINAL record
+     */
+    static bool probe(const Byte head[], size_t bytes);
+
+private:
+    /// @return length of record or zero when record is corrupted
+    static size_t recordLength(const Byte data[], size_t bytes);
+
+    Poco::Timestamp::TimeVal _date;
+    int _firstDay = -1;
+    const Byte* _ptr = nullptr;
+};
+
+} /* namespace astlib */
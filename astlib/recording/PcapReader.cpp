@@ -0,0 +1,394 @@
+///
+/// \package astlib
+/// \file PcapReader.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "PcapReader.h"
+#include "astlib/Exception.h"
+
+#include <algorithm>
+
+namespace astlib
+{
+
+// Classic pcap magic numbers, microsecond and nanosecond resolution
+static const Poco::UInt32 PCAP_MAGIC = 0xA1B2C3D4;
+static const Poco::UInt32 PCAP_MAGIC_NANO = 0xA1B23C4D;
+static const size_t PCAP_HEADER_SIZE = 24;
+static const size_t PCAP_RECORD_SIZE = 16;
+
+// pcapng block types
+static const Poco::UInt32 SECTION_HEADER_BLOCK = 0x0A0D0D0A;
+static const Poco::UInt32 INTERFACE_BLOCK = 0x00000001;
+static const Poco::UInt32 PACKET_BLOCK = 0x00000002;
+static const Poco::UInt32 SIMPLE_PACKET_BLOCK = 0x00000003;
+static const Poco::UInt32 ENHANCED_PACKET_BLOCK = 0x00000006;
+static const Poco::UInt32 BYTE_ORDER_MAGIC = 0x1A2B3C4D;
+
+const int PcapReader::LINKTYPE_ETHERNET;
+const int PcapReader::LINKTYPE_RAW;
+const int PcapReader::LINKTYPE_LINUX_SLL;
+const int PcapReader::LINKTYPE_IPV4;
+const int PcapReader::LINKTYPE_IPV6;
+
+static const int IPPROTO_UDP_NUMBER = 17;
+
+static Poco::UInt32 loadLittleEndian32(const Byte ptr[])
+{
+    return Poco::UInt32(ptr[0]) | (Poco::UInt32(ptr[1]) << 8) | (Poco::UInt32(ptr[2]) << 16) | (Poco::UInt32(ptr[3]) << 24);
+}
+
+PcapReader::PcapReader(const std::string& path) :
+    RecordingReader(path, PCAP_HEADER_SIZE)
+{
+    Poco::UInt32 magic = loadLittleEndian32(_begin);
+
+    if (magic == SECTION_HEADER_BLOCK)
+    {
+        _nextGeneration = true;
+    }
+    else
+    {
+        Poco::UInt32 swappedMagic = Poco::UInt32(ByteUtils::loadBigEndian(_begin, 4));
+
+        if (magic == PCAP_MAGIC || magic == PCAP_MAGIC_NANO)
+            _bigEndian = false;
+        else if (swappedMagic == PCAP_MAGIC || swappedMagic == PCAP_MAGIC_NANO)
+            _bigEndian = true;
+        else
+            throw Exception("PcapReader: file '" + path + "' is not pcap or pcapng capture");
+
+        bool nano = (magic == PCAP_MAGIC_NANO || swappedMagic == PCAP_MAGIC_NANO);
+        _interfaces.push_back(Interface{int(load32(_begin + 20) & 0xFFFF), nano ? 1000000000U : 1000000U, 0});
+    }
+
+    rewind();
+}
+
+PcapReader::~PcapReader()
+{
+}
+
+void PcapReader::setPortFilter(int port)
+{
+    _port = port;
+}
+
+void PcapReader::rewind()
+{
+    _ptr = _nextGeneration ? _begin : _begin + PCAP_HEADER_SIZE;
+    _packets = 0;
+    _skipped = 0;
+}
+
+bool PcapReader::next(RecordingPacket& packet)
+{
+    Frame frame;
+
+    while(nextFrame(frame))
+    {
+        if (parseUdp(frame.linkType, frame.data, frame.size, _port, packet))
+        {
+            packet.timestamp = frame.time;
+            _packets++;
+            return true;
+        }
+        _skipped++;
+    }
+    return false;
+}
+
+const char* PcapReader::getFormatName() const
+{
+    return _nextGeneration ? "pcapng" : "pcap";
+}
+
+bool PcapReader::isNextGeneration() const
+{
+    return _nextGeneration;
+}
+
+bool PcapReader::probe(const Byte head[], size_t bytes)
+{
+    if (bytes < PCAP_HEADER_SIZE)
+        return false;
+
+    Poco::UInt32 magic = loadLittleEndian32(head);
+    Poco::UInt32 swappedMagic = Poco::UInt32(ByteUtils::loadBigEndian(head, 4));
+
+    return magic == SECTION_HEADER_BLOCK || magic == PCAP_MAGIC || magic == PCAP_MAGIC_NANO
+        || swappedMagic == PCAP_MAGIC || swappedMagic == PCAP_MAGIC_NANO;
+}
+
+bool PcapReader::nextFrame(Frame& frame)
+{
+    return _nextGeneration ? nextGenerationFrame(frame) : nextClassicFrame(frame);
+}
+
+bool PcapReader::nextClassicFrame(Frame& frame)
+{
+    if (size_t(_end - _ptr) < PCAP_RECORD_SIZE)
+        return false;
+
+    const Interface& iface = _interfaces.front();
+    Poco::UInt64 seconds = load32(_ptr);
+    Poco::UInt64 fraction = load32(_ptr + 4);
+    size_t captured = load32(_ptr + 8);
+
+    // Truncated last record ends the capture
+    if (size_t(_end - _ptr) - PCAP_RECORD_SIZE < captured)
+        return false;
+
+    frame.data = _ptr + PCAP_RECORD_SIZE;
+    frame.size = captured;
+    frame.linkType = iface.linkType;
+    frame.time = Poco::Timestamp::TimeVal(seconds * 1000000 + fraction * 1000000 / iface.ticksPerSecond);
+
+    _ptr += PCAP_RECORD_SIZE + captured;
+    return true;
+}
+
+bool PcapReader::nextGenerationFrame(Frame& frame)
+{
+    while (size_t(_end - _ptr) >= 12)
+    {
+        const Byte* block = _ptr;
+        Poco::UInt32 type = load32(block);
+
+        if (type == SECTION_HEADER_BLOCK)
+        {
+            // Byte order of section is known from the magic only
+            Poco::UInt32 magic = loadLittleEndian32(block + 8);
+            _bigEndian = (magic != BYTE_ORDER_MAGIC);
+        }
+
+        size_t length = load32(block + 4);
+        if (length < 12 || (length & 3) || length > size_t(_end - block))
+            return false;
+
+        _ptr += length;
+
+        switch(type)
+        {
+            case SECTION_HEADER_BLOCK:
+                parseSectionHeader(block, length);
+                break;
+
+            case INTERFACE_BLOCK:
+                parseInterface(block, length);
+                break;
+
+            case ENHANCED_PACKET_BLOCK:
+            case PACKET_BLOCK:
+            {
+                if (length < 32)
+                    break;
+
+                size_t interfaceId = (type == ENHANCED_PACKET_BLOCK) ? load32(block + 8) : load16(block + 8);
+                if (interfaceId >= _interfaces.size())
+                {
+                    _skipped++;
+                    break;
+                }
+
+                const Interface& iface = _interfaces[interfaceId];
+                Poco::UInt64 ticks = (Poco::UInt64(load32(block + 12)) << 32) | load32(block + 16);
+                size_t captured = load32(block + 20);
+                if (captured > length - 32)
+                    return false;
+
+                frame.data = block + 28;
+                frame.size = captured;
+                frame.linkType = iface.linkType;
+                frame.time = Poco::Timestamp::TimeVal((ticks / iface.ticksPerSecond + iface.offset) * 1000000
+                    + (ticks % iface.ticksPerSecond) * 1000000 / iface.ticksPerSecond);
+                return true;
+            }
+
+            case SIMPLE_PACKET_BLOCK:
+            {
+                if (_interfaces.empty() || length < 16)
+                    break;
+
+                // No timestamp and snaplen bounded payload
+                frame.data = block + 12;
+                frame.size = std::min(size_t(load32(block + 8)), length - 16);
+                frame.linkType = _interfaces.front().linkType;
+                frame.time = 0;
+                return true;
+            }
+
+            default:
+                // Statistics, name resolution, custom blocks
+                break;
+        }
+    }
+
+    return false;
+}
+
+void PcapReader::parseSectionHeader(const Byte block[], size_t length)
+{
+    // Interface ids are local to section
+    _interfaces.clear();
+}
+
+void PcapReader::parseInterface(const Byte block[], size_t length)
+{
+    if (length < 20)
+        return;
+
+    Interface iface{load16(block + 8), 1000000, 0};
+
+    // Options follow link type, reserved and snaplen
+    const Byte* option = block + 16;
+    const Byte* end = block + length - 4;
+
+    while (end - option >= 4)
+    {
+        int code = load16(option);
+        size_t size = load16(option + 2);
+        const Byte* value = option + 4;
+
+        if (code == 0 || size_t(end - value) < size)
+            break;
+
+        if (code == 9 && size >= 1)
+        {
+            // if_tsresol, negative power of 10 or of 2 when MSB is set
+            int exponent = value[0] & 0x7F;
+            if (exponent < 64)
+            {
+                Poco::UInt64 ticks = 1;
+                for (int i = 0; i < exponent && ticks < 1000000000000000000ULL; i++)
+                    ticks = (value[0] & 0x80) ? ticks * 2 : ticks * 10;
+                iface.ticksPerSecond = ticks;
+            }
+        }
+        else if (code == 14 && size >= 8)
+        {
+            // if_tsoffset
+            iface.offset = Poco::Int64((Poco::UInt64(load32(_bigEndian ? value : value + 4)) << 32) | load32(_bigEndian ? value + 4 : value));
+        }
+
+        option = value + ((size + 3) & ~size_t(3));
+    }
+
+    _interfaces.push_back(iface);
+}
+
+bool PcapReader::parseUdp(int linkType, const Byte frame[], size_t size, int port, RecordingPacket& packet)
+{
+    const Byte* ptr = frame;
+    const Byte* end = frame + size;
+    int etherType = 0;
+
+    switch(linkType)
+    {
+        case LINKTYPE_ETHERNET:
+            if (end - ptr < 14)
+                return false;
+            etherType = int(ByteUtils::loadBigEndian(ptr + 12, 2));
+            ptr += 14;
+            // 802.1Q and 802.1ad tags
+            while ((etherType == 0x8100 || etherType == 0x88A8) && end - ptr >= 4)
+            {
+                etherType = int(ByteUtils::loadBigEndian(ptr + 2, 2));
+                ptr += 4;
+            }
+            break;
+
+        case LINKTYPE_LINUX_SLL:
+            if (end - ptr < 16)
+                return false;
+            etherType = int(ByteUtils::loadBigEndian(ptr + 14, 2));
+            ptr += 16;
+            break;
+
+        case LINKTYPE_RAW:
+        case LINKTYPE_IPV4:
+        case LINKTYPE_IPV6:
+            if (end - ptr < 1)
+                return false;
+            etherType = ((ptr[0] >> 4) == 6) ? 0x86DD : 0x0800;
+            break;
+
+        default:
+            return false;
+    }
+
+    Poco::UInt32 sourceAddress = 0;
+
+    if (etherType == 0x0800)
+    {
+        if (end - ptr < 20 || (ptr[0] >> 4) != 4)
+            return false;
+
+        size_t headerSize = (ptr[0] & 0x0F) * 4;
+        size_t totalSize = size_t(ByteUtils::loadBigEndian(ptr + 2, 2));
+        size_t fragment = size_t(ByteUtils::loadBigEndian(ptr + 6, 2));
+
+        // More fragments flag or fragment offset
+        if (ptr[9] != IPPROTO_UDP_NUMBER || (fragment & 0x3FFF) != 0 || headerSize < 20 || totalSize < headerSize)
+            return false;
+
+        // Ethernet padding is not a part of IP datagram
+        if (totalSize < size_t(end - ptr))
+            end = ptr + totalSize;
+        sourceAddress = Poco::UInt32(ByteUtils::loadBigEndian(ptr + 12, 4));
+        ptr += headerSize;
+    }
+    else if (etherType == 0x86DD)
+    {
+        if (end - ptr < 40 || ptr[6] != IPPROTO_UDP_NUMBER)
+            return false;
+
+        size_t payloadSize = size_t(ByteUtils::loadBigEndian(ptr + 4, 2));
+        ptr += 40;
+        if (payloadSize < size_t(end - ptr))
+            end = ptr + payloadSize;
+    }
+    else
+    {
+        return false;
+    }
+
+    if (ptr > end || end - ptr < 8)
+        return false;
+
+    Poco::UInt16 sourcePort = Poco::UInt16(ByteUtils::loadBigEndian(ptr, 2));
+    Poco::UInt16 destinationPort = Poco::UInt16(ByteUtils::loadBigEndian(ptr + 2, 2));
+    size_t udpSize = size_t(ByteUtils::loadBigEndian(ptr + 4, 2));
+
+    if (port && destinationPort != port)
+        return false;
+
+    ptr += 8;
+    if (udpSize >= 8 && udpSize - 8 < size_t(end - ptr))
+        end = ptr + udpSize - 8;
+
+    packet.data = ptr;
+    packet.size = size_t(end - ptr);
+    packet.sourcePort = sourcePort;
+    packet.destinationPort = destinationPort;
+    packet.sourceAddress = sourceAddress;
+    return true;
+}
+
+Poco::UInt16 PcapReader::load16(const Byte ptr[]) const
+{
+    return _bigEndian ? Poco::UInt16((ptr[0] << 8) | ptr[1]) : Poco::UInt16((ptr[1] << 8) | ptr[0]);
+}
+
+Poco::UInt32 PcapReader::load32(const Byte ptr[]) const
+{
+    return _bigEndian ? Poco::UInt32(ByteUtils::loadBigEndian(ptr, 4)) : loadLittleEndian32(ptr);
+}
+
+} /* namespace astlib */
@@ -0,0 +1,110 @@
+///
+/// \package astlib
+/// \file PcapReader.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "RecordingReader.h"
+
+#include <string>
+#include <vector>
+
+namespace astlib
+{
+
+/**
+ * Reader of pcap and pcapng captures. File is memory mapped, Ethernet (with VLAN tags), Linux cooked
+ * and raw IP link layers are parsed in place and UDP payloads are returned without copying.
+ * Fragmented IP datagrams and IPv6 extension headers are not supported, such packets are skipped
+ * and counted by getSkippedCount() together with filtered out and non UDP frames.
+ */
+class ASTLIB_API PcapReader :
+    public RecordingReader
+{
+public:
+    /// Supported link layer types
+    static const int LINKTYPE_ETHERNET = 1;
+    static const int LINKTYPE_RAW = 101;
+    static const int LINKTYPE_LINUX_SLL = 113;
+    static const int LINKTYPE_IPV4 = 228;
+    static const int LINKTYPE_IPV6 = 229;
+
+    /**
+     * Maps capture file, throws Exception when file is not pcap or pcapng.
+     */
+    explicit PcapReader(const std::string& path);
+    ~PcapReader();
+
+    /**
+     * Only UDP datagrams sent to port are returned, zero disables filter.
+     */
+    void setPortFilter(int port);
+
+    /**
+     * Reads next UDP payload.
+     * @return false at the end of capture
+     */
+    virtual bool next(RecordingPacket& packet);
+
+    /**
+     * Starts reading from first packet again.
+     */
+    virtual void rewind();
+
+    virtual const char* getFormatName() const;
+
+    bool isNextGeneration() const;
+
+    /**
+     * @return true when head of file is pcap or pcapng header
+     */
+    static bool probe(const Byte head[], size_t bytes);
+
+    /**
+     * Parses link layer, IP and UDP headers of frame in place, packet timestamp is not changed.
+     * Shared with live capture, which delivers frames in the same form.
+     * @param port UDP destination port filter, zero disables filter
+     * @return false for non UDP, fragmented, truncated or filtered out frame
+     */
+    static bool parseUdp(int linkType, const Byte frame[], size_t size, int port, RecordingPacket& packet);
+
+private:
+    struct Interface
+    {
+        int linkType;
+        Poco::UInt64 ticksPerSecond;
+        Poco::Int64 offset;         ///< seconds added to timestamps
+    };
+
+    struct Frame
+    {
+        const Byte* data;
+        size_t size;
+        int linkType;
+        Poco::Timestamp::TimeVal time;     ///< microseconds since epoch
+    };
+
+    bool nextFrame(Frame& frame);
+    bool nextClassicFrame(Frame& frame);
+    bool nextGenerationFrame(Frame& frame);
+    void parseSectionHeader(const Byte block[], size_t length);
+    void parseInterface(const Byte block[], size_t length);
+
+    Poco::UInt16 load16(const Byte ptr[]) const;
+    Poco::UInt32 load32(const Byte ptr[]) const;
+
+    const Byte* _ptr = nullptr;
+    bool _nextGeneration = false;
+    bool _bigEndian = false;                ///< byte order of file headers
+    int _port = 0;
+    std::vector<Interface> _interfaces;     ///< classic pcap has one interface only
+};
+
+} /* namespace astlib */
@@ -0,0 +1,84 @@
+///
+/// \package astlib
+/// \file PcapWriter.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "PcapWriter.h"
+
+#include <algorithm>
+
+namespace astlib
+{
+
+static const Poco::UInt32 PCAP_MAGIC_NANO = 0xA1B23C4D;
+static const size_t PCAP_HEADER_SIZE = 24;
+static const size_t PCAP_RECORD_SIZE = 16;
+
+// Headers are written in little endian, readers detect byte order from magic
+static void storeLittleEndian32(Byte ptr[], Poco::UInt32 value)
+{
+    ptr[0] = Byte(value);
+    ptr[1] = Byte(value >> 8);
+    ptr[2] = Byte(value >> 16);
+    ptr[3] = Byte(value >> 24);
+}
+
+PcapWriter::PcapWriter(const std::string& path, int linkType, size_t snapLength, FileWriter::Backend backend) :
+    _writer(path, backend),
+    _snapLength(snapLength)
+{
+    Byte header[PCAP_HEADER_SIZE] = { 0 };
+    storeLittleEndian32(header, PCAP_MAGIC_NANO);
+    header[4] = 2;      // version 2.4
+    header[6] = 4;
+    storeLittleEndian32(header + 16, Poco::UInt32(snapLength));
+    storeLittleEndian32(header + 20, Poco::UInt32(linkType));
+    _writer.write(header, sizeof(header));
+}
+
+PcapWriter::~PcapWriter()
+{
+}
+
+void PcapWriter::write(Poco::Int64 nanoseconds, const Byte frame[], size_t size, size_t originalLength)
+{
+    size_t stored = std::min(size, _snapLength);
+
+    Byte record[PCAP_RECORD_SIZE];
+    storeLittleEndian32(record, Poco::UInt32(nanoseconds / 1000000000));
+    storeLittleEndian32(record + 4, Poco::UInt32(nanoseconds % 1000000000));
+    storeLittleEndian32(record + 8, Poco::UInt32(stored));
+    storeLittleEndian32(record + 12, Poco::UInt32(originalLength ? originalLength : size));
+
+    _writer.write(record, sizeof(record));
+    _writer.write(frame, stored);
+    _frames++;
+}
+
+void PcapWriter::write(const Poco::Timestamp& timestamp, const Byte frame[], size_t size)
+{
+    write(timestamp.epochMicroseconds() * 1000, frame, size);
+}
+
+void PcapWriter::flush()
+{
+    _writer.flush();
+}
+
+void PcapWriter::close()
+{
+    _writer.close();
+}
+
+size_t PcapWriter::getFrameCount() const
+{
+    return _frames;
+}
+
+} /* namespace astlib */
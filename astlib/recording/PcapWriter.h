@@ -0,0 +1,58 @@
+///
+/// \package astlib
+/// \file PcapWriter.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "astlib/io/FileWriter.h"
+
+#include <Poco/Timestamp.h>
+
+#include <string>
+
+namespace astlib
+{
+
+/**
+ * Writer of classic pcap captures with nanosecond timestamps, readable by PcapReader and common tools.
+ */
+class ASTLIB_API PcapWriter
+{
+public:
+    /**
+     * Creates capture file and writes its header, throws Exception on failure.
+     * @param linkType link layer of all frames, see PcapReader::LINKTYPE_*
+     * @param snapLength maximal stored frame length
+     */
+    PcapWriter(const std::string& path, int linkType, size_t snapLength = 65535, FileWriter::Backend backend = FileWriter::Stream);
+    ~PcapWriter();
+
+    /**
+     * Writes one frame, frames longer than snap length are truncated.
+     * @param nanoseconds receive time in nanoseconds since epoch
+     * @param originalLength frame length on wire, zero means size
+     */
+    void write(Poco::Int64 nanoseconds, const Byte frame[], size_t size, size_t originalLength = 0);
+
+    void write(const Poco::Timestamp& timestamp, const Byte frame[], size_t size);
+
+    void flush();
+    void close();
+
+    /// @return number of written frames
+    size_t getFrameCount() const;
+
+private:
+    FileWriter _writer;
+    size_t _snapLength;
+    size_t _frames = 0;
+};
+
+} /* namespace astlib */
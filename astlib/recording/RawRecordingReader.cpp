@@ -0,0 +1,86 @@
+///
+/// \package astlib
+/// \file RawRecordingReader.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "RawRecordingReader.h"
+
+namespace astlib
+{
+
+RawRecordingReader::RawRecordingReader(const std::string& path) :
+    RecordingReader(path, 3)
+{
+    rewind();
+}
+
+RawRecordingReader::~RawRecordingReader()
+{
+}
+
+bool RawRecordingReader::next(RecordingPacket& packet)
+{
+    while (_ptr < _end)
+    {
+        size_t length = blockLength(_ptr, size_t(_end - _ptr));
+        if (length == 0)
+        {
+            _ptr++;
+            _skipped++;
+            continue;
+        }
+
+        packet.timestamp = 0;
+        packet.data = _ptr;
+        packet.size = length;
+        packet.sourcePort = 0;
+        packet.destinationPort = 0;
+        packet.sourceAddress = 0;
+        _ptr += length;
+        _packets++;
+        return true;
+    }
+    return false;
+}
+
+void RawRecordingReader::rewind()
+{
+    _ptr = _begin;
+    _packets = 0;
+    _skipped = 0;
+}
+
+const char* RawRecordingReader::getFormatName() const
+{
+    return "raw";
+}
+
+bool RawRecordingReader::probe(const Byte head[], size_t bytes)
+{
+    if (blockLength(head, bytes))
+        return true;
+
+    // First block may be longer than probed head
+    return bytes >= 4 && head[0] != 0 && ByteUtils::loadBigEndian(head + 1, 2) > bytes && head[3] != 0;
+}
+
+size_t RawRecordingReader::blockLength(const Byte data[], size_t bytes)
+{
+    if (bytes < 3)
+        return 0;
+
+    size_t length = size_t(ByteUtils::loadBigEndian(data + 1, 2));
+    if (data[0] == 0 || length < 3 || length > bytes)
+        return 0;
+
+    // Record starts with non empty FSPEC
+    return (length == 3 || (length > 4 && data[3] != 0)) ? length : 0;
+}
+
+} /* namespace astlib */
@@ -0,0 +1,47 @@
+///
+/// \package astlib
+/// \file RawRecordingReader.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "RecordingReader.h"
+
+namespace astlib
+{
+
+/**
+ * Reader of plain concatenated data blocks framed by LEN only, packets have no timestamp.
+ * Implausible header (category 0, LEN out of file, empty FSPEC) is skipped byte by byte,
+ * getSkippedCount() returns number of skipped bytes.
+ */
+class ASTLIB_API RawRecordingReader :
+    public RecordingReader
+{
+public:
+    explicit RawRecordingReader(const std::string& path);
+    ~RawRecordingReader();
+
+    virtual bool next(RecordingPacket& packet);
+    virtual void rewind();
+    virtual const char* getFormatName() const;
+
+    /**
+     * @return true when head of file starts with plausible data block
+     */
+    static bool probe(const Byte head[], size_t bytes);
+
+private:
+    /// @return length of data block or zero for implausible header
+    static size_t blockLength(const Byte data[], size_t bytes);
+
+    const Byte* _ptr = nullptr;
+};
+
+} /* namespace astlib */
@@ -0,0 +1,36 @@
+///
+/// \package astlib
+/// \file RecordingPacket.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "astlib/ByteUtils.h"
+
+#include <Poco/Timestamp.h>
+#include <Poco/Types.h>
+
+namespace astlib
+{
+
+/**
+ * One recorded payload with asterix data blocks, points directly into mapped recording.
+ */
+struct ASTLIB_API RecordingPacket
+{
+    Poco::Timestamp timestamp;          ///< capture/receive time
+    const Byte* data = nullptr;
+    size_t size = 0;
+    Poco::UInt16 sourcePort = 0;        ///< UDP ports, zero when recording has no transport layer
+    Poco::UInt16 destinationPort = 0;
+    Poco::UInt32 sourceAddress = 0;     ///< IPv4 sender in host byte order, zero when unknown
+    Poco::UInt16 feed = 0;              ///< index of receiving feed, see FeedReceiver
+};
+
+} /* namespace astlib */
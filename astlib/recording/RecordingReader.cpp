@@ -0,0 +1,88 @@
+///
+/// \package astlib
+/// \file RecordingReader.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "RecordingReader.h"
+#include "PcapReader.h"
+#include "FinalRecordingReader.h"
+#include "RawRecordingReader.h"
+#include "astlib/Exception.h"
+
+#include <Poco/File.h>
+#include <fstream>
+#include <vector>
+
+namespace astlib
+{
+
+RecordingReader::RecordingReader(const std::string& path, size_t minimum)
+{
+    Poco::File file(path);
+    if (!file.exists() || file.getSize() < minimum || file.getSize() == 0)
+        throw Exception("RecordingReader: file '" + path + "' is missing or too short");
+
+    Poco::SharedMemory memory(file, Poco::SharedMemory::AM_READ);
+    _memory.swap(memory);
+    _begin = reinterpret_cast<const Byte*>(_memory.begin());
+    _end = reinterpret_cast<const Byte*>(_memory.end());
+}
+
+RecordingReader::~RecordingReader()
+{
+}
+
+DatagramDecoder::Result RecordingReader::decode(DatagramDecoder& decoder, ValueDecoder& valueDecoder)
+{
+    DatagramDecoder::Result result;
+    RecordingPacket packet;
+
+    while(next(packet))
+    {
+        valueDecoder.setTimestamp(packet.timestamp);
+        result += decoder.decode(valueDecoder, packet.data, packet.size);
+    }
+    return result;
+}
+
+size_t RecordingReader::getPacketCount() const
+{
+    return _packets;
+}
+
+size_t RecordingReader::getSkippedCount() const
+{
+    return _skipped;
+}
+
+RecordingReaderPtr RecordingReader::open(const std::string& path, int port)
+{
+    // Only the head of file is needed for detection, it is read without mapping.
+    // It is big enough for the first record of any framing.
+    std::vector<Byte> buffer(65536 + 16);
+    std::ifstream stream(path, std::ios::binary);
+    stream.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+    size_t bytes = size_t(stream.gcount());
+    const Byte* head = buffer.data();
+
+    if (PcapReader::probe(head, bytes))
+    {
+        auto reader = std::make_shared<PcapReader>(path);
+        reader->setPortFilter(port);
+        return reader;
+    }
+    if (FinalRecordingReader::probe(head, bytes))
+        return std::make_shared<FinalRecordingReader>(path);
+    if (RawRecordingReader::probe(head, bytes))
+        return std::make_shared<RawRecordingReader>(path);
+
+    throw Exception("RecordingReader: unknown format of '" + path + "'");
+}
+
+} /* namespace astlib */
@@ -0,0 +1,80 @@
+///
+/// \package astlib
+/// \file RecordingReader.h
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#pragma once
+
+#include "RecordingPacket.h"
+#include "astlib/decoder/DatagramDecoder.h"
+
+#include <Poco/SharedMemory.h>
+#include <memory>
+#include <string>
+
+namespace astlib
+{
+
+class RecordingReader;
+using RecordingReaderPtr = std::shared_ptr<RecordingReader>;
+
+/**
+ * Base of memory mapped recording readers. All framings produce the same stream
+ * of (timestamp, buffer) packets pointing directly into the mapped file.
+ */
+class ASTLIB_API RecordingReader
+{
+public:
+    virtual ~RecordingReader();
+
+    /**
+     * Reads next packet.
+     * @return false at the end of recording
+     */
+    virtual bool next(RecordingPacket& packet) = 0;
+
+    /**
+     * Starts reading from first packet again.
+     */
+    virtual void rewind() = 0;
+
+    virtual const char* getFormatName() const = 0;
+
+    /**
+     * Decodes all remaining packets, packet time is passed by ValueDecoder::setTimestamp().
+     */
+    DatagramDecoder::Result decode(DatagramDecoder& decoder, ValueDecoder& valueDecoder);
+
+    /// @return number of returned packets
+    size_t getPacketCount() const;
+
+    /// @return number of skipped frames or bytes, depends on format
+    size_t getSkippedCount() const;
+
+    /**
+     * Opens recording, format is detected from the first bytes: pcap, pcapng,
+     * FINAL or plain concatenated data blocks. Throws Exception for unknown format.
+     * @param port UDP destination port filter for captures, zero disables filter
+     */
+    static RecordingReaderPtr open(const std::string& path, int port = 0);
+
+protected:
+    /**
+     * Maps whole file, throws Exception when file is shorter than minimum.
+     */
+    RecordingReader(const std::string& path, size_t minimum);
+
+    Poco::SharedMemory _memory;
+    const Byte* _begin = nullptr;
+    const Byte* _end = nullptr;
+    size_t _packets = 0;
+    size_t _skipped = 0;
+};
+
+} /* namespace astlib */
@@ -10,11 +10,17 @@
 /// All rights reserved.
 ///
 
-#include "astlib/decoder/JsonValueDecoder.h"
+#include "astlib/network/FeedReceiver.h"
+#include "astlib/network/PacketCapture.h"
+#include "astlib/recording/PcapReader.h"
+#include "astlib/recording/PcapWriter.h"
+#include "astlib/pipeline/DecodePipeline.h"
+#include "astlib/io/NdjsonSink.h"
 #include "astlib/CodecRegister.h"
 #include "astlib/Exception.h"
 
 #include <Poco/NumberParser.h>
+#include <Poco/NumberFormatter.h>
 #include "Poco/Util/Application.h"
 #include "Poco/Util/Option.h"
 #include "Poco/Util/OptionSet.h"
@@ -26,9 +32,11 @@
 #include "Poco/Net/DatagramSocket.h"
 #include "Poco/Net/SocketAddress.h"
 
+#include <algorithm>
 #include <iostream>
+#include <memory>
 #include <sstream>
-#include "../astlib/decoder/BinaryAsterixDecoder.h"
+#include <vector>
 
 using Poco::Util::Application;
 using Poco::Util::Option;
@@ -77,7 +85,21 @@ protected:
 
         options.addOption(Option("help", "h", "display help information on command line arguments").required(false).repeatable(false).callback(OptionCallback<SampleApp>(this, &SampleApp::handleHelp)));
         options.addOption(Option("config", "c", "load configuration data from a file").required(false).repeatable(false).argument("file").callback(OptionCallback<SampleApp>(this, &SampleApp::handleConfig)));
-        options.addOption(Option("port", "p", "bind to UDP port").required(true).repeatable(false).argument("value").callback(OptionCallback<SampleApp>(this, &SampleApp::handlePort)));
+        options.addOption(Option("port", "p", "bind to UDP port, when no feed is given").required(false).repeatable(false).argument("value").callback(OptionCallback<SampleApp>(this, &SampleApp::handlePort)));
+        options.addOption(Option("feed", "f", "receive feed [name=]host:port[@interface], multicast group is joined").required(false).repeatable(true).argument("feed").callback(OptionCallback<SampleApp>(this, &SampleApp::handleFeed)));
+        options.addOption(Option("batch", "b", "maximal number of datagrams received by one system call (default 64)").required(false).repeatable(false).argument("value").callback(OptionCallback<SampleApp>(this, &SampleApp::handleBatch)));
+        options.addOption(Option("capture", "C", "capture UDP from interface by AF_PACKET ring instead of sockets").required(false).repeatable(false).argument("interface").callback(OptionCallback<SampleApp>(this, &SampleApp::handleCapture)));
+        options.addOption(Option("write", "w", "record captured frames to pcap file").required(false).repeatable(false).argument("file").callback(OptionCallback<SampleApp>(this, &SampleApp::handleWrite)));
+        options.addOption(Option("threads", "t", "number of decoding threads (default 1 keeps output order)").required(false).repeatable(false).argument("value").callback(OptionCallback<SampleApp>(this, &SampleApp::handleThreads)));
+        options.addOption(Option("queue", "q", "number of received batches waiting for decoding (default 256)").required(false).repeatable(false).argument("value").callback(OptionCallback<SampleApp>(this, &SampleApp::handleQueue)));
+        options.addOption(Option("drop", "d", "full queue policy, newest (default), oldest or block").required(false).repeatable(false).argument("policy").callback(OptionCallback<SampleApp>(this, &SampleApp::handleDrop)));
+        options.addOption(Option("shed", "S", "category priority and quota under overload, cat=critical|high|normal|low[:packets per second]").required(false).repeatable(true).argument("rule").callback(OptionCallback<SampleApp>(this, &SampleApp::handleShed)));
+        options.addOption(Option("compact", "j", "one Json record per line instead of indented output").required(false).repeatable(false).callback(OptionCallback<SampleApp>(this, &SampleApp::handleCompact)));
+        options.addOption(Option("output", "o", "write NDJSON to file, unix:socket path or - for stdout, implies compact").required(false).repeatable(false).argument("target").callback(OptionCallback<SampleApp>(this, &SampleApp::handleOutput)));
+        options.addOption(Option("rotate", "R", "rotate output file at size in bytes, optionally also at age in seconds, bytes[:seconds]").required(false).repeatable(false).argument("limit").callback(OptionCallback<SampleApp>(this, &SampleApp::handleRotate)));
+        options.addOption(Option("io", "i", "receive backend, epoll (default) or uring").required(false).repeatable(false).argument("backend").callback(OptionCallback<SampleApp>(this, &SampleApp::handleBackend)));
+        options.addOption(Option("max-datagram", "m", "receive buffer size of one datagram, longer ones are dropped (default 65535)").required(false).repeatable(false).argument("bytes").callback(OptionCallback<SampleApp>(this, &SampleApp::handleMaxDatagram)));
+        options.addOption(Option("rcvbuf", "r", "socket receive buffer size in bytes (default 8 MB)").required(false).repeatable(false).argument("value").callback(OptionCallback<SampleApp>(this, &SampleApp::handleReceiveBuffer)));
     }
 
     void handleHelp(const std::string& name, const std::string& value)
@@ -95,6 +117,86 @@ protected:
     void handlePort(const std::string& name, const std::string& port)
     {
         _port = Poco::NumberParser::parse(port);
+        _portSet = true;
+    }
+
+    void handleCapture(const std::string& name, const std::string& value)
+    {
+        _capture = value;
+    }
+
+    void handleWrite(const std::string& name, const std::string& value)
+    {
+        _record = value;
+    }
+
+    void handleFeed(const std::string& name, const std::string& value)
+    {
+        _feeds.push_back(astlib::Feed::parse(value));
+    }
+
+    void handleBatch(const std::string& name, const std::string& value)
+    {
+        _batch = std::max(1, Poco::NumberParser::parse(value));
+    }
+
+    void handleThreads(const std::string& name, const std::string& value)
+    {
+        _threads = std::max(1, Poco::NumberParser::parse(value));
+    }
+
+    void handleQueue(const std::string& name, const std::string& value)
+    {
+        _queueDepth = std::max(1, Poco::NumberParser::parse(value));
+    }
+
+    void handleDrop(const std::string& name, const std::string& value)
+    {
+        _policy = astlib::DecodePipeline::parsePolicy(value);
+    }
+
+    void handleCompact(const std::string& name, const std::string& value)
+    {
+        _pretty = false;
+    }
+
+    void handleOutput(const std::string& name, const std::string& value)
+    {
+        _output = value;
+        _pretty = false;
+    }
+
+    void handleRotate(const std::string& name, const std::string& value)
+    {
+        std::string::size_type colon = value.find(':');
+        _rotateBytes = Poco::NumberParser::parseUnsigned64(value.substr(0, colon));
+        if (colon != std::string::npos)
+            _rotateAge = Poco::NumberParser::parseUnsigned(value.substr(colon + 1));
+    }
+
+    void handleShed(const std::string& name, const std::string& value)
+    {
+        _shedRules.push_back(value);
+    }
+
+    void handleBackend(const std::string& name, const std::string& value)
+    {
+        if (value == "uring")
+            _backend = astlib::FeedReceiver::Uring;
+        else if (value == "epoll")
+            _backend = astlib::FeedReceiver::Epoll;
+        else
+            throw astlib::Exception("unknown receive backend " + value);
+    }
+
+    void handleMaxDatagram(const std::string& name, const std::string& value)
+    {
+        _maxDatagram = std::max(1, Poco::NumberParser::parse(value));
+    }
+
+    void handleReceiveBuffer(const std::string& name, const std::string& value)
+    {
+        _receiveBuffer = Poco::NumberParser::parse(value);
     }
 
     void displayHelp()
@@ -108,17 +210,15 @@ protected:
 
     void prepareDecoders()
     {
-        astlib::CodecRegister codecRegister;
-        codecRegister.initializeCodecs();
-        auto codecs = codecRegister.enumerateAllCodecsByCategory();
+        _codecRegister.initializeCodecs();
+        auto codecs = _codecRegister.enumerateAllCodecsByCategory();
 
         for(auto codec: codecs)
         {
             logger().information("registering %s", codec->getCategoryDescription().toString());
-            _codecs[codec->getCategoryDescription().getCategory()] = codec;
         }
 /*
-        auto globals = codecRegister.enumerateGlobalSymbols();
+        auto globals = _codecRegister.enumerateGlobalSymbols();
         int index = 1;
         for(const auto& entry: globals)
         {
@@ -136,78 +236,119 @@ protected:
             {
                 prepareDecoders();
 
-                _socket.bind(SocketAddress(_port), true);
-                logger().information("Listening on udp port %d", _port);
+                std::unique_ptr<astlib::FeedReceiver> receiver;
+                std::unique_ptr<astlib::PacketCapture> capture;
+                std::unique_ptr<astlib::PcapWriter> recorder;
+
+                if (!_capture.empty())
+                {
+                    // Port filter only when asked for, capture sees all feeds on the wire
+                    capture.reset(new astlib::PacketCapture(_capture, _portSet ? _port : 0));
+                    logger().information("Capturing on interface %s", _capture);
+                    if (!_record.empty())
+                    {
+                        recorder.reset(new astlib::PcapWriter(_record, astlib::PcapReader::LINKTYPE_ETHERNET));
+                        capture->setRecorder(recorder.get());
+                        logger().information("Recording to %s", _record);
+                    }
+                }
+                else
+                {
+                    if (!_record.empty())
+                        throw astlib::Exception("recording to pcap requires capture");
+
+                    // Feeds from configuration file as feeds.<name> = host:port[@interface]
+                    AbstractConfiguration::Keys keys;
+                    config().keys("feeds", keys);
+                    for(const std::string& key: keys)
+                    {
+                        astlib::Feed feed = astlib::Feed::parse(config().getString("feeds." + key));
+                        feed.name = key;
+                        _feeds.push_back(feed);
+                    }
+                    if (_feeds.empty())
+                        _feeds.push_back(astlib::Feed::parse("0.0.0.0:" + std::to_string(_port)));
+
+                    receiver.reset(new astlib::FeedReceiver(static_cast<size_t>(_batch), false, _backend, static_cast<size_t>(_maxDatagram)));
+                    logger().information("Receiving by %s", std::string(receiver->getBackend() == astlib::FeedReceiver::Uring ? "io_uring" : "epoll"));
+                    for(const astlib::Feed& feed: _feeds)
+                    {
+                        size_t index = receiver->addFeed(feed, _receiveBuffer);
+                        logger().information("Listening to feed %s on %s", feed.name, receiver->getLocalAddress(index).toString());
+                    }
+                }
+
+                // Records are written in large blocks, slow output only stalls the output thread
+                // and receiving continues until the queue is full
+                astlib::NdjsonSink sink(_output);
+                if (_rotateBytes || _rotateAge)
+                    sink.setRotation(_rotateBytes, _rotateAge);
+                if (_output != "-")
+                    logger().information("Writing to %s", _output);
+                astlib::DecodePipeline pipeline(_codecRegister, sink, size_t(_threads), size_t(_queueDepth), _policy, _pretty);
+                for(const std::string& rule: _shedRules)
+                    pipeline.getShedder().setRule(rule);
+
+                // Records carry feed name and sender, so merged feeds stay distinguishable
+                std::vector<std::string> feedNames(1, _capture);
+                if (receiver)
+                {
+                    feedNames.clear();
+                    for(const astlib::Feed& feed: _feeds)
+                        feedNames.push_back(feed.name);
+                }
+                pipeline.setFeedNames(feedNames);
+                pipeline.start();
 
+                std::vector<astlib::RecordingPacket> packets;
                 Poco::Timespan span(250000);
+                Poco::Timestamp lastReport;
+                size_t lastDrops = 0;
+                size_t lastShed = 0;
+                Poco::UInt64 lastTruncated = 0;
                 while (!_stop)
                 {
-                    if (_socket.poll(span, Socket::SELECT_READ))
+                    try
+                    {
+                        if (capture)
+                            capture->receive(packets, span);
+                        else
+                            receiver->receive(packets, span);
+                    }
+                    catch (Poco::Exception& exc)
+                    {
+                        std::cerr << "ast2json: " << exc.displayText() << std::endl;
+                        continue;
+                    }
+
+                    pipeline.push(packets);
+
+                    if (lastReport.isElapsed(1000000))
                     {
-                        try
+                        // Recording survives kill with at most one second lost
+                        if (recorder)
+                            recorder->flush();
+                        if (receiver && receiver->getTruncatedCount() != lastTruncated)
                         {
-                            astlib::Byte buffer[astlib::BinaryAsterixDecoder::MAX_PACKET_SIZE];
-                            SocketAddress sender;
-                            int bytes = _socket.receiveFrom(buffer, sizeof(buffer), sender);
-
-                            if (bytes > 0)
-                            {
-                                //logger().information("received %d bytes", bytes);
-
-                                int category = buffer[0];
-                                auto codec = _codecs[category];
-                                if (codec)
-                                {
-#if 0
-                                    unsigned char bytes[113] = {
-                                        48, // CAT
-                                        0, 113, // size
-                                        0xFF, 0xFF, 0xFF, 0xF8,// FSPEC
-
-                                        5, 6,  // 10 - sac sic
-                                        0, 0, 200, // 140 - time of day
-                                        0xfe, // 20 - Target Report Descriptor
-                                        0xFF, 0xFF,0xFF, 0xFF, // 40 - polar coords
-                                        0xFF, 0xFF, // 70 - mode 3A
-                                        0xFF, 0xFF, // 90 - mode C
-                                        0xFE, 0x88, 0x44,0x88, 0x44, 0x88, 0x44, 0x88, // 130 - plot characteristics
-
-                                        0xFF, 0xFF, 0xFF, // 220 - aircraft address
-                                        0x42, 0x55, 0x12, 0x45, 0x42, 0x24, // 240 - Aircraft Identification
-                                        2, 4,4,4,4,4,4,2,1,  5,5,5,5,5,5,2,1,  // item 250 Mode S Comm B data
-                                        1,0, // 161 - track number
-                                        0xFF, 0xFF, 0x00, 0x01, // 42 - cartes coords
-                                        0xFF, 0xFF, 0xFF, 0xFF, // 200
-                                        0xFF, 0xFE, // 170 - track status
-
-                                        0xFF, 0xFF, 0xFF, 0xFF, // 210 - track quality
-                                        3,5,6, // 30 - WE Condition
-                                        0xFF, 0xFE, // 80 - mode 3a conf
-                                        0xFF, 0xFF, 0xFF, 0xFF, // 100 - mode C conf
-                                        0xFF, 0xFF, // 110 - 3d height
-                                        0xC0, 0xFF,0xFF, 2, 0,1,0,2,0,3, 0,1,0,2,0,3, // 120 - radial dopler speed
-                                        0xFF, 0xFF, // 230 - Acas comm
-
-                                        0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, // 260 - ACAS resolution
-                                        0xFF, // 55
-                                        0xFF, 0xFF,// 50
-                                        0xFF, // 65
-                                        0xFF, 0xFF,// 60
-
-                                    };
-                                    _decoder.decode(*codec, _decoderHandler, bytes, sizeof(bytes));
-#else
-                                    _decoder.decode(*codec, _decoderHandler, buffer, bytes);
-#endif
-                                }
-                            }
+                            lastTruncated = receiver->getTruncatedCount();
+                            logger().warning("%Lu datagrams longer than %d bytes dropped", lastTruncated, _maxDatagram);
                         }
-                        catch (Poco::Exception& exc)
+                        if (pipeline.getDropCount() != lastDrops)
                         {
-                            std::cerr << "ast2json: " << exc.displayText() << std::endl;
+                            lastDrops = pipeline.getDropCount();
+                            const astlib::LoadShedder& shedder = pipeline.getShedder();
+                            logger().warning("%z packets dropped by full decode queue, evicted:%s, dropped:%s", lastDrops,
+                                categoryCounts(shedder, &astlib::LoadShedder::getEvictCount), categoryCounts(shedder, &astlib::LoadShedder::getDropCount));
                         }
+                        if (pipeline.getShedder().getShedCount() != lastShed)
+                        {
+                            lastShed = pipeline.getShedder().getShedCount();
+                            logger().warning("%z packets shed by overload control:%s", lastShed, categoryCounts(pipeline.getShedder(), &astlib::LoadShedder::getShedCount));
+                        }
+                        lastReport.update();
                     }
                 }
+                pipeline.stop();
             }
             catch(astlib::Exception& e)
             {
@@ -219,11 +360,35 @@ protected:
     }
 
 private:
-    astlib::JsonValueDecoder _decoderHandler;
-    astlib::BinaryAsterixDecoder _decoder;
-    std::map<int, std::shared_ptr<astlib::CodecDescription>> _codecs;
-    Poco::Net::DatagramSocket _socket;
+    static std::string categoryCounts(const astlib::LoadShedder& shedder, size_t (astlib::LoadShedder::*count)(int) const)
+    {
+        std::string detail;
+        for(int category = 0; category < 256; category++)
+        {
+            if (size_t n = (shedder.*count)(category))
+                detail += " cat" + Poco::NumberFormatter::format0(category, 3) + "=" + std::to_string(n);
+        }
+        return detail;
+    }
+
+    astlib::CodecRegister _codecRegister;
+    std::vector<astlib::Feed> _feeds;
+    std::vector<std::string> _shedRules;
+    std::string _capture;
+    std::string _record;
+    std::string _output = "-";
+    Poco::UInt64 _rotateBytes = 0;
+    unsigned _rotateAge = 0;
     int _port = 10000;
+    bool _portSet = false;
+    int _batch = int(astlib::UdpReceiver::DEFAULT_BATCH);
+    int _maxDatagram = int(astlib::UdpReceiver::MAX_DATAGRAM_SIZE);
+    int _receiveBuffer = 8 << 20;
+    int _threads = 1;
+    bool _pretty = true;
+    int _queueDepth = 256;
+    astlib::DecodePipeline::DropPolicy _policy = astlib::DecodePipeline::DropNewest;
+    astlib::FeedReceiver::Backend _backend = astlib::FeedReceiver::Epoll;
     bool _helpRequested;
     bool _stop = false;
 };
@@ -0,0 +1,419 @@
+///
+/// \package astlib
+/// \file astconvert.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/decoder/DatagramDecoder.h"
+#include "astlib/decoder/SimpleValueDecoder.h"
+#include "astlib/recording/RecordingReader.h"
+#include "astlib/io/FileWriter.h"
+#include "astlib/AsterixItemDictionary.h"
+#include "astlib/CodecRegister.h"
+#include "astlib/Exception.h"
+
+#include <Poco/NumberParser.h>
+#include <Poco/NumberFormatter.h>
+#include <Poco/Environment.h>
+#include <Poco/ThreadPool.h>
+#include <Poco/Runnable.h>
+#include <Poco/String.h>
+#include "Poco/Util/Application.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/AbstractConfiguration.h"
+
+#include <iostream>
+#include <memory>
+#include <vector>
+
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::HelpFormatter;
+using Poco::Util::AbstractConfiguration;
+using Poco::Util::OptionCallback;
+
+/**
+ * Formats records as one JSON object per line.
+ */
+class NdjsonWriter :
+    public astlib::SimpleValueDecoder
+{
+public:
+    virtual void onMessageDecoded(astlib::SimpleAsterixRecordPtr ptr)
+    {
+        output += "{\"timestamp\":";
+        output += std::to_string(ptr->getTimestamp().epochMicroseconds());
+        output += ",\"category\":";
+        output += std::to_string(int(ptr->getCategory()));
+        output += ",\"items\":";
+        ptr->toJson(output);
+        output += "}\n";
+    }
+
+    std::string output;
+};
+
+/**
+ * Serializes records as CBOR sequence, one map per record keyed by item codes.
+ */
+class CborRecordWriter :
+    public astlib::SimpleValueDecoder
+{
+public:
+    virtual void onMessageDecoded(astlib::SimpleAsterixRecordPtr ptr)
+    {
+        ptr->toCbor(output);
+    }
+
+    std::string output;
+};
+
+/**
+ * Formats records as CSV, one line per decoded value.
+ */
+class CsvWriter :
+    public astlib::TypedValueDecoder
+{
+public:
+    static constexpr const char* HEADER = "timestamp,packet,record,category,item,index,value\n";
+
+    virtual void begin(int cat)
+    {
+        _prefix = _packetPrefix + std::to_string(_record++) + "," + std::to_string(cat) + ",";
+    }
+    virtual void beginItem(const astlib::ItemDescription& uapItem)
+    {
+    }
+    virtual void beginRepetitive(size_t size)
+    {
+    }
+    virtual void beginArray(astlib::AsterixItemCode code, size_t size)
+    {
+    }
+    virtual void decodeBoolean(const astlib::CodecContext& context, bool value, int index)
+    {
+        row(context, index, value ? "true" : "false");
+    }
+    virtual void decodeSigned(const astlib::CodecContext& context, Poco::Int64 value, int index)
+    {
+        row(context, index, std::to_string(value));
+    }
+    virtual void decodeUnsigned(const astlib::CodecContext& context, Poco::UInt64 value, int index)
+    {
+        row(context, index, std::to_string(value));
+    }
+    virtual void decodeReal(const astlib::CodecContext& context, double value, int index)
+    {
+        row(context, index, Poco::NumberFormatter::format(value));
+    }
+    virtual void decodeString(const astlib::CodecContext& context, const std::string& value, int index)
+    {
+        row(context, index, "\"" + Poco::replace(value, "\"", "\"\"") + "\"");
+    }
+    virtual void end()
+    {
+    }
+    virtual void abort()
+    {
+        // Rows of broken record are already written, they are kept as the best effort output
+    }
+
+    void setPacket(const Poco::Timestamp& timestamp, size_t packet)
+    {
+        _packetPrefix = std::to_string(timestamp.epochMicroseconds()) + "," + std::to_string(packet) + ",";
+        _record = 0;
+    }
+
+    std::string output;
+
+private:
+    void row(const astlib::CodecContext& context, int index, const std::string& value)
+    {
+        output += _prefix;
+        output += astlib::asterixCodeToSymbol(context.bits.code);
+        output += ',';
+        if (index >= 0)
+            output += std::to_string(index);
+        output += ',';
+        output += value;
+        output += '\n';
+    }
+
+    std::string _packetPrefix;
+    std::string _prefix;
+    int _record = 0;
+};
+
+/**
+ * Decodes one contiguous range of packets into private text buffer.
+ */
+class ConvertWorker :
+    public Poco::Runnable
+{
+public:
+    enum Format {
+        Ndjson,
+        Csv,
+        Cbor
+    };
+
+    ConvertWorker(const astlib::CodecRegister& codecRegister, Format format) :
+        _format(format)
+    {
+        decoder.setCodecs(codecRegister);
+    }
+
+    void run()
+    {
+        _jsonWriter.output.clear();
+        _csvWriter.output.clear();
+        _cborWriter.output.clear();
+        result = astlib::DatagramDecoder::Result();
+
+        for(size_t i = 0; i < packets.size(); i++)
+        {
+            const astlib::RecordingPacket& packet = packets[i];
+
+            if (_format == Csv)
+            {
+                _csvWriter.setPacket(packet.timestamp, firstPacket + i);
+                result += decoder.decode(_csvWriter, packet.data, packet.size);
+            }
+            else if (_format == Cbor)
+            {
+                _cborWriter.setTimestamp(packet.timestamp);
+                result += decoder.decode(_cborWriter, packet.data, packet.size);
+            }
+            else
+            {
+                _jsonWriter.setTimestamp(packet.timestamp);
+                result += decoder.decode(_jsonWriter, packet.data, packet.size);
+            }
+        }
+    }
+
+    const std::string& getOutput() const
+    {
+        switch(_format)
+        {
+        case Csv:
+            return _csvWriter.output;
+        case Cbor:
+            return _cborWriter.output;
+        default:
+            return _jsonWriter.output;
+        }
+    }
+
+    astlib::DatagramDecoder decoder;
+    astlib::DatagramDecoder::Result result;
+    std::vector<astlib::RecordingPacket> packets;
+    size_t firstPacket = 0;
+
+private:
+    Format _format;
+    NdjsonWriter _jsonWriter;
+    CsvWriter _csvWriter;
+    CborRecordWriter _cborWriter;
+};
+
+class ConvertApp: public Application
+{
+public:
+    ConvertApp() :
+        _helpRequested(false)
+    {
+    }
+
+protected:
+    void initialize(Application& self)
+    {
+        loadConfiguration(); // load default configuration files, if present
+        Application::initialize(self);
+    }
+
+    void defineOptions(OptionSet& options)
+    {
+        Application::defineOptions(options);
+
+        options.addOption(Option("help", "h", "display help information on command line arguments").required(false).repeatable(false).callback(OptionCallback<ConvertApp>(this, &ConvertApp::handleHelp)));
+        options.addOption(Option("format", "f", "output format, ndjson (default), csv or cbor").required(false).repeatable(false).argument("format").callback(OptionCallback<ConvertApp>(this, &ConvertApp::handleFormat)));
+        options.addOption(Option("output", "o", "output file, standard output by default").required(false).repeatable(false).argument("file").callback(OptionCallback<ConvertApp>(this, &ConvertApp::handleOutput)));
+        options.addOption(Option("io", "i", "output backend, stream (default) or uring").required(false).repeatable(false).argument("backend").callback(OptionCallback<ConvertApp>(this, &ConvertApp::handleBackend)));
+        options.addOption(Option("threads", "t", "number of decoding threads, all cores by default").required(false).repeatable(false).argument("value").callback(OptionCallback<ConvertApp>(this, &ConvertApp::handleThreads)));
+        options.addOption(Option("batch", "b", "packets decoded by one thread at once").required(false).repeatable(false).argument("value").callback(OptionCallback<ConvertApp>(this, &ConvertApp::handleBatch)));
+        options.addOption(Option("port", "p", "decode only UDP datagrams sent to port (pcap input)").required(false).repeatable(false).argument("value").callback(OptionCallback<ConvertApp>(this, &ConvertApp::handlePort)));
+    }
+
+    void handleHelp(const std::string& name, const std::string& value)
+    {
+        _helpRequested = true;
+        displayHelp();
+        stopOptionsProcessing();
+    }
+
+    void handleFormat(const std::string& name, const std::string& value)
+    {
+        if (value == "csv")
+            _format = ConvertWorker::Csv;
+        else if (value == "ndjson")
+            _format = ConvertWorker::Ndjson;
+        else if (value == "cbor")
+            _format = ConvertWorker::Cbor;
+        else
+            throw astlib::Exception("unknown output format " + value);
+    }
+
+    void handleOutput(const std::string& name, const std::string& value)
+    {
+        _output = value;
+    }
+
+    void handleBackend(const std::string& name, const std::string& value)
+    {
+        if (value == "uring")
+            _backend = astlib::FileWriter::Uring;
+        else if (value == "stream")
+            _backend = astlib::FileWriter::Stream;
+        else
+            throw astlib::Exception("unknown output backend " + value);
+    }
+
+    void handleThreads(const std::string& name, const std::string& value)
+    {
+        _threads = Poco::NumberParser::parse(value);
+    }
+
+    void handleBatch(const std::string& name, const std::string& value)
+    {
+        _batch = std::max(1, Poco::NumberParser::parse(value));
+    }
+
+    void handlePort(const std::string& name, const std::string& value)
+    {
+        _port = Poco::NumberParser::parse(value);
+    }
+
+    void displayHelp()
+    {
+        HelpFormatter helpFormatter(options());
+        helpFormatter.setCommand(commandName());
+        helpFormatter.setUsage("OPTIONS FILE...");
+        helpFormatter.setHeader("Parallel conversion of Asterix recordings (pcap, pcapng, FINAL, raw) to NDJSON, CSV or CBOR.");
+        helpFormatter.format(std::cout);
+    }
+
+    int main(const ArgVec& args)
+    {
+        if (_helpRequested)
+            return Application::EXIT_OK;
+
+        if (args.empty())
+        {
+            displayHelp();
+            return Application::EXIT_USAGE;
+        }
+
+        try
+        {
+            astlib::CodecRegister codecRegister;
+            codecRegister.initializeCodecs();
+
+            int threads = _threads > 0 ? _threads : std::max(1, int(Poco::Environment::processorCount()));
+            Poco::ThreadPool pool(1, threads);
+            std::vector<std::unique_ptr<ConvertWorker>> workers;
+            for(int i = 0; i < threads; i++)
+                workers.emplace_back(new ConvertWorker(codecRegister, _format));
+
+            // Large buffered writes, uring backend writes previous buffers while next batches are decoded
+            std::unique_ptr<astlib::FileWriter> file;
+            if (!_output.empty())
+            {
+                file.reset(new astlib::FileWriter(_output, _backend, 4 << 20));
+                logger().information("writing %s by %s", _output, std::string(file->getBackend() == astlib::FileWriter::Uring ? "io_uring" : "stream"));
+            }
+            auto write = [&file](const std::string& text)
+            {
+                if (file)
+                    file->write(text);
+                else
+                    std::cout.write(text.data(), text.size());
+            };
+
+            if (_format == ConvertWorker::Csv)
+                write(CsvWriter::HEADER);
+
+            astlib::DatagramDecoder::Result total;
+            size_t packetCount = 0;
+
+            for(const std::string& path: args)
+            {
+                astlib::RecordingReaderPtr source = astlib::RecordingReader::open(path, _port);
+                logger().information("reading %s recording %s", std::string(source->getFormatName()), path);
+                bool more = true;
+
+                while (more)
+                {
+                    // Contiguous batches keep output order, every window is written after join
+                    size_t used = 0;
+                    for(; used < workers.size() && more; used++)
+                    {
+                        ConvertWorker& worker = *workers[used];
+                        astlib::RecordingPacket packet;
+
+                        worker.packets.clear();
+                        worker.firstPacket = packetCount;
+                        while (worker.packets.size() < size_t(_batch) && (more = source->next(packet)))
+                            worker.packets.push_back(packet);
+                        packetCount += worker.packets.size();
+                    }
+
+                    for(size_t i = 1; i < used; i++)
+                        pool.start(*workers[i]);
+                    if (used)
+                        workers[0]->run();
+                    pool.joinAll();
+
+                    for(size_t i = 0; i < used; i++)
+                    {
+                        write(workers[i]->getOutput());
+                        total += workers[i]->result;
+                    }
+                }
+            }
+
+            if (file)
+                file->close();
+            else
+                std::cout.flush();
+            logger().information("%z packets, %z blocks, %z records, %z bad blocks, %z unknown blocks",
+                packetCount, total.blocks, total.records, total.badBlocks, total.unknownBlocks);
+        }
+        catch(Poco::Exception& e)
+        {
+            logger().error(e.displayText());
+            return Application::EXIT_SOFTWARE;
+        }
+        return Application::EXIT_OK;
+    }
+
+private:
+    std::string _output;
+    int _threads = 0;
+    int _batch = 4096;
+    int _port = 0;
+    ConvertWorker::Format _format = ConvertWorker::Ndjson;
+    astlib::FileWriter::Backend _backend = astlib::FileWriter::Stream;
+    bool _helpRequested;
+};
+
+POCO_APP_MAIN(ConvertApp)
@@ -0,0 +1,404 @@
+///
+/// \package astlib
+/// \file astreplay.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/decoder/BinaryAsterixDecoder.h"
+#include "astlib/recording/RecordingReader.h"
+#include "astlib/encoder/RecordPatcher.h"
+#include "astlib/AsterixItemDictionary.h"
+#include "astlib/CodecRegister.h"
+#include "astlib/Exception.h"
+
+#include <Poco/NumberParser.h>
+#include "Poco/Util/Application.h"
+#include "Poco/Util/Option.h"
+#include "Poco/Util/OptionSet.h"
+#include "Poco/Util/HelpFormatter.h"
+#include "Poco/Util/AbstractConfiguration.h"
+
+#include "Poco/Net/Net.h"
+#include "Poco/Net/DatagramSocket.h"
+#include "Poco/Net/SocketAddress.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <thread>
+#include <vector>
+
+#if defined(__linux__)
+#include <sys/socket.h>
+#include <sys/uio.h>
+#endif
+
+using Poco::Util::Application;
+using Poco::Util::Option;
+using Poco::Util::OptionSet;
+using Poco::Util::HelpFormatter;
+using Poco::Util::AbstractConfiguration;
+using Poco::Util::OptionCallback;
+using Poco::Net::DatagramSocket;
+using Poco::Net::SocketAddress;
+
+using Clock = std::chrono::steady_clock;
+
+/**
+ * Sends batches of datagrams, with one sendmmsg() call on Linux.
+ */
+class BatchSender
+{
+public:
+    BatchSender(DatagramSocket& socket, const SocketAddress& address, size_t capacity) :
+        _socket(socket),
+        _address(address)
+    {
+#if defined(__linux__)
+        _messages.resize(capacity);
+        _vectors.resize(capacity);
+#endif
+        _data.reserve(capacity);
+        _sizes.reserve(capacity);
+    }
+
+    void add(const astlib::Byte* data, size_t size)
+    {
+        _data.push_back(data);
+        _sizes.push_back(size);
+    }
+
+    size_t size() const
+    {
+        return _data.size();
+    }
+
+    /// @return number of sent datagrams
+    size_t send()
+    {
+        size_t count = _data.size();
+        size_t sent = 0;
+
+#if defined(__linux__)
+        for(size_t i = 0; i < count; i++)
+        {
+            _vectors[i].iov_base = const_cast<astlib::Byte*>(_data[i]);
+            _vectors[i].iov_len = _sizes[i];
+
+            msghdr& header = _messages[i].msg_hdr;
+            memset(&header, 0, sizeof(header));
+            header.msg_name = const_cast<sockaddr*>(_address.addr());
+            header.msg_namelen = _address.length();
+            header.msg_iov = &_vectors[i];
+            header.msg_iovlen = 1;
+        }
+
+        while (sent < count)
+        {
+            int result = ::sendmmsg(_socket.impl()->sockfd(), &_messages[sent], unsigned(count - sent), 0);
+            if (result <= 0)
+                break;
+            sent += size_t(result);
+        }
+#else
+        for(size_t i = 0; i < count; i++)
+        {
+            if (_socket.sendTo(_data[i], int(_sizes[i]), _address) > 0)
+                sent++;
+        }
+#endif
+
+        _data.clear();
+        _sizes.clear();
+        return sent;
+    }
+
+private:
+    DatagramSocket& _socket;
+    SocketAddress _address;
+    std::vector<const astlib::Byte*> _data;
+    std::vector<size_t> _sizes;
+#if defined(__linux__)
+    std::vector<mmsghdr> _messages;
+    std::vector<iovec> _vectors;
+#endif
+};
+
+class ReplayApp: public Application
+{
+public:
+    ReplayApp() :
+        _helpRequested(false)
+    {
+    }
+
+protected:
+    void initialize(Application& self)
+    {
+        loadConfiguration(); // load default configuration files, if present
+        Application::initialize(self);
+    }
+
+    void defineOptions(OptionSet& options)
+    {
+        Application::defineOptions(options);
+
+        options.addOption(Option("help", "h", "display help information on command line arguments").required(false).repeatable(false).callback(OptionCallback<ReplayApp>(this, &ReplayApp::handleHelp)));
+        options.addOption(Option("destination", "d", "destination address host:port").required(true).repeatable(false).argument("address").callback(OptionCallback<ReplayApp>(this, &ReplayApp::handleDestination)));
+        options.addOption(Option("speed", "s", "replay speed factor, 0 sends as fast as possible (default 1)").required(false).repeatable(false).argument("factor").callback(OptionCallback<ReplayApp>(this, &ReplayApp::handleSpeed)));
+        options.addOption(Option("port", "p", "replay only UDP datagrams sent to port (pcap input)").required(false).repeatable(false).argument("value").callback(OptionCallback<ReplayApp>(this, &ReplayApp::handlePort)));
+        options.addOption(Option("batch", "b", "maximal number of datagrams sent by one system call (default 64)").required(false).repeatable(false).argument("value").callback(OptionCallback<ReplayApp>(this, &ReplayApp::handleBatch)));
+        options.addOption(Option("loop", "l", "number of replays of the recording (default 1)").required(false).repeatable(false).argument("value").callback(OptionCallback<ReplayApp>(this, &ReplayApp::handleLoop)));
+        options.addOption(Option("sac", "", "rewrite SAC of data source").required(false).repeatable(false).argument("value").callback(OptionCallback<ReplayApp>(this, &ReplayApp::handleSac)));
+        options.addOption(Option("sic", "", "rewrite SIC of data source").required(false).repeatable(false).argument("value").callback(OptionCallback<ReplayApp>(this, &ReplayApp::handleSic)));
+        options.addOption(Option("retime", "r", "rewrite time of day to the time of sending").required(false).repeatable(false).callback(OptionCallback<ReplayApp>(this, &ReplayApp::handleRetime)));
+    }
+
+    void handleHelp(const std::string& name, const std::string& value)
+    {
+        _helpRequested = true;
+        displayHelp();
+        stopOptionsProcessing();
+    }
+
+    void handleDestination(const std::string& name, const std::string& value)
+    {
+        _destination = SocketAddress(value);
+    }
+
+    void handleSpeed(const std::string& name, const std::string& value)
+    {
+        _speed = std::max(0.0, Poco::NumberParser::parseFloat(value));
+    }
+
+    void handlePort(const std::string& name, const std::string& value)
+    {
+        _port = Poco::NumberParser::parse(value);
+    }
+
+    void handleBatch(const std::string& name, const std::string& value)
+    {
+        _batch = std::max(1, Poco::NumberParser::parse(value));
+    }
+
+    void handleLoop(const std::string& name, const std::string& value)
+    {
+        _loop = std::max(1, Poco::NumberParser::parse(value));
+    }
+
+    void handleSac(const std::string& name, const std::string& value)
+    {
+        _sac = Poco::NumberParser::parse(value);
+    }
+
+    void handleSic(const std::string& name, const std::string& value)
+    {
+        _sic = Poco::NumberParser::parse(value);
+    }
+
+    void handleRetime(const std::string& name, const std::string& value)
+    {
+        _retime = true;
+    }
+
+    void displayHelp()
+    {
+        HelpFormatter helpFormatter(options());
+        helpFormatter.setCommand(commandName());
+        helpFormatter.setUsage("OPTIONS FILE");
+        helpFormatter.setHeader("Replay of Asterix recordings (pcap, pcapng, FINAL, raw) to UDP with recorded timing.");
+        helpFormatter.format(std::cout);
+    }
+
+    /**
+     * Sleeps most of the time and spins the rest, so that wakeup jitter of the scheduler is hidden.
+     */
+    static void waitUntil(Clock::time_point target)
+    {
+        static const auto spin = std::chrono::microseconds(200);
+
+        auto now = Clock::now();
+        if (target - now > spin)
+            std::this_thread::sleep_for(target - now - spin);
+
+        while (Clock::now() < target)
+        {
+        }
+    }
+
+    /**
+     * Rewrites all data blocks of datagram copied to buffer.
+     */
+    void patch(astlib::Byte buffer[], size_t bytes, double delta)
+    {
+        // SAC/SIC rules stay from main(), only the shift follows the schedule
+        if (_retime)
+            _patcher.shift(astlib::TIMEOFDAY, delta, 86400.0);
+
+        size_t offset = 0;
+        while (offset + 3 <= bytes)
+        {
+            size_t length = (size_t(buffer[offset + 1]) << 8) | buffer[offset + 2];
+            if (length < 3 || length > bytes - offset)
+                break;
+
+            auto codec = _codecs.find(buffer[offset]);
+            if (codec != _codecs.end())
+            {
+                try
+                {
+                    _patcher.patch(*codec->second, buffer + offset, length);
+                }
+                catch(astlib::Exception& e)
+                {
+                    // Malformed block is sent as it is
+                    _patchErrors++;
+                }
+            }
+            offset += length;
+        }
+    }
+
+    int main(const ArgVec& args)
+    {
+        if (_helpRequested)
+            return Application::EXIT_OK;
+
+        if (args.size() != 1)
+        {
+            displayHelp();
+            return Application::EXIT_USAGE;
+        }
+
+        try
+        {
+            bool patching = _sac >= 0 || _sic >= 0 || _retime;
+            if (patching)
+            {
+                astlib::CodecRegister codecRegister;
+                codecRegister.initializeCodecs();
+                for(auto codec: codecRegister.enumerateAllCodecsByCategory())
+                    _codecs[codec->getCategoryDescription().getCategory() & 0xFF] = codec;
+
+                if (_sac >= 0)
+                    _patcher.set(astlib::DSI_SAC, Poco::UInt64(_sac));
+                if (_sic >= 0)
+                    _patcher.set(astlib::DSI_SIC, Poco::UInt64(_sic));
+            }
+
+            // Packets point into mapped recording
+            astlib::RecordingReaderPtr reader = astlib::RecordingReader::open(args[0], _port);
+            std::vector<astlib::RecordingPacket> packets;
+            astlib::RecordingPacket packet;
+            while (reader->next(packet))
+                packets.push_back(packet);
+
+            if (packets.empty())
+            {
+                logger().warning("no packets in %s", args[0]);
+                return Application::EXIT_OK;
+            }
+            logger().information("replaying %z packets of %s recording to %s", packets.size(), std::string(reader->getFormatName()), _destination.toString());
+
+            DatagramSocket socket(_destination.family());
+            BatchSender sender(socket, _destination, size_t(_batch));
+            std::vector<astlib::Byte> buffers(patching ? size_t(_batch) * astlib::BinaryAsterixDecoder::MAX_PACKET_SIZE : 0);
+
+            Poco::Int64 first = packets.front().timestamp.epochMicroseconds();
+            Poco::Int64 duration = packets.back().timestamp.epochMicroseconds() - first;
+            size_t sent = 0;
+            size_t bytes = 0;
+            Poco::Int64 latenessSum = 0;
+            Poco::Int64 latenessMax = 0;
+            size_t lateCount = 0;
+
+            auto start = Clock::now() + std::chrono::milliseconds(10);
+            Poco::Timestamp wallStart;
+            wallStart += 10000;
+
+            for(int loop = 0; loop < _loop; loop++)
+            {
+                // Loops follow each other with the length of recording
+                Poco::Int64 loopOffset = _speed > 0 ? Poco::Int64((duration + 1) / _speed) * loop : 0;
+
+                size_t i = 0;
+                while (i < packets.size())
+                {
+                    Poco::Int64 due = loopOffset + (_speed > 0 ? Poco::Int64((packets[i].timestamp.epochMicroseconds() - first) / _speed) : 0);
+                    waitUntil(start + std::chrono::microseconds(due));
+
+                    // All packets due till now go in one batch
+                    Poco::Int64 now = std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - start).count();
+                    while (i < packets.size() && sender.size() < size_t(_batch))
+                    {
+                        const astlib::RecordingPacket& current = packets[i];
+                        due = loopOffset + (_speed > 0 ? Poco::Int64((current.timestamp.epochMicroseconds() - first) / _speed) : 0);
+                        if (due > now)
+                            break;
+
+                        const astlib::Byte* data = current.data;
+                        if (patching)
+                        {
+                            size_t size = std::min(current.size, size_t(astlib::BinaryAsterixDecoder::MAX_PACKET_SIZE));
+                            astlib::Byte* buffer = buffers.data() + sender.size() * astlib::BinaryAsterixDecoder::MAX_PACKET_SIZE;
+                            memcpy(buffer, current.data, size);
+                            // Scheduled send time minus recorded time
+                            double delta = double(wallStart.epochMicroseconds() + due - current.timestamp.epochMicroseconds()) / 1000000.0;
+                            patch(buffer, size, delta);
+                            data = buffer;
+                        }
+
+                        sender.add(data, current.size);
+                        bytes += current.size;
+
+                        Poco::Int64 lateness = now - due;
+                        latenessSum += lateness;
+                        latenessMax = std::max(latenessMax, lateness);
+                        if (lateness > 1000)
+                            lateCount++;
+                        i++;
+                    }
+
+                    sent += sender.send();
+                }
+            }
+
+            double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+            size_t total = packets.size() * size_t(_loop);
+            logger().information("sent %z of %z datagrams (%z bytes) in %.3f s, %.0f datagrams/s, %.3f Mbit/s",
+                sent, total, bytes, elapsed, sent / elapsed, bytes * 8 / elapsed / 1e6);
+            logger().information("lateness mean %.1f us, max %Ld us, %z datagrams later than 1 ms, %z patch errors",
+                double(latenessSum) / total, latenessMax, lateCount, _patchErrors);
+        }
+        catch(Poco::Exception& e)
+        {
+            logger().error(e.displayText());
+            return Application::EXIT_SOFTWARE;
+        }
+        return Application::EXIT_OK;
+    }
+
+private:
+    SocketAddress _destination;
+    astlib::RecordPatcher _patcher;
+    std::map<int, astlib::CodecDescriptionPtr> _codecs;
+    double _speed = 1.0;
+    int _port = 0;
+    int _batch = 64;
+    int _loop = 1;
+    int _sac = -1;
+    int _sic = -1;
+    bool _retime = false;
+    size_t _patchErrors = 0;
+    bool _helpRequested;
+};
+
+POCO_APP_MAIN(ReplayApp)
@@ -0,0 +1,99 @@
+///
+/// \package astlib
+/// \file ArchiveTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/recording/ArchiveWriter.h"
+#include "astlib/recording/ArchiveReader.h"
+#include "astlib/Exception.h"
+
+#include <Poco/TemporaryFile.h>
+#include "gtest/gtest.h"
+
+using namespace astlib;
+
+class ArchiveTest:
+    public testing::Test
+{
+public:
+    ArchiveTest()
+    {
+        // 10 seconds of two radars, cat048 and cat034 blocks in one datagram
+        ArchiveWriter writer(directory.path(), 200);
+
+        for(int i = 0; i < 100; i++)
+        {
+            Poco::Timestamp time(BASE + i * 100000);
+            Byte sic = Byte(i % 2 ? 6 : 7);
+            Byte datagram[] = {
+                48, 0, 9, 0x80, 5, sic,   0x80, 5, sic,
+                34, 0, 6, 0x80, 5, sic
+            };
+            writer.write(time, datagram, sizeof(datagram));
+        }
+    }
+
+    static constexpr Poco::Timestamp::TimeVal BASE = 1500000000000000LL;
+    Poco::TemporaryFile directory;
+};
+
+constexpr Poco::Timestamp::TimeVal ArchiveTest::BASE;
+
+TEST_F(ArchiveTest, query)
+{
+    ArchiveReader reader(directory.path());
+    EXPECT_LT(1, reader.getSegmentCount());
+    EXPECT_EQ(200, reader.getBlockCount());
+    EXPECT_EQ(BASE, reader.getStartTime());
+
+    std::vector<RecordingPacket> packets;
+    ArchiveReader::Query query;
+    query.from = BASE + 1000000;
+    query.to = BASE + 2000000;
+    query.category = 48;
+    query.sac = 5;
+    query.sic = 6;
+
+    EXPECT_EQ(5, reader.query(query, packets));
+    ASSERT_EQ(5, packets.size());
+    EXPECT_EQ(BASE + 1100000, packets[0].timestamp.epochMicroseconds());
+    EXPECT_EQ(9, packets[0].size);
+    EXPECT_EQ(48, packets[0].data[0]);
+    EXPECT_EQ(6, packets[0].data[5]);
+
+    packets.clear();
+    query.category = -1;
+    query.sic = -1;
+    EXPECT_EQ(20, reader.query(query, packets));
+}
+
+TEST_F(ArchiveTest, appendSegments)
+{
+    int segments = int(ArchiveReader(directory.path()).getSegmentCount());
+    {
+        ArchiveWriter writer(directory.path());
+        Byte datagram[] = { 62, 0, 6, 0x80, 1, 2, 0xFF };
+        EXPECT_EQ(1, writer.write(Poco::Timestamp(BASE + 20000000), datagram, sizeof(datagram)));
+        EXPECT_EQ(1, writer.getDroppedBytes());
+    }
+
+    ArchiveReader reader(directory.path());
+    EXPECT_EQ(segments + 1, int(reader.getSegmentCount()));
+
+    std::vector<RecordingPacket> packets;
+    ArchiveReader::Query query;
+    query.category = 62;
+    EXPECT_EQ(1, reader.query(query, packets));
+}
+
+TEST_F(ArchiveTest, missingArchive)
+{
+    EXPECT_THROW(ArchiveReader reader(directory.path() + "/missing"), Exception);
+}
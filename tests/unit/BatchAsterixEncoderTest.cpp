@@ -0,0 +1,83 @@
+///
+/// \package astlib
+/// \file BatchAsterixEncoderTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/encoder/BatchAsterixEncoder.h"
+#include "astlib/encoder/SimpleValueEncoder.h"
+#include "astlib/specifications/entries.h"
+#include "astlib/CodecDeclarationLoader.h"
+#include "astlib/AsterixItemDictionary.h"
+
+#include "gtest/gtest.h"
+
+using namespace astlib;
+
+class BatchAsterixEncoderTest:
+    public testing::Test
+{
+public:
+    BatchAsterixEncoderTest()
+    {
+        std::istringstream stream{ std::string(cat048_1_21) };
+        codec = loader.parse(stream);
+
+        for(int i = 0; i < 100; i++)
+        {
+            auto record = std::make_shared<SimpleAsterixRecord>();
+            record->setItem(DSI_SAC, Poco::UInt64(i%7));
+            record->setItem(DSI_SIC, Poco::UInt64(i));
+            record->setItem(TRACK_NUMBER, Poco::UInt64(i*10));
+            if (i%3 == 0)
+                record->setItem(TIMEOFDAY, double(i));
+            records.push_back(record);
+        }
+    }
+
+    CodecDeclarationLoader loader;
+    CodecDescriptionPtr codec;
+    std::vector<SimpleAsterixRecordPtr> records;
+};
+
+TEST_F(BatchAsterixEncoderTest, matchesSequentialEncoding)
+{
+    BatchAsterixEncoder batch(CodecPolicy(), 4);
+    BatchAsterixEncoder::Result result;
+
+    batch.encode(*codec, records, result);
+    ASSERT_EQ(records.size(), result.size());
+
+    BinaryAsterixEncoder encoder;
+    for(size_t i = 0; i < records.size(); i++)
+    {
+        std::vector<Byte> expected;
+        SimpleValueEncoder valueEncoder(records[i]);
+        size_t length = encoder.encode(*codec, valueEncoder, expected);
+
+        ASSERT_EQ(length, result.length(i));
+        EXPECT_EQ(0, memcmp(expected.data(), result.data(i), length));
+    }
+    EXPECT_EQ(result.buffer.size(), result.offsets.back());
+}
+
+TEST_F(BatchAsterixEncoderTest, reuseAndEmptyBatch)
+{
+    BatchAsterixEncoder batch(CodecPolicy(), 3);
+    BatchAsterixEncoder::Result result;
+
+    batch.encode(*codec, records, result);
+    size_t size = result.buffer.size();
+    batch.encode(*codec, records, result);
+    EXPECT_EQ(size, result.buffer.size());
+
+    batch.encode(*codec, std::vector<SimpleAsterixRecordPtr>(), result);
+    EXPECT_EQ(0, result.size());
+    EXPECT_TRUE(result.buffer.empty());
+}
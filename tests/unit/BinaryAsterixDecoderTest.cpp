@@ -12,6 +12,7 @@
 
 #include "astlib/decoder/BinaryAsterixDecoder.h"
 #include "astlib/decoder/EmptyValueDecoder.h"
+#include "astlib/decoder/JsonValueDecoder.h"
 #include "astlib/decoder/SimpleValueDecoder.h"
 #include "astlib/specifications/entries.h"
 #include "astlib/CodecDeclarationLoader.h"
@@ -19,6 +20,7 @@
 #include "astlib/Exception.h"
 
 #include <Poco/NumberFormatter.h>
+#include <stdexcept>
 #include "gtest/gtest.h"
 
 
@@ -216,6 +218,18 @@ TEST_F(BinaryDataDekoderTest, cpuBoundDecodeCat48Simple)
     }
 }
 
+TEST_F(BinaryDataDekoderTest, cpuBoundDecodeCat48SkipBlock)
+{
+    CodecPolicy policy;
+    policy.recovery = CodecPolicy::SkipBlock;
+    BinaryAsterixDecoder blockDecoder(policy);
+
+    for(int i = 0; i < 10000; i++)
+    {
+        blockDecoder.decode(codecSpecification, defaultDecoder, standardMessage, sizeof(standardMessage));
+    }
+}
+
 TEST_F(BinaryDataDekoderTest, validDecodeCat48Simple)
 {
     class MySimpleValueDecoder :
@@ -244,3 +258,161 @@ TEST_F(BinaryDataDekoderTest, validDecodeCat48Simple)
     EXPECT_TRUE(message.getUnsigned(DSI_SIC, unsignedValue));
     EXPECT_EQ(6, unsignedValue);
 }
+
+TEST_F(BinaryDataDekoderTest, tryDecodeErrors)
+{
+    // too small packet
+    {
+        unsigned char bytes[3] = { 48, 0, 0};
+        DecodeResult result = dekoder.tryDecode(codecSpecification, emptyDecoder, bytes, sizeof(bytes));
+        EXPECT_EQ(DecodeResult::TooShort, result.error);
+    }
+    // bad lenght
+    {
+        unsigned char bytes[6] = { 48, 0, 0, 0, 0, 0};
+        DecodeResult result = dekoder.tryDecode(codecSpecification, emptyDecoder, bytes, sizeof(bytes));
+        EXPECT_EQ(DecodeResult::BadLength, result.error);
+        EXPECT_EQ(1, result.offset);
+    }
+    // no fspec data
+    {
+        unsigned char bytes[6] = { 48, 0, 6, 0, 0, 0};
+        DecodeResult result = dekoder.tryDecode(codecSpecification, emptyDecoder, bytes, sizeof(bytes));
+        EXPECT_EQ(DecodeResult::BadFspec, result.error);
+        EXPECT_EQ(3, result.offset);
+    }
+    // second record is cut by LEN
+    {
+        unsigned char bytes[8] = { 48, 0, 8, 0x80, 1, 2,   0x80, 3 };
+        DecodeResult result = dekoder.tryDecode(codecSpecification, emptyDecoder, bytes, sizeof(bytes));
+        EXPECT_EQ(DecodeResult::Truncated, result.error);
+        EXPECT_EQ(7, result.offset);
+        EXPECT_EQ(0, result.frn);
+        EXPECT_EQ(1, result.records);
+    }
+    // LEN is greater than received bytes
+    {
+        unsigned char bytes[9] = { 48, 0, 20, 0x80, 1, 2,   0x80, 3, 4 };
+        DecodeResult result = dekoder.tryDecode(codecSpecification, emptyDecoder, bytes, sizeof(bytes));
+        EXPECT_EQ(DecodeResult::Truncated, result.error);
+        EXPECT_EQ(20, result.length);
+        EXPECT_EQ(2, result.records);
+    }
+}
+
+TEST_F(BinaryDataDekoderTest, tryDecodeRecovery)
+{
+    class CountingDecoder :
+        public SimpleValueDecoder
+    {
+    public:
+        virtual void onMessageDecoded(SimpleAsterixRecordPtr ptr)
+        {
+            count++;
+        }
+
+        int count = 0;
+    };
+
+    unsigned char bytes[9] = { 48, 0, 9, 0x80, 1, 2,   0x80, 3 };
+
+    {
+        CountingDecoder counter;
+        DecodeResult result = dekoder.tryDecode(codecSpecification, counter, bytes, sizeof(bytes) - 1);
+        EXPECT_FALSE(result.ok());
+        EXPECT_EQ(1, result.records);
+        EXPECT_EQ(1, counter.count);
+    }
+    {
+        CodecPolicy policy;
+        policy.recovery = CodecPolicy::SkipBlock;
+        BinaryAsterixDecoder blockDecoder(policy);
+        CountingDecoder counter;
+        DecodeResult result = blockDecoder.tryDecode(codecSpecification, counter, bytes, sizeof(bytes) - 1);
+        EXPECT_FALSE(result.ok());
+        EXPECT_EQ(0, result.records);
+        EXPECT_EQ(0, counter.count);
+
+        bytes[8] = 4;
+        result = blockDecoder.tryDecode(codecSpecification, counter, bytes, sizeof(bytes));
+        EXPECT_TRUE(result.ok());
+        EXPECT_EQ(2, result.records);
+        EXPECT_EQ(2, counter.count);
+    }
+}
+
+TEST_F(BinaryDataDekoderTest, callbackExceptionPropagation)
+{
+    class ThrowingDecoder :
+        public SimpleValueDecoder
+    {
+    public:
+        virtual void onMessageDecoded(SimpleAsterixRecordPtr ptr)
+        {
+            throw std::out_of_range("user error");
+        }
+    } thrower;
+
+    // decode() rethrows original exception
+    EXPECT_THROW(dekoder.decode(codecSpecification, thrower, standardMessage, sizeof(standardMessage)), std::out_of_range);
+
+    // tryDecode() maps it to error code
+    DecodeResult result = dekoder.tryDecode(codecSpecification, thrower, standardMessage, sizeof(standardMessage));
+    EXPECT_EQ(DecodeResult::ValueError, result.error);
+
+    // stale error is not rethrown by next decode
+    EXPECT_NO_THROW(dekoder.decode(codecSpecification, emptyDecoder, standardMessage, sizeof(standardMessage)));
+}
+
+TEST_F(BinaryDataDekoderTest, callbackExceptionRecovery)
+{
+    // Forwards to Json decoder, fails in the middle of record on demand
+    class FailingDecoder :
+        public ValueDecoder
+    {
+    public:
+        FailingDecoder(ValueDecoder& target) :
+            target(target)
+        {
+        }
+        void begin(int cat) { target.begin(cat); }
+        void beginItem(const ItemDescription& uapItem) { target.beginItem(uapItem); }
+        void beginRepetitive(size_t size) { target.beginRepetitive(size); }
+        void repetitiveItem(int index) { target.repetitiveItem(index); }
+        void endRepetitive() { target.endRepetitive(); }
+        void beginArray(AsterixItemCode code, size_t size) { target.beginArray(code, size); }
+        void end() { target.end(); }
+        void abort() { target.abort(); }
+        void decode(const CodecContext& ctx, Poco::UInt64 value, int index)
+        {
+            if (failing)
+                throw std::out_of_range("user error");
+            target.decode(ctx, value, index);
+        }
+
+        ValueDecoder& target;
+        bool failing = true;
+    };
+
+    JsonValueDecoder json(false);
+    FailingDecoder failing(json);
+
+    DecodeResult result = dekoder.tryDecode(codecSpecification, failing, standardMessage, sizeof(standardMessage));
+    EXPECT_EQ(DecodeResult::ValueError, result.error);
+
+    failing.failing = false;
+    EXPECT_TRUE(dekoder.tryDecode(codecSpecification, failing, standardMessage, sizeof(standardMessage)).ok());
+
+    std::string text;
+    json.takeOutput(text);
+
+    // Only the good block is written, as by fresh decoder
+    JsonValueDecoder reference(false);
+    BinaryAsterixDecoder referenceDecoder;
+    referenceDecoder.decode(codecSpecification, reference, standardMessage, sizeof(standardMessage));
+    std::string expected;
+    reference.takeOutput(expected);
+
+    EXPECT_FALSE(text.empty());
+    EXPECT_EQ(expected, text);
+}
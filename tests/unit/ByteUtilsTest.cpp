@@ -11,6 +11,7 @@
 ///
 
 #include "astlib/ByteUtils.h"
+#include "astlib/Exception.h"
 #include "gtest/gtest.h"
 
 using namespace astlib;
@@ -58,3 +59,73 @@ TEST(ByteUtilsTest, pokeBigEndian)
         EXPECT_EQ(0x44, buffer[7]);
     }
 }
+
+TEST(ByteUtilsTest, packSixBitString)
+{
+    EXPECT_EQ(0x5054d4c31820ULL, ByteUtils::packSixBitString("TEST01"));
+    EXPECT_EQ(0x092071c31820ULL, ByteUtils::packSixBitString("BRA101"));
+    EXPECT_EQ(0x820820820820ULL, ByteUtils::packSixBitString(""));
+}
+
+TEST(ByteUtilsTest, parseHex)
+{
+    EXPECT_EQ(0x1AFULL, ByteUtils::parseHex("1af"));
+    EXPECT_EQ(0x1AFULL, ByteUtils::parseHex("0x1AF"));
+    EXPECT_EQ(0xFFFFFFFFFFFFFFFFULL, ByteUtils::parseHex("FFFFFFFFFFFFFFFF"));
+    EXPECT_THROW(ByteUtils::parseHex(""), Exception);
+    EXPECT_THROW(ByteUtils::parseHex("12G4"), Exception);
+}
+
+TEST(ByteUtilsTest, peekPokeBits)
+{
+    Byte buffer[3] = {0x12, 0x34, 0x56};
+    EXPECT_EQ(0x345ULL, ByteUtils::peekBits(buffer, 3, 4, 12));
+    EXPECT_EQ(0x123456ULL, ByteUtils::peekBits(buffer, 3, 0, 24));
+
+    ByteUtils::pokeBits(buffer, 3, 4, 12, 0xABC);
+    EXPECT_EQ(0x12, buffer[0]);
+    EXPECT_EQ(0xAB, buffer[1]);
+    EXPECT_EQ(0xC6, buffer[2]);
+}
+
+TEST(ByteUtilsTest, wideFixedBits)
+{
+    Byte buffer[20];
+    memset(buffer, 0xFF, sizeof(buffer));
+
+    // 64 bit field spanning 9 bytes
+    ByteUtils::pokeBits(buffer, sizeof(buffer), 60, 64, 0x0123456789ABCDEFULL);
+    EXPECT_EQ(0x0123456789ABCDEFULL, ByteUtils::peekBits(buffer, sizeof(buffer), 60, 64));
+    EXPECT_EQ(0xFULL, ByteUtils::peekBits(buffer, sizeof(buffer), 56, 4));
+    EXPECT_EQ(0xFULL, ByteUtils::peekBits(buffer, sizeof(buffer), 124, 4));
+
+    EXPECT_EQ(-1, ByteUtils::toSigned(0xFFFFFFFFFFFFFFFFULL, 64));
+    EXPECT_EQ(-1, ByteUtils::toSigned(1, 1));
+}
+
+TEST(ByteUtilsTest, scanFxChain)
+{
+    Byte buffer[70];
+    memset(buffer, 0xFF, sizeof(buffer));
+
+    EXPECT_EQ(0, ByteUtils::scanFxChain(buffer, sizeof(buffer)));
+    for (size_t end = 0; end < sizeof(buffer); end++)
+    {
+        buffer[end] = 0xFE;
+        EXPECT_EQ(end+1, ByteUtils::scanFxChain(buffer, sizeof(buffer)));
+        EXPECT_EQ(0, ByteUtils::scanFxChain(buffer, end));
+        buffer[end] = 0xFF;
+    }
+}
+
+TEST(ByteUtilsTest, expandFspec)
+{
+    Byte fspec[3] = { 0xC1, 0x01, 0x82 };
+    int frns[21];
+
+    ASSERT_EQ(4, ByteUtils::expandFspec(fspec, 3, frns));
+    EXPECT_EQ(0, frns[0]);
+    EXPECT_EQ(1, frns[1]);
+    EXPECT_EQ(16, frns[2]);
+    EXPECT_EQ(22, frns[3]);
+}
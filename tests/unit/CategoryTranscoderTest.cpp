@@ -0,0 +1,151 @@
+///
+/// \package astlib
+/// \file CategoryTranscoderTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/encoder/CategoryTranscoder.h"
+#include "astlib/encoder/SimpleValueEncoder.h"
+#include "astlib/decoder/BinaryAsterixDecoder.h"
+#include "astlib/decoder/SimpleValueDecoder.h"
+#include "astlib/specifications/entries.h"
+#include "astlib/CodecDeclarationLoader.h"
+#include "astlib/AsterixItemDictionary.h"
+#include "astlib/Exception.h"
+
+#include "gtest/gtest.h"
+
+using namespace astlib;
+
+class CategoryTranscoderTest:
+    public testing::Test
+{
+public:
+    CategoryTranscoderTest()
+    {
+        CodecDeclarationLoader loader;
+
+        std::istringstream stream48{ std::string(cat048_1_21) };
+        codec48 = loader.parse(stream48);
+
+        std::istringstream stream62{ std::string(cat062_1_16) };
+        codec62 = loader.parse(stream62);
+
+        std::istringstream stream01{ std::string(cat001_1_1) };
+        codec01 = loader.parse(stream01);
+    }
+
+    class MyDecoder:
+        public SimpleValueDecoder
+    {
+    public:
+        virtual void onMessageDecoded(SimpleAsterixRecordPtr ptr)
+        {
+            msgs.push_back(ptr);
+        }
+
+        std::vector<SimpleAsterixRecordPtr> msgs;
+    } valueDecoder;
+
+    CodecDescriptionPtr codec01;
+    CodecDescriptionPtr codec48;
+    CodecDescriptionPtr codec62;
+};
+
+TEST_F(CategoryTranscoderTest, cat48ToCat62)
+{
+    auto record = std::make_shared<SimpleAsterixRecord>();
+    record->setItem(DSI_SAC, Poco::UInt64(10));
+    record->setItem(DSI_SIC, Poco::UInt64(20));
+    record->setItem(TIMEOFDAY, 1000.5);
+    record->setItem(TRACK_NUMBER, Poco::UInt64(333));
+
+    std::vector<Byte> source;
+    BinaryAsterixEncoder encoder;
+    SimpleValueEncoder valueEncoder(record);
+    encoder.appendRecord(*codec48, valueEncoder, source);
+    encoder.appendRecord(*codec48, valueEncoder, source);
+
+    CategoryTranscoder transcoder(codec48, codec62);
+    EXPECT_LT(0, transcoder.getMappingCount());
+
+    std::vector<Byte> target;
+    EXPECT_EQ(2, transcoder.transcode(source.data(), source.size(), target));
+    EXPECT_EQ(62, target[0]);
+
+    BinaryAsterixDecoder decoder;
+    decoder.decode(*codec62, valueDecoder, target.data(), target.size());
+    ASSERT_EQ(2, valueDecoder.msgs.size());
+
+    for(auto msg: valueDecoder.msgs)
+    {
+        Poco::UInt64 value = 0;
+        double real = 0;
+
+        EXPECT_TRUE(msg->getUnsigned(DSI_SAC, value));
+        EXPECT_EQ(10, value);
+        EXPECT_TRUE(msg->getUnsigned(DSI_SIC, value));
+        EXPECT_EQ(20, value);
+        EXPECT_TRUE(msg->getUnsigned(TRACK_NUMBER, value));
+        EXPECT_EQ(333, value);
+        EXPECT_TRUE(msg->getReal(TIMEOFDAY, real));
+        EXPECT_DOUBLE_EQ(1000.5, real);
+    }
+}
+
+TEST_F(CategoryTranscoderTest, cat01ToCat48)
+{
+    // Range LSB is 1/128 NM in cat001 and 1/256 NM in cat048, raw value is rescaled
+    auto record = std::make_shared<SimpleAsterixRecord>();
+    record->setItem(DSI_SAC, Poco::UInt64(7));
+    record->setItem(DSI_SIC, Poco::UInt64(9));
+    record->setItem(TRACK_POSITION_RANGE, 100.5);
+    record->setItem(TRACK_POSITION_AZIMUTH, 45.0);
+    record->setItem(TIMEOFDAY, 300.25);
+
+    std::vector<Byte> source;
+    BinaryAsterixEncoder encoder;
+    SimpleValueEncoder valueEncoder(record);
+    encoder.appendRecord(*codec01, valueEncoder, source);
+
+    CategoryTranscoder transcoder(codec01, codec48);
+    EXPECT_LT(0, transcoder.getMappingCount());
+    EXPECT_LT(0, transcoder.getCopiedItemCount());
+
+    std::vector<Byte> target;
+    EXPECT_EQ(1, transcoder.transcode(source.data(), source.size(), target));
+    EXPECT_EQ(48, target[0]);
+
+    BinaryAsterixDecoder decoder;
+    decoder.decode(*codec48, valueDecoder, target.data(), target.size());
+    ASSERT_EQ(1, valueDecoder.msgs.size());
+
+    const SimpleAsterixRecordPtr& msg = valueDecoder.msgs.front();
+    Poco::UInt64 value = 0;
+    double real = 0;
+
+    EXPECT_TRUE(msg->getUnsigned(DSI_SAC, value));
+    EXPECT_EQ(7, value);
+    EXPECT_TRUE(msg->getUnsigned(DSI_SIC, value));
+    EXPECT_EQ(9, value);
+    EXPECT_TRUE(msg->getReal(TRACK_POSITION_RANGE, real));
+    EXPECT_DOUBLE_EQ(100.5, real);
+    EXPECT_TRUE(msg->getReal(TRACK_POSITION_AZIMUTH, real));
+    EXPECT_DOUBLE_EQ(45.0, real);
+    EXPECT_TRUE(msg->getReal(TIMEOFDAY, real));
+    EXPECT_DOUBLE_EQ(300.25, real);
+}
+
+TEST_F(CategoryTranscoderTest, wrongCategory)
+{
+    CategoryTranscoder transcoder(codec48, codec62);
+    Byte buffer[] = { 62, 0, 6, 0x80, 1, 2 };
+    std::vector<Byte> target;
+    EXPECT_THROW(transcoder.transcode(buffer, sizeof(buffer), target), Exception);
+}
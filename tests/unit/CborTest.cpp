@@ -0,0 +1,134 @@
+///
+/// \package astlib
+/// \file CborTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/io/CborReader.h"
+#include "astlib/io/CborWriter.h"
+#include "astlib/Exception.h"
+
+#include <cmath>
+#include <limits>
+#include "gtest/gtest.h"
+
+using namespace astlib;
+
+static std::string hex(const std::string& data)
+{
+    static const char HEX[] = "0123456789abcdef";
+    std::string text;
+    for(unsigned char c: data)
+    {
+        text += HEX[c >> 4];
+        text += HEX[c & 15];
+    }
+    return text;
+}
+
+static std::string bytes(const std::string& text)
+{
+    std::string data;
+    for(size_t i = 0; i + 1 < text.size(); i += 2)
+        data += char(std::stoi(text.substr(i, 2), nullptr, 16));
+    return data;
+}
+
+// Examples from RFC 8949, Appendix A
+TEST(CborTest, writer)
+{
+    auto encode = [](Poco::Int64 value) { std::string out; CborWriter::appendNumber(out, value); return hex(out); };
+    EXPECT_EQ("00", encode(0));
+    EXPECT_EQ("17", encode(23));
+    EXPECT_EQ("1818", encode(24));
+    EXPECT_EQ("1903e8", encode(1000));
+    EXPECT_EQ("1a000f4240", encode(1000000));
+    EXPECT_EQ("1b000000e8d4a51000", encode(1000000000000));
+    EXPECT_EQ("20", encode(-1));
+    EXPECT_EQ("3903e7", encode(-1000));
+    EXPECT_EQ("3b7fffffffffffffff", encode(std::numeric_limits<Poco::Int64>::min()));
+
+    auto real = [](double value) { std::string out; CborWriter::appendNumber(out, value); return hex(out); };
+    EXPECT_EQ("fa47c35000", real(100000.0));
+    EXPECT_EQ("fb3ff199999999999a", real(1.1));
+    EXPECT_EQ("fa7f800000", real(std::numeric_limits<double>::infinity()));
+    EXPECT_EQ("fb7e37e43c8800759c", real(1.0e+300));
+
+    CborWriter writer;
+    writer.beginMap(2);
+    writer.value(1);
+    writer.beginArray(3);
+    writer.value(true);
+    writer.null();
+    writer.value(std::string("a"));
+    writer.value(Poco::UInt64(18446744073709551615ull));
+    writer.value(false);
+    EXPECT_EQ("a201" "83f5f66161" "1bffffffffffffffff" "f4", hex(writer.getBuffer()));
+}
+
+TEST(CborTest, reader)
+{
+    std::string data = bytes("a201" "83f5f66161" "1bffffffffffffffff" "f4" "f93e00" "f97c00" "f90400" "3903e7");
+    CborReader reader(data.data(), data.size());
+
+    EXPECT_EQ(CborReader::Map, reader.peek());
+    EXPECT_EQ(2, reader.readMap());
+    EXPECT_EQ(1, reader.readSigned());
+    EXPECT_EQ(3, reader.readArray());
+    EXPECT_TRUE(reader.readBoolean());
+    reader.readNull();
+
+    // Text is a view into the input
+    size_t size = 0;
+    const char* text = reader.readText(size);
+    EXPECT_EQ(1, size);
+    EXPECT_EQ(data.data() + 6, text);
+
+    EXPECT_THROW(reader.readSigned(), Exception);
+    EXPECT_EQ(18446744073709551615ull, reader.readUnsigned());
+    EXPECT_FALSE(reader.readBoolean());
+    EXPECT_EQ(1.5, reader.readReal());
+    EXPECT_TRUE(std::isinf(reader.readReal()));
+    EXPECT_EQ(6.103515625e-05, reader.readReal());
+    EXPECT_EQ(-1000.0, reader.readReal());
+    EXPECT_TRUE(reader.atEnd());
+}
+
+TEST(CborTest, skip)
+{
+    CborWriter writer;
+    writer.beginArray(2);
+    writer.beginMap(1);
+    writer.value(std::string("key"));
+    writer.beginArray(2);
+    writer.value(1.1);
+    writer.value(-5);
+    writer.value(7);
+    writer.value(8);
+
+    CborReader reader(writer.getBuffer().data(), writer.size());
+    reader.skip();
+    EXPECT_EQ(8, reader.readUnsigned());
+    EXPECT_TRUE(reader.atEnd());
+}
+
+TEST(CborTest, malformed)
+{
+    // Truncated argument, text longer than input, indefinite length, oversized array
+    for(const char* text: { "19", "6461", "9f", "9a00010000" })
+    {
+        std::string data = bytes(text);
+        CborReader reader(data.data(), data.size());
+        EXPECT_THROW(reader.skip(), Exception) << text;
+    }
+
+    std::string empty;
+    CborReader reader(empty.data(), 0);
+    EXPECT_THROW(reader.peek(), Exception);
+}
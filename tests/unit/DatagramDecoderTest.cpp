@@ -0,0 +1,116 @@
+///
+/// \package astlib
+/// \file DatagramDecoderTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/decoder/DatagramDecoder.h"
+#include "astlib/decoder/SimpleValueDecoder.h"
+#include "astlib/specifications/entries.h"
+#include "astlib/CodecDeclarationLoader.h"
+#include "astlib/AsterixItemDictionary.h"
+
+#include "gtest/gtest.h"
+
+using namespace astlib;
+
+class DatagramDecoderTest:
+    public testing::Test
+{
+public:
+    DatagramDecoderTest()
+    {
+        CodecDeclarationLoader loader;
+
+        std::istringstream stream48{ std::string(cat048_1_21) };
+        decoder.setCodec(loader.parse(stream48));
+
+        std::istringstream stream62{ std::string(cat062_1_16) };
+        decoder.setCodec(loader.parse(stream62));
+    }
+
+    class MyDecoder:
+        public SimpleValueDecoder
+    {
+    public:
+        virtual void onMessageDecoded(SimpleAsterixRecordPtr ptr)
+        {
+            Poco::UInt64 sac = 0;
+            ptr->getUnsigned(DSI_SAC, sac);
+            sacs.push_back(int(sac));
+        }
+
+        std::vector<int> sacs;
+    } valueDecoder;
+
+    DatagramDecoder decoder;
+};
+
+TEST_F(DatagramDecoderTest, multipleBlocks)
+{
+    unsigned char bytes[] = {
+        48, 0, 9, 0x80, 1, 2,   0x80, 3, 4,
+        62, 0, 6, 0x80, 5, 6,
+        62, 0, 3
+    };
+    auto result = decoder.decode(valueDecoder, bytes, sizeof(bytes));
+
+    EXPECT_TRUE(result.ok());
+    EXPECT_EQ(3, result.blocks);
+    EXPECT_EQ(3, result.records);
+    EXPECT_EQ((std::vector<int>{1, 3, 5}), valueDecoder.sacs);
+}
+
+TEST_F(DatagramDecoderTest, unknownCategory)
+{
+    unsigned char bytes[] = {
+        1, 0, 5, 0x80, 0,
+        48, 0, 6, 0x80, 1, 2
+    };
+    auto result = decoder.decode(valueDecoder, bytes, sizeof(bytes));
+
+    EXPECT_TRUE(result.ok());
+    EXPECT_EQ(1, result.blocks);
+    EXPECT_EQ(1, result.unknownBlocks);
+    EXPECT_EQ((std::vector<int>{1}), valueDecoder.sacs);
+}
+
+TEST_F(DatagramDecoderTest, resynchronise)
+{
+    unsigned char bytes[] = {
+        48, 0, 6, 0x80, 1, 2,
+        0xAA, 0xBB,             // garbage
+        62, 0, 6, 0x80, 5, 6
+    };
+    auto result = decoder.decode(valueDecoder, bytes, sizeof(bytes));
+
+    EXPECT_FALSE(result.ok());
+    EXPECT_EQ(2, result.blocks);
+    EXPECT_EQ(1, result.badBlocks);
+    EXPECT_EQ(2, result.skippedBytes);
+    EXPECT_EQ(6, result.lastError.offset);
+    EXPECT_EQ((std::vector<int>{1, 5}), valueDecoder.sacs);
+}
+
+TEST_F(DatagramDecoderTest, corruptedBlock)
+{
+    unsigned char bytes[] = {
+        48, 0, 6, 0x80, 1, 2,
+        48, 0, 5, 0x80, 3,      // record cut by LEN
+        62, 0, 6, 0x80, 5, 6
+    };
+    auto result = decoder.decode(valueDecoder, bytes, sizeof(bytes));
+
+    EXPECT_EQ(2, result.blocks);
+    EXPECT_EQ(1, result.badBlocks);
+    EXPECT_EQ(0, result.skippedBytes);
+    EXPECT_EQ(DecodeResult::Truncated, result.lastError.error);
+    EXPECT_EQ(10, result.lastError.offset);
+    EXPECT_EQ((std::vector<int>{1, 5}), valueDecoder.sacs);
+}
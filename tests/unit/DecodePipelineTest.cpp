@@ -0,0 +1,353 @@
+///
+/// \package astlib
+/// \file DecodePipelineTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/pipeline/DecodePipeline.h"
+#include "astlib/specifications/entries.h"
+#include "astlib/CodecDeclarationLoader.h"
+#include "astlib/Exception.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <thread>
+#include "gtest/gtest.h"
+
+using namespace astlib;
+
+class DecodePipelineTest:
+    public testing::Test
+{
+public:
+    DecodePipelineTest()
+    {
+        CodecDeclarationLoader loader;
+        std::istringstream stream{ std::string(cat048_1_21) };
+        codecRegister.addCodec(loader.parse(stream));
+        payload = { 48, 0, 9, 0x80, 1, 2, 0x80, 3, 4 };
+    }
+
+    std::vector<RecordingPacket> packets(size_t count) const
+    {
+        RecordingPacket packet;
+        packet.data = payload.data();
+        packet.size = payload.size();
+        packet.timestamp = Poco::Timestamp(1000000);
+        return std::vector<RecordingPacket>(count, packet);
+    }
+
+    void write(const std::string& text)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        output += text;
+        writes++;
+    }
+
+    CodecRegister codecRegister;
+    std::vector<Byte> payload;
+    std::mutex mutex;
+    std::string output;
+    size_t writes = 0;
+};
+
+TEST(QueueTest, spsc)
+{
+    SpscQueue<int> queue(3);
+    int value = 0;
+
+    EXPECT_EQ(4, queue.capacity());
+    EXPECT_FALSE(queue.pop(value));
+    for(int i = 0; i < 4; i++)
+        EXPECT_TRUE(queue.push(i));
+    EXPECT_FALSE(queue.push(4));
+    EXPECT_EQ(4, queue.size());
+
+    // Wrap around the ring several times
+    for(int i = 0; i < 100; i++)
+    {
+        ASSERT_TRUE(queue.pop(value));
+        EXPECT_EQ(i, value);
+        EXPECT_TRUE(queue.push(i + 4));
+    }
+}
+
+TEST(QueueTest, spscThreads)
+{
+    SpscQueue<int> queue(64);
+    const int count = 200000;
+    long long sum = 0;
+
+    std::thread consumer([&]()
+    {
+        int expected = 0, value = 0;
+        while (expected < count)
+        {
+            if (queue.pop(value))
+            {
+                EXPECT_EQ(expected, value);
+                sum += value;
+                expected++;
+            }
+            else
+                std::this_thread::yield();
+        }
+    });
+    for(int i = 0; i < count;)
+    {
+        if (queue.push(i))
+            i++;
+        else
+            std::this_thread::yield();
+    }
+    consumer.join();
+    EXPECT_EQ((long long)count * (count - 1) / 2, sum);
+}
+
+TEST(QueueTest, mpmcThreads)
+{
+    MpmcQueue<int> queue(128);
+    const int producers = 4, consumers = 4, count = 50000;
+    std::atomic<long long> sum { 0 };
+    std::atomic<int> received { 0 };
+    std::vector<std::thread> threads;
+
+    for(int p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&queue]()
+        {
+            for(int i = 1; i <= count;)
+            {
+                if (queue.push(i))
+                    i++;
+                else
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for(int c = 0; c < consumers; c++)
+    {
+        threads.emplace_back([&]()
+        {
+            int value = 0;
+            while (received < producers * count)
+            {
+                if (queue.pop(value))
+                {
+                    sum += value;
+                    received++;
+                }
+                else
+                    std::this_thread::yield();
+            }
+        });
+    }
+    for(auto& thread: threads)
+        thread.join();
+
+    EXPECT_EQ((long long)producers * count * (count + 1) / 2, sum);
+    EXPECT_TRUE(queue.empty());
+}
+
+TEST_F(DecodePipelineTest, decode)
+{
+    DecodePipeline pipeline(codecRegister, [this](const std::string& text) { write(text); }, 3, 8, DecodePipeline::Block);
+    pipeline.getShedder().setThreshold(LoadShedder::Low, 1.0);
+    pipeline.start();
+    for(int i = 0; i < 100; i++)
+        EXPECT_TRUE(pipeline.push(packets(5)));
+    pipeline.stop();
+
+    EXPECT_EQ(500, pipeline.getPacketCount());
+    EXPECT_EQ(1000, pipeline.getRecordCount());
+    EXPECT_EQ(0, pipeline.getDropCount());
+    EXPECT_LE(writes, 100);
+    EXPECT_NE(std::string::npos, output.find("timestamp"));
+}
+
+TEST_F(DecodePipelineTest, sink)
+{
+    // Sink collecting whole batches, poll() is called by idle output thread
+    struct CollectingSink :
+        public OutputSink
+    {
+        void write(const char* data, size_t size) override
+        {
+            text.append(data, size);
+        }
+        void poll() override
+        {
+            polls++;
+        }
+        void flush() override
+        {
+            flushes++;
+        }
+        std::string text;
+        std::atomic<size_t> polls { 0 };
+        size_t flushes = 0;
+    } sink;
+
+    DecodePipeline pipeline(codecRegister, sink, 2, 8, DecodePipeline::Block, false);
+    pipeline.getShedder().setThreshold(LoadShedder::Low, 1.0);
+    pipeline.start();
+    for(int i = 0; i < 10; i++)
+        EXPECT_TRUE(pipeline.push(packets(3)));
+    while (sink.polls == 0)
+        std::this_thread::yield();
+    pipeline.stop();
+
+    EXPECT_EQ(60, std::count(sink.text.begin(), sink.text.end(), '\n'));
+    EXPECT_EQ(1, sink.flushes);
+}
+
+TEST_F(DecodePipelineTest, dropPolicy)
+{
+    // Not started pipeline keeps everything queued, like stalled workers
+    DecodePipeline newest(codecRegister, [this](const std::string& text) { write(text); }, 1, 4, DecodePipeline::DropNewest);
+    newest.getShedder().setThreshold(LoadShedder::Low, 1.0);
+    for(int i = 0; i < 6; i++)
+        newest.push(packets(2));
+    EXPECT_EQ(8, newest.getPacketCount());
+    EXPECT_EQ(4, newest.getDropCount());
+    EXPECT_EQ(4, newest.getQueueDepth());
+
+    DecodePipeline oldest(codecRegister, [this](const std::string& text) { write(text); }, 1, 4, DecodePipeline::DropOldest);
+    oldest.getShedder().setThreshold(LoadShedder::Low, 1.0);
+    for(int i = 0; i < 6; i++)
+        EXPECT_TRUE(oldest.push(packets(i + 1)));
+    EXPECT_EQ(1 + 2, oldest.getDropCount());
+    EXPECT_EQ(4, oldest.getQueueDepth());
+
+    // Queued batches are drained on stop
+    oldest.start();
+    oldest.stop();
+    EXPECT_EQ(2 * (3 + 4 + 5 + 6), oldest.getRecordCount());
+}
+
+TEST_F(DecodePipelineTest, shedding)
+{
+    DecodePipeline pipeline(codecRegister, [this](const std::string& text) { write(text); }, 1, 8, DecodePipeline::DropNewest);
+
+    // Plots are shed from half full queue
+    for(int i = 0; i < 8; i++)
+        EXPECT_TRUE(pipeline.push(packets(1)));
+    EXPECT_EQ(5, pipeline.getQueueDepth());
+    EXPECT_EQ(3, pipeline.getShedder().getShedCount(48));
+
+    // North markers use the free batches and then displace waiting plots
+    payload[0] = 34;
+    for(int i = 0; i < 5; i++)
+        EXPECT_TRUE(pipeline.push(packets(1)));
+    EXPECT_EQ(8, pipeline.getQueueDepth());
+    EXPECT_EQ(2, pipeline.getDropCount());
+    EXPECT_EQ(2, pipeline.getShedder().getEvictCount(48));
+
+    // Anything else is shed by the full queue before the drop policy
+    payload[0] = 62;
+    EXPECT_TRUE(pipeline.push(packets(1)));
+    EXPECT_EQ(2, pipeline.getDropCount());
+    EXPECT_EQ(4, pipeline.getShedder().getShedCount());
+    EXPECT_EQ(1, pipeline.getShedder().getShedCount(62));
+    EXPECT_EQ(0, pipeline.getShedder().getDropCount());
+    EXPECT_EQ(10, pipeline.getPacketCount());
+}
+
+TEST_F(DecodePipelineTest, criticalReserve)
+{
+    // Plots are shed up to the High threshold, last free batch is left for critical data
+    DecodePipeline pipeline(codecRegister, [this](const std::string& text) { write(text); }, 1, 20, DecodePipeline::DropNewest);
+    pipeline.getShedder().setThreshold(LoadShedder::Low, 0.9);
+
+    for(int i = 0; i < 20; i++)
+        EXPECT_TRUE(pipeline.push(packets(1)));
+    EXPECT_EQ(19, pipeline.getQueueDepth());
+    EXPECT_EQ(1, pipeline.getShedder().getShedCount(48));
+    EXPECT_EQ(0, pipeline.getShedder().getDropCount());
+
+    payload[0] = 34;
+    for(int i = 0; i < 2; i++)
+        EXPECT_TRUE(pipeline.push(packets(1)));
+    EXPECT_EQ(20, pipeline.getQueueDepth());
+    EXPECT_EQ(1, pipeline.getShedder().getEvictCount(48));
+}
+
+TEST_F(DecodePipelineTest, criticalEviction)
+{
+    DecodePipeline pipeline(codecRegister, [this](const std::string& text) { write(text); }, 1, 4, DecodePipeline::DropOldest);
+    pipeline.getShedder().setThreshold(LoadShedder::Low, 1.0);
+
+    // The oldest waiting plot gives way to north markers
+    EXPECT_TRUE(pipeline.push(packets(1)));
+    payload[0] = 34;
+    for(int i = 0; i < 4; i++)
+        EXPECT_TRUE(pipeline.push(packets(2)));
+    EXPECT_EQ(4, pipeline.getQueueDepth());
+    EXPECT_EQ(1, pipeline.getShedder().getEvictCount(48));
+
+    // Queue of critical batches drops new plots instead
+    payload[0] = 48;
+    EXPECT_FALSE(pipeline.push(packets(1)));
+    EXPECT_EQ(1, pipeline.getShedder().getEvictCount(48));
+    EXPECT_EQ(1, pipeline.getShedder().getDropCount(48));
+    EXPECT_EQ(2, pipeline.getDropCount());
+
+    // More critical batches than depth wait for workers, none is evicted
+    payload[0] = 34;
+    std::thread receiver([this, &pipeline]()
+    {
+        for(int i = 0; i < 8; i++)
+            EXPECT_TRUE(pipeline.push(packets(2)));
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    pipeline.start();
+    receiver.join();
+    pipeline.stop();
+
+    EXPECT_EQ(1 + 8 + 16, pipeline.getPacketCount());
+    EXPECT_EQ(0, pipeline.getShedder().getEvictCount(34));
+    EXPECT_EQ(1, pipeline.getShedder().getEvictCount());
+    EXPECT_EQ(2, pipeline.getDropCount());
+}
+
+TEST_F(DecodePipelineTest, feedTagging)
+{
+    DecodePipeline pipeline(codecRegister, [this](const std::string& text) { write(text); }, 1, 8, DecodePipeline::Block, false);
+    pipeline.setFeedNames({ "radar1", "radar2" });
+
+    std::vector<RecordingPacket> batch = packets(2);
+    batch[1].feed = 1;
+    batch[1].sourceAddress = 0x0A000102;
+    batch[1].sourcePort = 8600;
+
+    pipeline.start();
+    EXPECT_TRUE(pipeline.push(batch));
+    pipeline.stop();
+
+    EXPECT_NE(std::string::npos, output.find("\"feed\":\"radar1\""));
+    EXPECT_NE(std::string::npos, output.find("\"feed\":\"radar2\",\"source\":\"10.0.1.2:8600\""));
+}
+
+TEST_F(DecodePipelineTest, outputFailure)
+{
+    DecodePipeline pipeline(codecRegister, [](const std::string&) { throw Exception("disk full"); });
+    pipeline.start();
+    pipeline.push(packets(1));
+    EXPECT_THROW(pipeline.stop(), Exception);
+}
+
+TEST_F(DecodePipelineTest, parsePolicy)
+{
+    EXPECT_EQ(DecodePipeline::Block, DecodePipeline::parsePolicy("block"));
+    EXPECT_EQ(DecodePipeline::DropNewest, DecodePipeline::parsePolicy("newest"));
+    EXPECT_EQ(DecodePipeline::DropOldest, DecodePipeline::parsePolicy("oldest"));
+    EXPECT_THROW(DecodePipeline::parsePolicy("random"), Exception);
+}
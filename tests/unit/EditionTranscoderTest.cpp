@@ -0,0 +1,124 @@
+///
+/// \package astlib
+/// \file EditionTranscoderTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/encoder/EditionTranscoder.h"
+#include "astlib/encoder/SimpleValueEncoder.h"
+#include "astlib/decoder/BinaryAsterixDecoder.h"
+#include "astlib/decoder/SimpleValueDecoder.h"
+#include "astlib/model/FixedItemDescription.h"
+#include "astlib/specifications/entries.h"
+#include "astlib/CodecDeclarationLoader.h"
+#include "astlib/AsterixItemDictionary.h"
+#include "astlib/Exception.h"
+
+#include "gtest/gtest.h"
+
+using namespace astlib;
+
+class EditionTranscoderTest:
+    public testing::Test
+{
+public:
+    EditionTranscoderTest()
+    {
+        CodecDeclarationLoader loader;
+
+        std::istringstream stream{ std::string(cat048_1_21) };
+        codec = loader.parse(stream);
+
+        std::istringstream stream2{ std::string(cat048_1_21) };
+        edition = loader.parse(stream2);
+
+        auto record = std::make_shared<SimpleAsterixRecord>();
+        record->setItem(DSI_SAC, Poco::UInt64(10));
+        record->setItem(DSI_SIC, Poco::UInt64(20));
+        record->setItem(TIMEOFDAY, 1000.5);
+        record->setItem(TRACK_NUMBER, Poco::UInt64(333));
+
+        BinaryAsterixEncoder encoder;
+        SimpleValueEncoder valueEncoder(record);
+        encoder.encode(*codec, valueEncoder, source);
+    }
+
+    CodecDescriptionPtr codec;
+    CodecDescriptionPtr edition;
+    std::vector<Byte> source;
+};
+
+TEST_F(EditionTranscoderTest, sameEditionIsCopy)
+{
+    EditionTranscoder transcoder(codec, edition);
+    std::vector<Byte> target;
+
+    EXPECT_EQ(1, transcoder.transcode(source.data(), source.size(), target));
+    EXPECT_EQ(0, transcoder.getMappingCount());
+    EXPECT_EQ(source, target);
+}
+
+TEST_F(EditionTranscoderTest, changedItemIsReencoded)
+{
+    // Time of day with finer resolution in the new edition
+    BitsDescription bits(TIMEOFDAY);
+    bits.name = "timeofday";
+    bits.from = 32;
+    bits.to = 1;
+    bits.scale = 1.0/1024;
+    bits.compile();
+    edition->addDataItem(std::make_shared<FixedItemDescription>(140, "Time of Day", Fixed(BitsDescriptionArray{bits}, 4)));
+
+    for(const auto& entry: edition->enumerateUapItems())
+    {
+        if (entry.second.item && entry.second.item->getId() == 140)
+        {
+            edition->addUapItem(entry.first, 140, entry.second.mandatory);
+            break;
+        }
+    }
+
+    EditionTranscoder transcoder(codec, edition);
+    std::vector<Byte> target;
+
+    EXPECT_EQ(1, transcoder.transcode(source.data(), source.size(), target));
+    EXPECT_EQ(1, transcoder.getMappingCount());
+    EXPECT_EQ(source.size()+1, target.size());
+
+    class MyDecoder:
+        public SimpleValueDecoder
+    {
+    public:
+        virtual void onMessageDecoded(SimpleAsterixRecordPtr ptr)
+        {
+            msg = ptr;
+        }
+
+        SimpleAsterixRecordPtr msg;
+    } valueDecoder;
+
+    BinaryAsterixDecoder decoder;
+    decoder.decode(*edition, valueDecoder, target.data(), target.size());
+
+    Poco::UInt64 value = 0;
+    double real = 0;
+    EXPECT_TRUE(valueDecoder.msg->getUnsigned(TRACK_NUMBER, value));
+    EXPECT_EQ(333, value);
+    EXPECT_TRUE(valueDecoder.msg->getReal(TIMEOFDAY, real));
+    EXPECT_DOUBLE_EQ(1000.5, real);
+}
+
+TEST_F(EditionTranscoderTest, differentCategories)
+{
+    CodecDeclarationLoader loader;
+    std::istringstream stream{ std::string(cat062_1_16) };
+    auto codec62 = loader.parse(stream);
+
+    EXPECT_THROW(EditionTranscoder transcoder(codec, codec62), Exception);
+}
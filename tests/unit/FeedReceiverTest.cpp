@@ -0,0 +1,170 @@
+///
+/// \package astlib
+/// \file FeedReceiverTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/network/FeedReceiver.h"
+#include "astlib/Exception.h"
+
+#include <Poco/Net/DatagramSocket.h>
+#include "gtest/gtest.h"
+
+using namespace astlib;
+
+TEST(FeedReceiverTest, parse)
+{
+    Feed feed = Feed::parse("radar1=239.1.2.3:8600@eth1");
+    EXPECT_EQ("radar1", feed.name);
+    EXPECT_EQ("239.1.2.3", feed.address.host().toString());
+    EXPECT_EQ(8600, feed.address.port());
+    EXPECT_EQ("eth1", feed.interfaceName);
+
+    feed = Feed::parse("127.0.0.1:10000");
+    EXPECT_EQ("127.0.0.1:10000", feed.name);
+    EXPECT_TRUE(feed.interfaceName.empty());
+
+    EXPECT_THROW(Feed::parse("radar"), Exception);
+}
+
+static void fanIn(FeedReceiver& receiver)
+{
+    size_t first = receiver.addFeed(Feed::parse("a=127.0.0.1:0"));
+    size_t second = receiver.addFeed(Feed::parse("b=127.0.0.1:0"));
+    ASSERT_EQ(2, receiver.getFeedCount());
+    EXPECT_EQ("b", receiver.getFeed(second).name);
+
+    Poco::Net::DatagramSocket sender;
+    Byte datagram[] = { 48, 0, 3 };
+    for(int i = 0; i < 3; i++)
+        sender.sendTo(datagram, sizeof(datagram), receiver.getLocalAddress(first));
+    datagram[0] = 62;
+    sender.sendTo(datagram, sizeof(datagram), receiver.getLocalAddress(second));
+
+    std::vector<RecordingPacket> packets;
+    std::vector<RecordingPacket> all;
+    for(int i = 0; i < 10 && all.size() < 4; i++)
+    {
+        receiver.receive(packets, Poco::Timespan(1, 0));
+        all.insert(all.end(), packets.begin(), packets.end());
+    }
+
+    ASSERT_EQ(4, all.size());
+    for(const RecordingPacket& packet: all)
+    {
+        EXPECT_EQ(3, packet.size);
+        EXPECT_EQ(packet.feed == first ? 48 : 62, packet.data[0]);
+        EXPECT_EQ(0x7F000001, packet.sourceAddress);
+    }
+    EXPECT_EQ(3, receiver.getPacketCount(first));
+    EXPECT_EQ(1, receiver.getPacketCount(second));
+
+    EXPECT_EQ(0, receiver.receive(packets, Poco::Timespan(10000)));
+}
+
+TEST(FeedReceiverTest, fanIn)
+{
+    FeedReceiver receiver(8);
+    EXPECT_EQ(FeedReceiver::Epoll, receiver.getBackend());
+    fanIn(receiver);
+}
+
+TEST(FeedReceiverTest, fanInUring)
+{
+    // Falls back to epoll when kernel has no io_uring
+    FeedReceiver receiver(8, false, FeedReceiver::Uring);
+    fanIn(receiver);
+
+    // Buffers are recycled, so more datagrams than buffers pass through
+    Poco::Net::DatagramSocket sender;
+    Byte datagram[] = { 48, 0, 3 };
+    std::vector<RecordingPacket> packets;
+    size_t received = 0;
+    for(int round = 0; round < 30; round++)
+    {
+        for(int i = 0; i < 100; i++)
+            sender.sendTo(datagram, sizeof(datagram), receiver.getLocalAddress(0));
+        while (receiver.receive(packets, Poco::Timespan(20000)))
+            received += packets.size();
+    }
+    EXPECT_EQ(3000, received);
+    EXPECT_EQ(0, receiver.getTruncatedCount());
+}
+
+TEST(FeedReceiverTest, exclusiveUnicastPort)
+{
+    FeedReceiver first(8);
+    size_t index = first.addFeed(Feed::parse("127.0.0.1:0"));
+    std::string address = "127.0.0.1:" + std::to_string(first.getLocalAddress(index).port());
+
+    // Second process on the same unicast port must fail instead of stealing datagrams
+    FeedReceiver second(8);
+    EXPECT_ANY_THROW(second.addFeed(Feed::parse(address)));
+
+    FeedReceiver shared1(8, true);
+    size_t sharedIndex = shared1.addFeed(Feed::parse("127.0.0.1:0"));
+    FeedReceiver shared2(8, true);
+    EXPECT_NO_THROW(shared2.addFeed(Feed::parse("127.0.0.1:" + std::to_string(shared1.getLocalAddress(sharedIndex).port()))));
+}
+
+static void oversized(FeedReceiver& receiver)
+{
+    size_t index = receiver.addFeed(Feed::parse("127.0.0.1:0"));
+
+    Poco::Net::DatagramSocket sender;
+    Byte large[32] = { 48, 0, 32 };
+    Byte small[] = { 48, 0, 3 };
+    sender.sendTo(large, sizeof(large), receiver.getLocalAddress(index));
+    sender.sendTo(small, sizeof(small), receiver.getLocalAddress(index));
+
+    // Datagram longer than buffer is dropped instead of passed cut
+    std::vector<RecordingPacket> packets;
+    std::vector<RecordingPacket> all;
+    for(int i = 0; i < 10 && all.size() + receiver.getTruncatedCount() < 2; i++)
+    {
+        receiver.receive(packets, Poco::Timespan(100000));
+        all.insert(all.end(), packets.begin(), packets.end());
+    }
+
+    ASSERT_EQ(1, all.size());
+    EXPECT_EQ(3, all[0].size);
+    EXPECT_EQ(1, receiver.getTruncatedCount());
+}
+
+TEST(FeedReceiverTest, maxDatagramSize)
+{
+    FeedReceiver receiver(8, false, FeedReceiver::Epoll, 16);
+    oversized(receiver);
+
+    FeedReceiver uring(8, false, FeedReceiver::Uring, 16);
+    oversized(uring);
+}
+
+TEST(FeedReceiverTest, largeDatagram)
+{
+    // Default buffers of both backends take datagrams over 16 KB
+    for(FeedReceiver::Backend backend: { FeedReceiver::Epoll, FeedReceiver::Uring })
+    {
+        FeedReceiver receiver(8, false, backend);
+        size_t index = receiver.addFeed(Feed::parse("127.0.0.1:0"), 1 << 20);
+
+        Poco::Net::DatagramSocket sender;
+        std::vector<Byte> datagram(40000, 0);
+        datagram[0] = 48;
+        sender.sendTo(datagram.data(), int(datagram.size()), receiver.getLocalAddress(index));
+
+        std::vector<RecordingPacket> packets;
+        for(int i = 0; i < 10 && packets.empty(); i++)
+            receiver.receive(packets, Poco::Timespan(100000));
+
+        ASSERT_EQ(1, packets.size());
+        EXPECT_EQ(datagram.size(), packets[0].size);
+        EXPECT_EQ(0, receiver.getTruncatedCount());
+    }
+}
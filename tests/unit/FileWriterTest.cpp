@@ -0,0 +1,69 @@
+///
+/// \package astlib
+/// \file FileWriterTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/io/FileWriter.h"
+#include "astlib/Exception.h"
+
+#include <Poco/TemporaryFile.h>
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <iterator>
+
+using namespace astlib;
+
+static void writeAndCompare(FileWriter::Backend backend)
+{
+    Poco::TemporaryFile file;
+    std::string expected;
+
+    {
+        // Small buffers force many submitted writes
+        FileWriter writer(file.path(), backend, 4096, 3);
+        for(int i = 0; i < 5000; i++)
+        {
+            std::string line = "{\"record\":" + std::to_string(i) + "}\n";
+            writer.write(line);
+            expected += line;
+        }
+        EXPECT_EQ(expected.size(), writer.getSize());
+        writer.close();
+        EXPECT_THROW(writer.write("x"), Exception);
+    }
+
+    std::ifstream input(file.path(), std::ios::binary);
+    std::string actual((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    EXPECT_EQ(expected, actual);
+}
+
+TEST(FileWriterTest, stream)
+{
+    writeAndCompare(FileWriter::Stream);
+}
+
+TEST(FileWriterTest, uring)
+{
+    // Falls back to stream when kernel has no io_uring
+    writeAndCompare(FileWriter::Uring);
+}
+
+TEST(FileWriterTest, flush)
+{
+    Poco::TemporaryFile file;
+    FileWriter writer(file.path(), FileWriter::Uring, 4096);
+    writer.write("abc", 3);
+    writer.flush();
+
+    std::ifstream input(file.path(), std::ios::binary);
+    std::string actual((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    EXPECT_EQ("abc", actual);
+}
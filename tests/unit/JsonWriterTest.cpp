@@ -0,0 +1,147 @@
+///
+/// \package astlib
+/// \file JsonWriterTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/io/JsonWriter.h"
+#include "astlib/decoder/JsonValueDecoder.h"
+#include "astlib/decoder/DatagramDecoder.h"
+#include "astlib/specifications/entries.h"
+#include "astlib/CodecDeclarationLoader.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <sstream>
+#include "gtest/gtest.h"
+
+using namespace astlib;
+
+static std::string number(double value)
+{
+    std::string out;
+    JsonWriter::appendNumber(out, value);
+    return out;
+}
+
+TEST(JsonWriterTest, compact)
+{
+    JsonWriter writer;
+    writer.beginObject();
+    writer.key("category");
+    writer.value(48);
+    writer.key("empty");
+    writer.beginObject();
+    writer.endObject();
+    writer.key("array");
+    writer.beginArray();
+    writer.value(true);
+    writer.null();
+    writer.value("a\"b\\c\n\x01");
+    writer.endArray();
+    writer.endObject();
+    writer.newline();
+
+    EXPECT_EQ("{\"category\":48,\"empty\":{},\"array\":[true,null,\"a\\\"b\\\\c\\n\\u0001\"]}\n", writer.getBuffer());
+    EXPECT_EQ(0, writer.getDepth());
+}
+
+TEST(JsonWriterTest, pretty)
+{
+    JsonWriter writer(true);
+    writer.beginObject();
+    writer.key("a");
+    writer.value(Poco::Int64(-1));
+    writer.key("b");
+    writer.beginArray();
+    writer.value(Poco::UInt64(2));
+    writer.endArray();
+    writer.endObject();
+
+    EXPECT_EQ("{\n  \"a\" : -1,\n  \"b\" : [\n    2\n  ]\n}", writer.getBuffer());
+}
+
+TEST(JsonWriterTest, truncate)
+{
+    JsonWriter writer;
+    writer.beginObject();
+    writer.endObject();
+    size_t size = writer.size();
+    writer.beginObject();
+    writer.key("x");
+    writer.truncate(size);
+    writer.beginArray();
+    writer.endArray();
+
+    EXPECT_EQ("{}[]", writer.getBuffer());
+}
+
+TEST(JsonWriterTest, integers)
+{
+    std::string out;
+    JsonWriter::appendNumber(out, std::numeric_limits<Poco::Int64>::min());
+    out += ' ';
+    JsonWriter::appendNumber(out, std::numeric_limits<Poco::UInt64>::max());
+    out += ' ';
+    JsonWriter::appendNumber(out, Poco::Int64(0));
+    out += ' ';
+    JsonWriter::appendNumber(out, Poco::Int64(1234567));
+
+    EXPECT_EQ("-9223372036854775808 18446744073709551615 0 1234567", out);
+}
+
+TEST(JsonWriterTest, reals)
+{
+    EXPECT_EQ("0", number(0.0));
+    EXPECT_EQ("0.5", number(0.5));
+    EXPECT_EQ("-12.0078125", number(-12 - 1.0 / 128));
+    EXPECT_EQ("0.1", number(0.1));
+    EXPECT_EQ("100000000", number(1e8));
+    EXPECT_EQ("1e+300", number(1e300));
+    EXPECT_EQ("null", number(std::nan("")));
+    EXPECT_EQ("null", number(std::numeric_limits<double>::infinity()));
+
+    // Everything reads back exactly
+    for(double value: { 1.0 / 3, 2.0 / 3 * 1e-7, 123456.789, 1.0 / 4096, 359.994507, 6.02214076e23 })
+        EXPECT_EQ(value, std::strtod(number(value).c_str(), nullptr)) << number(value);
+}
+
+TEST(JsonWriterTest, valueDecoder)
+{
+    CodecDeclarationLoader loader;
+    std::istringstream spec{ std::string(cat048_1_21) };
+    DatagramDecoder decoder;
+    decoder.setCodec(loader.parse(spec));
+
+    unsigned char bytes[] = { 48, 0, 9, 0x80, 1, 2, 0x80, 3, 4 };
+    std::ostringstream stream;
+    {
+        JsonValueDecoder json(stream, false);
+        json.setTimestamp(Poco::Timestamp(1000000));
+        EXPECT_EQ(2, decoder.decode(json, bytes, sizeof(bytes)).records);
+        EXPECT_TRUE(stream.str().empty());
+    }
+
+    // Flushed by destructor, one record per line
+    std::string text = stream.str();
+    ASSERT_EQ(2, std::count(text.begin(), text.end(), '\n'));
+    EXPECT_EQ(0, text.find("{\"category\":48,\"timestamp\":1000000,"));
+    EXPECT_NE(std::string::npos, text.find("\"dsi.sac\":3"));
+
+    // Buffer only mode
+    JsonValueDecoder buffered(false);
+    decoder.decode(buffered, bytes, sizeof(bytes));
+    std::string output;
+    buffered.takeOutput(output);
+    EXPECT_EQ(2, std::count(output.begin(), output.end(), '\n'));
+    buffered.takeOutput(output);
+    EXPECT_TRUE(output.empty());
+}
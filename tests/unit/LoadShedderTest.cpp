@@ -0,0 +1,103 @@
+///
+/// \package astlib
+/// \file LoadShedderTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/pipeline/LoadShedder.h"
+#include "astlib/Exception.h"
+
+#include "gtest/gtest.h"
+
+using namespace astlib;
+
+class LoadShedderTest:
+    public testing::Test
+{
+public:
+    RecordingPacket packet(int category, Poco::Int64 microseconds = 0)
+    {
+        buffer[0] = Byte(category);
+        RecordingPacket result;
+        result.data = buffer;
+        result.size = sizeof(buffer);
+        result.timestamp = Poco::Timestamp(microseconds);
+        return result;
+    }
+
+    Byte buffer[3] = { 0, 0, 3 };
+    LoadShedder shedder;
+};
+
+TEST_F(LoadShedderTest, defaults)
+{
+    EXPECT_EQ(LoadShedder::Critical, shedder.getPriority(4));
+    EXPECT_EQ(LoadShedder::Critical, shedder.getPriority(34));
+    EXPECT_EQ(LoadShedder::Low, shedder.getPriority(48));
+    EXPECT_EQ(LoadShedder::Normal, shedder.getPriority(62));
+    EXPECT_TRUE(shedder.isCritical(packet(4)));
+    EXPECT_FALSE(shedder.isCritical(packet(48)));
+}
+
+TEST_F(LoadShedderTest, admitByLoad)
+{
+    shedder.setPriority(21, LoadShedder::High);
+
+    EXPECT_TRUE(shedder.admit(packet(48), 0.5));
+    EXPECT_FALSE(shedder.admit(packet(48), 0.6));
+    EXPECT_TRUE(shedder.admit(packet(62), 0.6));
+    EXPECT_FALSE(shedder.admit(packet(62), 0.8));
+    EXPECT_TRUE(shedder.admit(packet(21), 0.8));
+    EXPECT_FALSE(shedder.admit(packet(21), 0.95));
+    EXPECT_TRUE(shedder.admit(packet(4), 1.0));
+    EXPECT_TRUE(shedder.admit(packet(34), 1.0));
+
+    EXPECT_EQ(1, shedder.getShedCount(48));
+    EXPECT_EQ(1, shedder.getShedCount(62));
+    EXPECT_EQ(3, shedder.getShedCount());
+
+    shedder.setThreshold(LoadShedder::Low, 1.0);
+    shedder.setThreshold(LoadShedder::Critical, 0.0);
+    EXPECT_TRUE(shedder.admit(packet(48), 1.0));
+    EXPECT_TRUE(shedder.admit(packet(4), 1.0));
+}
+
+TEST_F(LoadShedderTest, quota)
+{
+    shedder.setQuota(48, 2);
+
+    EXPECT_TRUE(shedder.admit(packet(48, 1000000), 0.0));
+    EXPECT_TRUE(shedder.admit(packet(48, 1100000), 0.0));
+    EXPECT_FALSE(shedder.admit(packet(48, 1200000), 0.0));
+    EXPECT_TRUE(shedder.admit(packet(62, 1200000), 0.0));
+
+    // Next second opens new window
+    EXPECT_TRUE(shedder.admit(packet(48, 2000000), 0.0));
+    EXPECT_EQ(1, shedder.getShedCount(48));
+
+    // Critical categories ignore quota
+    shedder.setQuota(4, 1);
+    EXPECT_TRUE(shedder.admit(packet(4, 1000000), 0.0));
+    EXPECT_TRUE(shedder.admit(packet(4, 1000000), 0.0));
+}
+
+TEST_F(LoadShedderTest, rules)
+{
+    shedder.setRule("62=critical");
+    shedder.setRule(" 21 = low:100");
+    EXPECT_EQ(LoadShedder::Critical, shedder.getPriority(62));
+    EXPECT_EQ(LoadShedder::Low, shedder.getPriority(21));
+    EXPECT_EQ(100, shedder.getQuota(21));
+
+    EXPECT_THROW(shedder.setRule("48"), Exception);
+    EXPECT_THROW(shedder.setRule("x=low"), Exception);
+    EXPECT_THROW(shedder.setRule("48=urgent"), Exception);
+    EXPECT_THROW(shedder.setRule("48=low:many"), Exception);
+    EXPECT_THROW(shedder.setRule("300=low"), Exception);
+}
@@ -0,0 +1,159 @@
+///
+/// \package astlib
+/// \file NdjsonSinkTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/io/NdjsonSink.h"
+#include "astlib/Exception.h"
+
+#include <Poco/File.h>
+#include <Poco/TemporaryFile.h>
+#include "gtest/gtest.h"
+
+#include <fstream>
+#include <iterator>
+#include <thread>
+
+#if defined(__linux__)
+#include <csignal>
+#include <unistd.h>
+#endif
+
+using namespace astlib;
+
+static std::string readFile(const std::string& path)
+{
+    std::ifstream input(path, std::ios::binary);
+    return std::string((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+}
+
+TEST(NdjsonSinkTest, batching)
+{
+    Poco::TemporaryFile file;
+    std::string expected;
+    {
+        NdjsonSink sink(file.path(), 4096);
+        sink.setFlushInterval(0);
+        for(int i = 0; i < 1000; i++)
+        {
+            std::string line = "{\"record\":" + std::to_string(i) + "}\n";
+            sink.write(line);
+            expected += line;
+        }
+        // Chunk larger than buffer goes out together with buffered data
+        std::string large(10000, 'x');
+        large += '\n';
+        sink.write(large);
+        expected += large;
+
+        // Full buffers only, the last one with the large chunk (two writes without writev)
+        EXPECT_GE(expected.size() / 4096 + 2, sink.getWriteCount());
+        sink.close();
+        EXPECT_EQ(expected.size(), sink.getBytesWritten());
+        EXPECT_THROW(sink.write("x"), Exception);
+    }
+    EXPECT_EQ(expected, readFile(file.path()));
+}
+
+TEST(NdjsonSinkTest, flushInterval)
+{
+    Poco::TemporaryFile file;
+    NdjsonSink sink(file.path());
+    sink.setFlushInterval(1000);
+    sink.write("{}\n");
+    sink.poll();
+    EXPECT_EQ(0, sink.getWriteCount());
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    sink.poll();
+    EXPECT_EQ(1, sink.getWriteCount());
+    EXPECT_EQ("{}\n", readFile(file.path()));
+}
+
+#if defined(__linux__)
+TEST(NdjsonSinkTest, pipe)
+{
+    int fds[2];
+    ASSERT_EQ(0, ::pipe(fds));
+
+    // Larger than pipe capacity, partial writes are continued
+    std::string expected(200000, 'a');
+    expected += '\n';
+    std::string actual;
+    std::thread reader([&]()
+    {
+        char buffer[4096];
+        ssize_t size;
+        while ((size = ::read(fds[0], buffer, sizeof(buffer))) > 0)
+            actual.append(buffer, size);
+    });
+
+    {
+        NdjsonSink sink(fds[1]);
+        sink.write(expected);
+        sink.flush();
+    }
+    ::close(fds[1]);
+    reader.join();
+    ::close(fds[0]);
+    EXPECT_EQ(expected, actual);
+}
+
+TEST(NdjsonSinkTest, writeError)
+{
+    int fds[2];
+    ASSERT_EQ(0, ::pipe(fds));
+    void (*handler)(int) = ::signal(SIGPIPE, SIG_IGN);
+
+    // Reader goes away in the middle of buffer
+    std::thread reader([&]()
+    {
+        char buffer[4096];
+        EXPECT_LT(0, ::read(fds[0], buffer, sizeof(buffer)));
+        ::close(fds[0]);
+    });
+
+    {
+        NdjsonSink sink(fds[1]);
+        sink.write(std::string(200000, 'a') + '\n');
+        EXPECT_THROW(sink.flush(), Exception);
+        reader.join();
+
+        // Failed buffer is not written again
+        EXPECT_NO_THROW(sink.flush());
+    }
+    ::close(fds[1]);
+    ::signal(SIGPIPE, handler);
+}
+#endif
+
+TEST(NdjsonSinkTest, rotation)
+{
+    Poco::TemporaryFile file;
+    Poco::TemporaryFile::registerForDeletion(file.path() + ".1");
+    Poco::TemporaryFile::registerForDeletion(file.path() + ".2");
+    {
+        NdjsonSink sink(file.path(), 4096);
+        sink.setRotation(10);
+        sink.write("{\"a\":1}\n");
+        sink.flush();
+        EXPECT_EQ(0, sink.getRotationCount());
+        sink.write("{\"b\":2}\n");
+        sink.flush();
+        EXPECT_EQ(1, sink.getRotationCount());
+        sink.write("{\"c\":3}\n");
+    }
+    EXPECT_EQ("{\"a\":1}\n{\"b\":2}\n", readFile(file.path() + ".1"));
+    EXPECT_EQ("{\"c\":3}\n", readFile(file.path()));
+    EXPECT_FALSE(Poco::File(file.path() + ".2").exists());
+
+    NdjsonSink stream("-");
+    EXPECT_THROW(stream.setRotation(10), Exception);
+}
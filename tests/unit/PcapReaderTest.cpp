@@ -0,0 +1,225 @@
+///
+/// \package astlib
+/// \file PcapReaderTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/recording/PcapReader.h"
+#include "astlib/recording/PcapWriter.h"
+#include "astlib/decoder/SimpleValueDecoder.h"
+#include "astlib/specifications/entries.h"
+#include "astlib/CodecDeclarationLoader.h"
+#include "astlib/AsterixItemDictionary.h"
+#include "astlib/Exception.h"
+
+#include <Poco/TemporaryFile.h>
+#include <fstream>
+#include "gtest/gtest.h"
+
+using namespace astlib;
+
+class PcapReaderTest:
+    public testing::Test
+{
+public:
+    PcapReaderTest()
+    {
+        payload = { 48, 0, 6, 0x80, 5, 6 };
+    }
+
+    static void put16(std::vector<Byte>& out, unsigned value, bool bigEndian = false)
+    {
+        if (bigEndian)
+            out.insert(out.end(), { Byte(value >> 8), Byte(value) });
+        else
+            out.insert(out.end(), { Byte(value), Byte(value >> 8) });
+    }
+
+    static void put32(std::vector<Byte>& out, Poco::UInt32 value)
+    {
+        out.insert(out.end(), { Byte(value), Byte(value >> 8), Byte(value >> 16), Byte(value >> 24) });
+    }
+
+    /// Ethernet + IPv4 + UDP frame with padding
+    std::vector<Byte> frame(unsigned port) const
+    {
+        std::vector<Byte> out(12, 0xAA);
+        put16(out, 0x0800, true);
+        out.insert(out.end(), { 0x45, 0 });
+        put16(out, unsigned(20 + 8 + payload.size()), true);
+        out.insert(out.end(), { 0, 0, 0x40, 0, 64, 17, 0, 0, 10, 0, 0, 1, 239, 0, 0, 1 });
+        put16(out, 1000, true);
+        put16(out, port, true);
+        put16(out, unsigned(8 + payload.size()), true);
+        put16(out, 0, true);
+        out.insert(out.end(), payload.begin(), payload.end());
+        out.resize(64, 0);
+        return out;
+    }
+
+    std::string write(const std::vector<Byte>& content)
+    {
+        std::ofstream stream(file.path(), std::ios::binary);
+        stream.write(reinterpret_cast<const char*>(content.data()), content.size());
+        return file.path();
+    }
+
+    std::vector<Byte> classicCapture() const
+    {
+        std::vector<Byte> out;
+        put32(out, 0xA1B2C3D4);
+        put16(out, 2);
+        put16(out, 4);
+        put32(out, 0);
+        put32(out, 0);
+        put32(out, 65535);
+        put32(out, 1);
+
+        for(unsigned port: { 5000, 6000 })
+        {
+            auto data = frame(port);
+            put32(out, 1000);
+            put32(out, 250000);
+            put32(out, Poco::UInt32(data.size()));
+            put32(out, Poco::UInt32(data.size()));
+            out.insert(out.end(), data.begin(), data.end());
+        }
+        return out;
+    }
+
+    std::vector<Byte> payload;
+    Poco::TemporaryFile file;
+};
+
+TEST_F(PcapReaderTest, classicCapture)
+{
+    PcapReader reader(write(classicCapture()));
+    RecordingPacket packet;
+
+    EXPECT_FALSE(reader.isNextGeneration());
+    ASSERT_TRUE(reader.next(packet));
+    EXPECT_EQ(payload, std::vector<Byte>(packet.data, packet.data + packet.size));
+    EXPECT_EQ(1000250000, packet.timestamp.epochMicroseconds());
+    EXPECT_EQ(1000, packet.sourcePort);
+    EXPECT_EQ(5000, packet.destinationPort);
+    ASSERT_TRUE(reader.next(packet));
+    EXPECT_EQ(6000, packet.destinationPort);
+    EXPECT_FALSE(reader.next(packet));
+
+    reader.rewind();
+    reader.setPortFilter(6000);
+    ASSERT_TRUE(reader.next(packet));
+    EXPECT_EQ(6000, packet.destinationPort);
+    EXPECT_FALSE(reader.next(packet));
+    EXPECT_EQ(1, reader.getSkippedCount());
+}
+
+TEST_F(PcapReaderTest, writer)
+{
+    {
+        PcapWriter writer(file.path(), PcapReader::LINKTYPE_ETHERNET);
+        writer.write(Poco::Int64(1000250000123), frame(5000).data(), 64);
+        writer.write(Poco::Timestamp(2000000000), frame(6000).data(), 64);
+        EXPECT_EQ(2, writer.getFrameCount());
+    }
+
+    PcapReader reader(file.path());
+    RecordingPacket packet;
+    ASSERT_TRUE(reader.next(packet));
+    EXPECT_EQ(payload, std::vector<Byte>(packet.data, packet.data + packet.size));
+    EXPECT_EQ(1000250000, packet.timestamp.epochMicroseconds());
+    EXPECT_EQ(5000, packet.destinationPort);
+    EXPECT_EQ(0x0A000001, packet.sourceAddress);
+    ASSERT_TRUE(reader.next(packet));
+    EXPECT_EQ(2000000000, packet.timestamp.epochMicroseconds());
+    EXPECT_EQ(6000, packet.destinationPort);
+    EXPECT_FALSE(reader.next(packet));
+}
+
+TEST_F(PcapReaderTest, nextGenerationCapture)
+{
+    std::vector<Byte> out;
+
+    // Section header
+    put32(out, 0x0A0D0D0A);
+    put32(out, 28);
+    put32(out, 0x1A2B3C4D);
+    put16(out, 1);
+    put16(out, 0);
+    put32(out, 0xFFFFFFFF);
+    put32(out, 0xFFFFFFFF);
+    put32(out, 28);
+
+    // Interface with nanosecond resolution
+    put32(out, 1);
+    put32(out, 32);
+    put16(out, 1);
+    put16(out, 0);
+    put32(out, 65535);
+    put16(out, 9);
+    put16(out, 1);
+    put32(out, 9);
+    put32(out, 0);
+    put32(out, 32);
+
+    // Enhanced packet
+    auto data = frame(5000);
+    Poco::UInt64 ticks = 2000123456789ULL;
+    put32(out, 6);
+    put32(out, Poco::UInt32(32 + data.size()));
+    put32(out, 0);
+    put32(out, Poco::UInt32(ticks >> 32));
+    put32(out, Poco::UInt32(ticks));
+    put32(out, Poco::UInt32(data.size()));
+    put32(out, Poco::UInt32(data.size()));
+    out.insert(out.end(), data.begin(), data.end());
+    put32(out, Poco::UInt32(32 + data.size()));
+
+    PcapReader reader(write(out));
+    RecordingPacket packet;
+
+    EXPECT_TRUE(reader.isNextGeneration());
+    ASSERT_TRUE(reader.next(packet));
+    EXPECT_EQ(payload, std::vector<Byte>(packet.data, packet.data + packet.size));
+    EXPECT_EQ(2000123456, packet.timestamp.epochMicroseconds());
+    EXPECT_FALSE(reader.next(packet));
+}
+
+TEST_F(PcapReaderTest, decodeWithTimestamps)
+{
+    class MyDecoder:
+        public SimpleValueDecoder
+    {
+    public:
+        virtual void onMessageDecoded(SimpleAsterixRecordPtr ptr)
+        {
+            records.push_back(ptr);
+        }
+
+        std::vector<SimpleAsterixRecordPtr> records;
+    } valueDecoder;
+
+    CodecDeclarationLoader loader;
+    std::istringstream stream{ std::string(cat048_1_21) };
+    DatagramDecoder decoder;
+    decoder.setCodec(loader.parse(stream));
+
+    PcapReader reader(write(classicCapture()));
+    auto result = reader.decode(decoder, valueDecoder);
+
+    EXPECT_EQ(2, result.records);
+    ASSERT_EQ(2, valueDecoder.records.size());
+    EXPECT_EQ(1000250000, valueDecoder.records[0]->getTimestamp().epochMicroseconds());
+}
+
+TEST_F(PcapReaderTest, badFile)
+{
+    std::string path = write(std::vector<Byte>(100, 0));
+    EXPECT_THROW(PcapReader reader(path), Exception);
+}
@@ -0,0 +1,126 @@
+///
+/// \package astlib
+/// \file RecordPatcherTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/encoder/RecordPatcher.h"
+#include "astlib/encoder/BinaryAsterixEncoder.h"
+#include "astlib/encoder/SimpleValueEncoder.h"
+#include "astlib/decoder/BinaryAsterixDecoder.h"
+#include "astlib/decoder/SimpleValueDecoder.h"
+#include "astlib/specifications/entries.h"
+#include "astlib/CodecDeclarationLoader.h"
+#include "astlib/AsterixItemDictionary.h"
+#include "astlib/Exception.h"
+
+#include "gtest/gtest.h"
+
+using namespace astlib;
+
+class RecordPatcherTest:
+    public testing::Test
+{
+public:
+    RecordPatcherTest()
+    {
+        CodecDeclarationLoader loader;
+        std::istringstream stream{ std::string(cat048_1_21) };
+        codec = loader.parse(stream);
+
+        auto record = std::make_shared<SimpleAsterixRecord>();
+        record->setItem(DSI_SAC, Poco::UInt64(1));
+        record->setItem(DSI_SIC, Poco::UInt64(2));
+        record->setItem(TIMEOFDAY, 10.0);
+        record->setItem(TRACK_NUMBER, Poco::UInt64(100));
+
+        BinaryAsterixEncoder encoder;
+        SimpleValueEncoder valueEncoder(record);
+        encoder.encode(*codec, valueEncoder, buffer);
+    }
+
+    SimpleAsterixRecordPtr decode()
+    {
+        class MyDecoder:
+            public SimpleValueDecoder
+        {
+        public:
+            virtual void onMessageDecoded(SimpleAsterixRecordPtr ptr)
+            {
+                msg = ptr;
+            }
+
+            SimpleAsterixRecordPtr msg;
+        } valueDecoder;
+
+        BinaryAsterixDecoder decoder;
+        decoder.decode(*codec, valueDecoder, buffer.data(), buffer.size());
+        return valueDecoder.msg;
+    }
+
+    CodecDescriptionPtr codec;
+    std::vector<Byte> buffer;
+};
+
+TEST_F(RecordPatcherTest, offsetTable)
+{
+    ItemOffsetTable table;
+    EXPECT_EQ(buffer.size()-3, table.scan(*codec, buffer.data()+3, buffer.size()-3));
+
+    const ItemOffsetTable::Item* item = table.findItem(10);
+    ASSERT_TRUE(item);
+    EXPECT_EQ(table.getFspecLength(), item->offset);
+    EXPECT_EQ(2, item->length);
+    EXPECT_FALSE(table.findItem(20));
+
+    std::vector<ItemOffsetTable::Field> fields;
+    EXPECT_EQ(1, table.findFields(TRACK_NUMBER, fields));
+}
+
+TEST_F(RecordPatcherTest, patchInPlace)
+{
+    RecordPatcher patcher;
+    patcher.set(DSI_SAC, 7);
+    patcher.set(DSI_SIC, 8);
+    patcher.shift(TIMEOFDAY, -20.0, 86400.0);
+    patcher.set(TRACK_NUMBER, 1111);
+
+    size_t size = buffer.size();
+    EXPECT_EQ(1, patcher.patch(*codec, buffer.data(), buffer.size()));
+    EXPECT_EQ(size, buffer.size());
+
+    SimpleAsterixRecordPtr record = decode();
+    Poco::UInt64 value = 0;
+    double real = 0;
+
+    EXPECT_TRUE(record->getUnsigned(DSI_SAC, value));
+    EXPECT_EQ(7, value);
+    EXPECT_TRUE(record->getUnsigned(DSI_SIC, value));
+    EXPECT_EQ(8, value);
+    EXPECT_TRUE(record->getUnsigned(TRACK_NUMBER, value));
+    EXPECT_EQ(1111, value);
+    EXPECT_TRUE(record->getReal(TIMEOFDAY, real));
+    EXPECT_DOUBLE_EQ(86390.0, real);
+
+    // Repeated shift replaces the delta instead of adding it
+    patcher.shift(TIMEOFDAY, 30.0, 86400.0);
+    patcher.shift(TIMEOFDAY, 10.0, 86400.0);
+    EXPECT_EQ(1, patcher.patch(*codec, buffer.data(), buffer.size()));
+    record = decode();
+    EXPECT_TRUE(record->getReal(TIMEOFDAY, real));
+    EXPECT_DOUBLE_EQ(0.0, real);
+}
+
+TEST_F(RecordPatcherTest, truncatedRecord)
+{
+    RecordPatcher patcher;
+    patcher.set(TRACK_NUMBER, 1);
+    buffer[2] -= 1;
+    EXPECT_THROW(patcher.patch(*codec, buffer.data(), buffer.size()-1), Exception);
+}
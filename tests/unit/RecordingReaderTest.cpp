@@ -0,0 +1,100 @@
+///
+/// \package astlib
+/// \file RecordingReaderTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/recording/RecordingReader.h"
+#include "astlib/recording/FinalRecordingReader.h"
+#include "astlib/recording/RawRecordingReader.h"
+#include "astlib/Exception.h"
+
+#include <Poco/TemporaryFile.h>
+#include <fstream>
+#include "gtest/gtest.h"
+
+using namespace astlib;
+
+class RecordingReaderTest:
+    public testing::Test
+{
+public:
+    std::string write(const std::vector<Byte>& content)
+    {
+        std::ofstream stream(file.path(), std::ios::binary);
+        stream.write(reinterpret_cast<const char*>(content.data()), content.size());
+        return file.path();
+    }
+
+    /// FINAL record with time of day in 10 ms units
+    static void addFinalRecord(std::vector<Byte>& out, int day, Poco::UInt32 ticks, const std::vector<Byte>& data)
+    {
+        size_t length = 8 + data.size() + 4;
+        out.insert(out.end(), { Byte(length >> 8), Byte(length), 0, 0, Byte(day), Byte(ticks >> 16), Byte(ticks >> 8), Byte(ticks) });
+        out.insert(out.end(), data.begin(), data.end());
+        out.insert(out.end(), { 0xA5, 0xA5, 0xA5, 0xA5 });
+    }
+
+    Poco::TemporaryFile file;
+};
+
+TEST_F(RecordingReaderTest, raw)
+{
+    std::vector<Byte> content = {
+        48, 0, 6, 0x80, 1, 2,
+        0, 0,                   // garbage
+        62, 0, 9, 0x80, 3, 4,   0x80, 5, 6
+    };
+    auto reader = RecordingReader::open(write(content));
+    RecordingPacket packet;
+
+    EXPECT_STREQ("raw", reader->getFormatName());
+    ASSERT_TRUE(reader->next(packet));
+    EXPECT_EQ(6, packet.size);
+    ASSERT_TRUE(reader->next(packet));
+    EXPECT_EQ(62, packet.data[0]);
+    EXPECT_EQ(9, packet.size);
+    EXPECT_FALSE(reader->next(packet));
+    EXPECT_EQ(2, reader->getPacketCount());
+    EXPECT_EQ(2, reader->getSkippedCount());
+}
+
+TEST_F(RecordingReaderTest, final)
+{
+    std::vector<Byte> content;
+    addFinalRecord(content, 7, 360000, { 48, 0, 6, 0x80, 1, 2 });
+    content.push_back(0xFF);    // garbage
+    addFinalRecord(content, 8, 100, { 62, 0, 6, 0x80, 3, 4, 34, 0, 6, 0x80, 5, 6 });
+
+    auto reader = RecordingReader::open(write(content));
+    RecordingPacket packet;
+
+    EXPECT_STREQ("final", reader->getFormatName());
+    ASSERT_TRUE(reader->next(packet));
+    EXPECT_EQ(6, packet.size);
+    EXPECT_EQ(48, packet.data[0]);
+    EXPECT_EQ(3600000000LL, packet.timestamp.epochMicroseconds());
+
+    // Next day
+    ASSERT_TRUE(reader->next(packet));
+    EXPECT_EQ(12, packet.size);
+    EXPECT_EQ(86400000000LL + 1000000, packet.timestamp.epochMicroseconds());
+    EXPECT_FALSE(reader->next(packet));
+    EXPECT_EQ(1, reader->getSkippedCount());
+
+    FinalRecordingReader dated(file.path(), 1000000000000000LL);
+    ASSERT_TRUE(dated.next(packet));
+    EXPECT_EQ(1000003600000000LL, packet.timestamp.epochMicroseconds());
+}
+
+TEST_F(RecordingReaderTest, unknownFormat)
+{
+    std::string path = write(std::vector<Byte>(100, 0));
+    EXPECT_THROW(RecordingReader::open(path), Exception);
+}
@@ -12,6 +12,8 @@
 
 #include "astlib/SimpleAsterixRecord.h"
 #include "astlib/AsterixItemDictionary.h"
+#include "astlib/Exception.h"
+#include "astlib/io/CborReader.h"
 
 #include "gtest/gtest.h"
 
@@ -156,3 +158,77 @@ TEST_F(SimpleAsterixMessageTest, fromToJson)
     EXPECT_EQ(192, json2.size());
 
 }
+
+TEST_F(SimpleAsterixMessageTest, fromJsonTypes)
+{
+    auto key = [](AsterixItemCode code) { return "\"" + asterixCodeToSymbol(code) + "\""; };
+    std::string json = " { " + key(DSI_SAC) + " : 7,\n\"unknown.item\":[1,{\"x\":\"]\"}]," + key(TARGET_IDENTIFICATION) + ":\"A\\\"B\\u0041\","
+        + key(TIMEOFDAY) + ":12.5, " + key(SYSTEM_STATUS_NOGO) + ":false, " + key(TRACK_DOPPLER_CALCULATION) + ":-3} ";
+    SimpleAsterixRecordPtr msg = SimpleAsterixRecord::fromJson(json);
+
+    Poco::UInt64 sac = 0;
+    EXPECT_TRUE(msg->getUnsigned(DSI_SAC, sac));
+    EXPECT_EQ(7, sac);
+    std::string address;
+    EXPECT_TRUE(msg->getString(TARGET_IDENTIFICATION, address));
+    EXPECT_EQ("A\"BA", address);
+    double tod = 0;
+    EXPECT_TRUE(msg->getReal(TIMEOFDAY, tod));
+    EXPECT_EQ(12.5, tod);
+    Poco::Int64 doppler = 0;
+    EXPECT_TRUE(msg->getSigned(TRACK_DOPPLER_CALCULATION, doppler));
+    EXPECT_EQ(-3, doppler);
+    // Unknown symbol is skipped
+    EXPECT_EQ(5, msg->size());
+
+    // Serializer output is parsed back to the same text
+    std::string text;
+    msg->toJson(text);
+    EXPECT_EQ(text, SimpleAsterixRecord::fromJson(text)->toJson());
+}
+
+TEST_F(SimpleAsterixMessageTest, fromJsonMalformed)
+{
+    EXPECT_THROW(SimpleAsterixRecord::fromJson(""), Exception);
+    EXPECT_THROW(SimpleAsterixRecord::fromJson("{\"" + asterixCodeToSymbol(DSI_SAC) + "\":}"), Exception);
+    EXPECT_THROW(SimpleAsterixRecord::fromJson("{\"" + asterixCodeToSymbol(DSI_SAC) + "\":1"), Exception);
+    EXPECT_THROW(SimpleAsterixRecord::fromJson("{\"" + asterixCodeToSymbol(DSI_SAC) + "\":1} x"), Exception);
+    EXPECT_THROW(SimpleAsterixRecord::fromJson("{\"" + asterixCodeToSymbol(TARGET_IDENTIFICATION) + "\":\"abc}"), Exception);
+    EXPECT_EQ(0, SimpleAsterixRecord::fromJson("{}")->size());
+}
+
+TEST_F(SimpleAsterixMessageTest, toFromCbor)
+{
+    SimpleAsterixRecord msg;
+    msg.setCategory(48);
+    msg.setTimestamp(Poco::Timestamp(1234567));
+    msg.setItem(SYSTEM_STATUS_NOGO, true);
+    msg.setItem(DSI_SAC, 100);
+    msg.setItem(TRACK_DOPPLER_CALCULATION, -11111);
+    msg.setItem(TIMEOFDAY, 2000.10);
+    msg.setItem(TARGET_IDENTIFICATION, "JANO44");
+    msg.initializeArray(TRAJECTORY_INTENT_TCP_LATITUDE, 2);
+    msg.setItem(TRAJECTORY_INTENT_TCP_LATITUDE, 42.67, 0);
+    msg.setItem(TRAJECTORY_INTENT_TCP_LATITUDE, -64542.7, 1);
+
+    // Two records in one CBOR sequence
+    std::string data;
+    msg.toCbor(data);
+    size_t first = data.size();
+    msg.toCbor(data);
+    EXPECT_LT(first, msg.toJson().size());
+
+    CborReader reader(data.data(), data.size());
+    SimpleAsterixRecordPtr msg2 = SimpleAsterixRecord::fromCbor(reader);
+    EXPECT_EQ(first, reader.getOffset());
+    SimpleAsterixRecord::fromCbor(reader);
+    EXPECT_TRUE(reader.atEnd());
+
+    EXPECT_EQ(48, msg2->getCategory());
+    EXPECT_EQ(1234567, msg2->getTimestamp().epochMicroseconds());
+    EXPECT_EQ(msg.toJson(), msg2->toJson());
+    EXPECT_EQ(2, msg2->getArraySize(TRAJECTORY_INTENT_TCP_LATITUDE));
+
+    EXPECT_THROW(SimpleAsterixRecord::fromCbor(data.data(), data.size()), Exception);
+    EXPECT_THROW(SimpleAsterixRecord::fromCbor(data.data(), first - 1), Exception);
+}
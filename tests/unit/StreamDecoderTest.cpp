@@ -0,0 +1,120 @@
+///
+/// \package astlib
+/// \file StreamDecoderTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/decoder/StreamDecoder.h"
+#include "astlib/decoder/SimpleValueDecoder.h"
+#include "astlib/specifications/entries.h"
+#include "astlib/CodecDeclarationLoader.h"
+#include "astlib/AsterixItemDictionary.h"
+
+#include "gtest/gtest.h"
+
+using namespace astlib;
+
+class StreamDecoderTest:
+    public testing::Test
+{
+public:
+    StreamDecoderTest()
+    {
+        CodecDeclarationLoader loader;
+
+        std::istringstream stream48{ std::string(cat048_1_21) };
+        decoder.setCodec(loader.parse(stream48));
+
+        std::istringstream stream62{ std::string(cat062_1_16) };
+        decoder.setCodec(loader.parse(stream62));
+
+        const Byte blocks[] = {
+            48, 0, 9, 0x80, 1, 2,   0x80, 3, 4,
+            62, 0, 6, 0x80, 5, 6,
+            48, 0, 6, 0x80, 7, 8
+        };
+        stream.assign(blocks, blocks + sizeof(blocks));
+    }
+
+    class MyDecoder:
+        public SimpleValueDecoder
+    {
+    public:
+        virtual void onMessageDecoded(SimpleAsterixRecordPtr ptr)
+        {
+            Poco::UInt64 sac = 0;
+            ptr->getUnsigned(DSI_SAC, sac);
+            sacs.push_back(int(sac));
+        }
+
+        std::vector<int> sacs;
+    } valueDecoder;
+
+    StreamDecoder decoder;
+    std::vector<Byte> stream;
+};
+
+TEST_F(StreamDecoderTest, arbitraryChunks)
+{
+    for(size_t chunk = 1; chunk <= stream.size(); chunk++)
+    {
+        valueDecoder.sacs.clear();
+        size_t records = 0;
+
+        for(size_t offset = 0; offset < stream.size(); offset += chunk)
+        {
+            auto result = decoder.push(valueDecoder, stream.data() + offset, std::min(chunk, stream.size() - offset));
+            EXPECT_TRUE(result.ok());
+            records += result.records;
+        }
+
+        EXPECT_EQ(4, records);
+        EXPECT_EQ((std::vector<int>{1, 3, 5, 7}), valueDecoder.sacs);
+        EXPECT_EQ(0, decoder.getPendingSize());
+    }
+}
+
+TEST_F(StreamDecoderTest, pendingBlock)
+{
+    auto result = decoder.push(valueDecoder, stream.data(), 11);
+    EXPECT_EQ(1, result.blocks);
+    EXPECT_EQ(2, decoder.getPendingSize());
+
+    decoder.reset();
+    result = decoder.push(valueDecoder, stream.data() + 15, 6);
+    EXPECT_EQ(1, result.blocks);
+    EXPECT_EQ((std::vector<int>{1, 3, 7}), valueDecoder.sacs);
+}
+
+TEST_F(StreamDecoderTest, skipBadHeader)
+{
+    stream.insert(stream.begin() + 9, {0, 0, 0});
+
+    auto result = decoder.push(valueDecoder, stream.data(), stream.size());
+    EXPECT_EQ(3, result.skippedBytes);
+    EXPECT_EQ(3, result.blocks);
+    EXPECT_EQ((std::vector<int>{1, 3, 5, 7}), valueDecoder.sacs);
+}
+
+TEST_F(StreamDecoderTest, largeBlock)
+{
+    // Bigger than former 8192 bytes limit
+    std::vector<Byte> block = {48, 0, 0};
+    for(int i = 0; i < 4000; i++)
+        block.insert(block.end(), {0x80, 1, 2});
+    block[1] = Byte(block.size() >> 8);
+    block[2] = Byte(block.size());
+
+    size_t records = 0;
+    for(size_t offset = 0; offset < block.size(); offset += 1500)
+        records += decoder.push(valueDecoder, block.data() + offset, std::min(size_t(1500), block.size() - offset)).records;
+
+    EXPECT_EQ(4000, records);
+    EXPECT_EQ(block.size(), decoder.getPosition());
+}
@@ -51,6 +51,7 @@ public:
 
     virtual bool encodeReal(const CodecContext& ctx, double& value, int index)
     {
+        value = fromReal;
         return true;
     }
 
@@ -75,6 +76,7 @@ public:
 
     virtual void decodeReal(const CodecContext& ctx, double value, int index)
     {
+        realResult = value;
     }
 
     virtual void decodeString(const CodecContext& ctx, const std::string& value, int index)
@@ -84,6 +86,8 @@ public:
 
     std::string fromStr;
     std::string strResult;
+    double fromReal = 0.0;
+    double realResult = 0.0;
 };
 
 class TypedValueCodecTest:
@@ -151,3 +155,64 @@ TEST_F(TypedValueCodecTest, asciiSixbitEncoding)
     EXPECT_TRUE(encoder.encode(ctx, value, -1));
     EXPECT_EQ(0x092071c31820ULL, value);
 }
+
+TEST_F(TypedValueCodecTest, compiledRealEncoding)
+{
+    AsterixItemCode code(1, PrimitiveType::Real, false);
+    BitsDescription bits(code);
+    bits.from = 16;
+    bits.to = 1;
+    bits.encoding = Encoding::Signed;
+    bits.scale = 1.0/128;
+    bits.units = Units::NM;
+    bits.name = "foo";
+    bits.compile();
+    EXPECT_EQ(BitsPlan::Real, bits.plan.kind);
+    EXPECT_EQ(16, bits.plan.width);
+    EXPECT_EQ(0, bits.plan.shift);
+    EXPECT_EQ(0xFFFFULL, bits.plan.mask);
+    BitsDescriptionArray array { bits };
+    Fixed fixed(array, 2);
+    FixedItemDescription uapItem(0, "Test", fixed);
+    CodecPolicy policy;
+    CodecContext ctx(uapItem, policy, bits, 1);
+    TypedEncoder encoder;
+
+    encoder.fromReal = 1852.0 * 10.5;
+    Poco::UInt64 value = 0;
+    EXPECT_TRUE(encoder.encode(ctx, value, -1));
+    EXPECT_EQ(10.5 * 128, value);
+    encoder.decode(ctx, value, -1);
+    EXPECT_DOUBLE_EQ(1852.0 * 10.5, encoder.realResult);
+
+    encoder.fromReal = -1852.0;
+    value = 0;
+    EXPECT_TRUE(encoder.encode(ctx, value, -1));
+    encoder.decode(ctx, value & bits.plan.mask, -1);
+    EXPECT_DOUBLE_EQ(-1852.0, encoder.realResult);
+}
+
+TEST_F(TypedValueCodecTest, hexEncoding)
+{
+    AsterixItemCode code(1, PrimitiveType::String, false);
+    BitsDescription bits(code);
+    bits.from = 56;
+    bits.to = 1;
+    bits.encoding = Encoding::Hex;
+    bits.name = "foo";
+    bits.compile();
+    BitsDescriptionArray array { bits };
+    Fixed fixed(array, 7);
+    FixedItemDescription uapItem(0, "Test", fixed);
+    CodecPolicy policy;
+    CodecContext ctx(uapItem, policy, bits, 1);
+    TypedEncoder encoder;
+
+    encoder.fromStr = "0123456AB12345";
+    Poco::UInt64 value = 0;
+    EXPECT_TRUE(encoder.encode(ctx, value, -1));
+    EXPECT_EQ(0x0123456AB12345ULL, value);
+
+    encoder.fromStr = "0123456XB12345";
+    EXPECT_THROW(encoder.encode(ctx, value, -1), Exception);
+}
@@ -0,0 +1,102 @@
+///
+/// \package astlib
+/// \file UdpReceiverTest.cpp
+///
+/// \author Marian Krivos <nezmar@tutok.sk>
+/// \date 18Oct.,2026
+/// \brief definicia typu
+///
+/// (C) Copyright 2017 R-SYS s.r.o
+/// All rights reserved.
+///
+
+#include "astlib/network/UdpReceiver.h"
+
+#include <Poco/Net/DatagramSocket.h>
+#include <Poco/Net/SocketAddress.h>
+#include "gtest/gtest.h"
+
+using namespace astlib;
+
+class UdpReceiverTest:
+    public testing::Test
+{
+public:
+    UdpReceiverTest() :
+        socket(Poco::Net::SocketAddress("127.0.0.1", 0))
+    {
+        address = Poco::Net::SocketAddress("127.0.0.1", socket.address().port());
+    }
+
+    void send(Byte first, size_t size)
+    {
+        std::vector<Byte> datagram(size, first);
+        sender.sendTo(datagram.data(), int(datagram.size()), address);
+    }
+
+    Poco::Net::DatagramSocket socket;
+    Poco::Net::DatagramSocket sender;
+    Poco::Net::SocketAddress address;
+    std::vector<RecordingPacket> packets;
+};
+
+TEST_F(UdpReceiverTest, timeout)
+{
+    UdpReceiver receiver(socket);
+    EXPECT_EQ(0, receiver.receive(packets, Poco::Timespan(10000)));
+    EXPECT_TRUE(packets.empty());
+    EXPECT_EQ(0, receiver.getBatchCount());
+}
+
+TEST_F(UdpReceiverTest, batch)
+{
+    UdpReceiver receiver(socket, 4);
+    Poco::Timestamp before;
+
+    for(int i = 0; i < 6; i++)
+        send(Byte(48 + i), 10 + i);
+
+    // First call returns full batch, second one the rest
+    EXPECT_EQ(4, receiver.receive(packets, Poco::Timespan(1, 0)));
+    for(size_t i = 0; i < packets.size(); i++)
+    {
+        EXPECT_EQ(10 + i, packets[i].size);
+        EXPECT_EQ(48 + i, packets[i].data[0]);
+        EXPECT_EQ(48 + i, packets[i].data[packets[i].size - 1]);
+        EXPECT_EQ(address.port(), packets[i].destinationPort);
+        EXPECT_GE(packets[i].timestamp, before);
+    }
+
+    EXPECT_EQ(2, receiver.receive(packets, Poco::Timespan(1, 0)));
+    EXPECT_EQ(14, packets[0].size);
+    EXPECT_EQ(52, packets[0].data[0]);
+    EXPECT_EQ(15, packets[1].size);
+
+    EXPECT_EQ(6, receiver.getPacketCount());
+    EXPECT_EQ(2, receiver.getBatchCount());
+}
+
+TEST_F(UdpReceiverTest, ringKeepsPreviousBatch)
+{
+    UdpReceiver receiver(socket, 2, 4);
+
+    send(1, 5);
+    send(2, 5);
+    ASSERT_EQ(2, receiver.receive(packets, Poco::Timespan(1, 0)));
+    std::vector<RecordingPacket> previous = packets;
+
+    send(3, 5);
+    send(4, 5);
+    ASSERT_EQ(2, receiver.receive(packets, Poco::Timespan(1, 0)));
+
+    EXPECT_EQ(1, previous[0].data[0]);
+    EXPECT_EQ(2, previous[1].data[0]);
+    EXPECT_EQ(3, packets[0].data[0]);
+    EXPECT_EQ(4, packets[1].data[0]);
+}
+
+TEST_F(UdpReceiverTest, receiveBuffer)
+{
+    UdpReceiver receiver(socket);
+    EXPECT_GT(receiver.setReceiveBufferSize(1 << 20), 0);
+}